@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <initializer_list>
 #include <iterator>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
@@ -20,27 +21,34 @@ namespace
 			return os;
 		}
 	} g_Stats;
-	inline void* my_malloc(size_t size)
-	{
+}
+#endif
+
+// std::allocator instead of malloc: it is allowed in constant evaluation.
+// Stats only count runtime allocations
+template<typename T>
+constexpr T* my_allocate(size_t count)
+{
+	if (count == 0)
+		return nullptr;
+#ifdef CHECK_ALLOCATIONS
+	if (!std::is_constant_evaluated())
 		g_Stats.allocations++;
-		return malloc(size);
-	}
-	inline void my_free(void* block)
-	{
-		g_Stats.deallocations++;
-		free(block);
-	}
+#endif
+	return std::allocator<T>().allocate(count);
 }
-#else
-	inline void* my_malloc(size_t size)
-	{
-		return malloc(size);
-	}
-	inline void my_free(void* block)
-	{
-		free(block);
-	}
+
+template<typename T>
+constexpr void my_deallocate(T* block, size_t count)
+{
+	if (!block)
+		return;
+#ifdef CHECK_ALLOCATIONS
+	if (!std::is_constant_evaluated())
+		g_Stats.deallocations++;
 #endif
+	std::allocator<T>().deallocate(block, count);
+}
 
 namespace myStl
 {
@@ -58,46 +66,46 @@ namespace myStl
 			using reference			= T&;
 
 		public:
-			Iterator(Array<T>* arr, int64_t pos = 0, int direction = 1) : m_pArr(arr), m_Position(pos), m_direction(direction) {}
+			constexpr Iterator(Array<T>* arr, difference_type pos = 0, int direction = 1) : m_pArr(arr), m_Position(pos), m_direction(direction) {}
 
-			reference operator*() const { return m_pArr->m_data[m_Position]; }
-			pointer operator->() { return &m_pArr->m_data[m_Position]; }
+			constexpr reference operator*() const { return m_pArr->m_data[m_Position]; }
+			constexpr pointer operator->() { return &m_pArr->m_data[m_Position]; }
 			//operator T* () const { return &m_pArr->m_data[m_Position]; }
 
 			// Bidirectional iterator increments and decrements
-			Iterator& operator++() { m_Position += m_direction; return *this; }
-			Iterator operator++(int) { Iterator tmp = *this; ++(*this); return tmp; }
-			Iterator& operator--() { m_Position -= m_direction; return *this; }
-			Iterator operator--(int) { Iterator tmp = *this; --(*this); return tmp; }
+			constexpr Iterator& operator++() { m_Position += m_direction; return *this; }
+			constexpr Iterator operator++(int) { Iterator tmp = *this; ++(*this); return tmp; }
+			constexpr Iterator& operator--() { m_Position -= m_direction; return *this; }
+			constexpr Iterator operator--(int) { Iterator tmp = *this; --(*this); return tmp; }
 
 			// Random access operations
-			Iterator& operator +=(difference_type n) { m_Position += n * m_direction; return *this; }
-			Iterator operator +(difference_type n) const { return Iterator(m_pArr, m_Position + n * m_direction); }
-			friend Iterator operator +(difference_type n, const Iterator& it) { return Iterator(it.m_pArr, it.m_Position + n * it.m_direction); }
-			Iterator& operator -=(difference_type n) { m_Position -= n * m_direction; return *this; }
-			Iterator operator -(difference_type n) const { return Iterator(m_pArr, m_Position - n * m_direction); }
-			difference_type operator-(const Iterator& other) const { return m_Position - other.m_Position; }
+			constexpr Iterator& operator +=(difference_type n) { m_Position += n * m_direction; return *this; }
+			constexpr Iterator operator +(difference_type n) const { return Iterator(m_pArr, m_Position + n * m_direction); }
+			friend constexpr Iterator operator +(difference_type n, const Iterator& it) { return Iterator(it.m_pArr, it.m_Position + n * it.m_direction); }
+			constexpr Iterator& operator -=(difference_type n) { m_Position -= n * m_direction; return *this; }
+			constexpr Iterator operator -(difference_type n) const { return Iterator(m_pArr, m_Position - n * m_direction); }
+			constexpr difference_type operator-(const Iterator& other) const { return m_Position - other.m_Position; }
 
 			// Element access for random access
-			reference operator[](difference_type n) const { return m_pArr->m_data[m_Position + n * m_direction]; }
-
-			friend bool operator==(const Iterator& a, const Iterator& b) { return a.m_pArr == b.m_pArr && a.m_Position == b.m_Position; }
-			friend bool operator!=(const Iterator& a, const Iterator& b) { return a.m_pArr != b.m_pArr || a.m_Position != b.m_Position; }
-			friend bool operator<(const Iterator& a, const Iterator& b) { return a.m_pArr == b.m_pArr && a.m_Position < b.m_Position; }
-			friend bool operator>(const Iterator& a, const Iterator& b) { return b < a; }
-			friend bool operator<=(const Iterator& a, const Iterator& b) { return !(b < a); }
-			friend bool operator>=(const Iterator& a, const Iterator& b) { return !(a < b); }
-
-			const reference get() const { return m_pArr->m_data[m_Position]; }
-			void set(const reference value) { m_pArr->m_data[m_Position] = value; }
-			void next() { m_Position += m_direction; }
-			void previous() { m_Position -= m_direction; }
-			bool hasNext() const { return m_direction == 1 ? m_Position < m_pArr->m_size : m_Position >= 0; }
-			bool hasPrevious() const { return m_direction == 1 ? m_Position >= 0 : m_Position < m_pArr->m_size; }
+			constexpr reference operator[](difference_type n) const { return m_pArr->m_data[m_Position + n * m_direction]; }
+
+			friend constexpr bool operator==(const Iterator& a, const Iterator& b) { return a.m_pArr == b.m_pArr && a.m_Position == b.m_Position; }
+			friend constexpr bool operator!=(const Iterator& a, const Iterator& b) { return a.m_pArr != b.m_pArr || a.m_Position != b.m_Position; }
+			friend constexpr bool operator<(const Iterator& a, const Iterator& b) { return a.m_pArr == b.m_pArr && a.m_Position < b.m_Position; }
+			friend constexpr bool operator>(const Iterator& a, const Iterator& b) { return b < a; }
+			friend constexpr bool operator<=(const Iterator& a, const Iterator& b) { return !(b < a); }
+			friend constexpr bool operator>=(const Iterator& a, const Iterator& b) { return !(a < b); }
+
+			constexpr const reference get() const { return m_pArr->m_data[m_Position]; }
+			constexpr void set(const reference value) { m_pArr->m_data[m_Position] = value; }
+			constexpr void next() { m_Position += m_direction; }
+			constexpr void previous() { m_Position -= m_direction; }
+			constexpr bool hasNext() const { return m_direction == 1 ? m_Position < (difference_type)m_pArr->m_size : m_Position >= 0; }
+			constexpr bool hasPrevious() const { return m_direction == 1 ? m_Position >= 0 : m_Position < (difference_type)m_pArr->m_size; }
 
 		private:
 			Array<T>* m_pArr;
-			int64_t m_Position;
+			difference_type m_Position;
 			int m_direction;
 		};
 
@@ -110,96 +118,96 @@ namespace myStl
 			using reference			= const T&;
 
 		public:
-			ConstIterator(const Array<T>* arr, int64_t pos = 0, int direction = 1) : m_pArr(arr), m_Position(pos), m_direction(direction) {}
+			constexpr ConstIterator(const Array<T>* arr, difference_type pos = 0, int direction = 1) : m_pArr(arr), m_Position(pos), m_direction(direction) {}
 
-			reference operator*() const { return m_pArr->m_data[m_Position]; }
-			pointer operator->() { return &m_pArr->m_data[m_Position]; }
+			constexpr reference operator*() const { return m_pArr->m_data[m_Position]; }
+			constexpr pointer operator->() { return &m_pArr->m_data[m_Position]; }
 			//operator T* () const { return &m_pArr->m_data[m_Position]; }
 
 			// Bidirectional iterator increments and decrements
-			ConstIterator& operator++() { m_Position += m_direction; return *this; }
-			ConstIterator operator++(int) { ConstIterator tmp = *this; ++(*this); return tmp; }
-			ConstIterator& operator--() { m_Position -= m_direction; return *this; }
-			ConstIterator operator--(int) { ConstIterator tmp = *this; --(*this); return tmp; }
+			constexpr ConstIterator& operator++() { m_Position += m_direction; return *this; }
+			constexpr ConstIterator operator++(int) { ConstIterator tmp = *this; ++(*this); return tmp; }
+			constexpr ConstIterator& operator--() { m_Position -= m_direction; return *this; }
+			constexpr ConstIterator operator--(int) { ConstIterator tmp = *this; --(*this); return tmp; }
 
 			// Random access operations
-			ConstIterator& operator +=(difference_type n) { m_Position += n * m_direction; return *this; }
-			ConstIterator operator +(difference_type n) const { return ConstIterator(m_pArr, m_Position + n * m_direction); }
-			friend ConstIterator operator +(difference_type n, const ConstIterator& it) { return ConstIterator(it.m_pArr, it.m_Position + n * it.m_direction); }
-			ConstIterator& operator -=(difference_type n) { m_Position -= n * m_direction; return *this; }
-			ConstIterator operator -(difference_type n) const { return ConstIterator(m_pArr, m_Position - n * m_direction); }
-			difference_type operator-(const ConstIterator& other) const { return m_Position - other.m_Position; }
+			constexpr ConstIterator& operator +=(difference_type n) { m_Position += n * m_direction; return *this; }
+			constexpr ConstIterator operator +(difference_type n) const { return ConstIterator(m_pArr, m_Position + n * m_direction); }
+			friend constexpr ConstIterator operator +(difference_type n, const ConstIterator& it) { return ConstIterator(it.m_pArr, it.m_Position + n * it.m_direction); }
+			constexpr ConstIterator& operator -=(difference_type n) { m_Position -= n * m_direction; return *this; }
+			constexpr ConstIterator operator -(difference_type n) const { return ConstIterator(m_pArr, m_Position - n * m_direction); }
+			constexpr difference_type operator-(const ConstIterator& other) const { return m_Position - other.m_Position; }
 
 			// Element access for random access
-			reference operator[](difference_type n) const { return m_pArr->m_data[m_Position + n * m_direction]; }
-
-			friend bool operator==(const ConstIterator& a, const ConstIterator& b) { return a.m_pArr == b.m_pArr && a.m_Position == b.m_Position; }
-			friend bool operator!=(const ConstIterator& a, const ConstIterator& b) { return a.m_pArr != b.m_pArr || a.m_Position != b.m_Position; }
-			friend bool operator<(const ConstIterator& a, const ConstIterator& b) { return a.m_pArr == b.m_pArr && a.m_Position < b.m_Position; }
-			friend bool operator>(const ConstIterator& a, const ConstIterator& b) { return b < a; }
-			friend bool operator<=(const ConstIterator& a, const ConstIterator& b) { return !(b < a); }
-			friend bool operator>=(const ConstIterator& a, const ConstIterator& b) { return !(a < b); }
-
-			const reference get() const { return m_pArr->m_data[m_Position]; }
-			void set(const reference value) { m_pArr->m_data[m_Position] = value; }
-			void next() { m_Position += m_direction; }
-			void previous() { m_Position -= m_direction; }
-			bool hasNext() const { return m_direction == 1 ? m_Position < m_pArr->m_size : m_Position >= 0; }
-			bool hasPrevious() const { return m_direction == 1 ? m_Position >= 0 : m_Position < m_pArr->m_size; }
+			constexpr reference operator[](difference_type n) const { return m_pArr->m_data[m_Position + n * m_direction]; }
+
+			friend constexpr bool operator==(const ConstIterator& a, const ConstIterator& b) { return a.m_pArr == b.m_pArr && a.m_Position == b.m_Position; }
+			friend constexpr bool operator!=(const ConstIterator& a, const ConstIterator& b) { return a.m_pArr != b.m_pArr || a.m_Position != b.m_Position; }
+			friend constexpr bool operator<(const ConstIterator& a, const ConstIterator& b) { return a.m_pArr == b.m_pArr && a.m_Position < b.m_Position; }
+			friend constexpr bool operator>(const ConstIterator& a, const ConstIterator& b) { return b < a; }
+			friend constexpr bool operator<=(const ConstIterator& a, const ConstIterator& b) { return !(b < a); }
+			friend constexpr bool operator>=(const ConstIterator& a, const ConstIterator& b) { return !(a < b); }
+
+			constexpr const reference get() const { return m_pArr->m_data[m_Position]; }
+			constexpr void set(const reference value) { m_pArr->m_data[m_Position] = value; }
+			constexpr void next() { m_Position += m_direction; }
+			constexpr void previous() { m_Position -= m_direction; }
+			constexpr bool hasNext() const { return m_direction == 1 ? m_Position < (difference_type)m_pArr->m_size : m_Position >= 0; }
+			constexpr bool hasPrevious() const { return m_direction == 1 ? m_Position >= 0 : m_Position < (difference_type)m_pArr->m_size; }
 
 		private:
 			const Array<T>* m_pArr;
-			int64_t m_Position;
+			difference_type m_Position;
 			int m_direction;
 		};
 
 		// smort stl-comforming iterators
-		Iterator begin() { return Iterator(this); }
-		Iterator end() { return Iterator(this, m_size); }
-		Iterator rbegin() { return Iterator(this, m_size - 1, -1); }
-		Iterator rend() { return Iterator(this, -1, -1); }
-		ConstIterator cbegin() const { return ConstIterator(this); }
-		ConstIterator cend() const { return ConstIterator(this, m_size); }
-		ConstIterator crbegin() const { return ConstIterator(this, m_size - 1, -1); }
-		ConstIterator crend() const { return ConstIterator(this, -1, -1); }
+		constexpr Iterator begin() { return Iterator(this); }
+		constexpr Iterator end() { return Iterator(this, m_size); }
+		constexpr Iterator rbegin() { return Iterator(this, m_size - 1, -1); }
+		constexpr Iterator rend() { return Iterator(this, -1, -1); }
+		constexpr ConstIterator cbegin() const { return ConstIterator(this); }
+		constexpr ConstIterator cend() const { return ConstIterator(this, m_size); }
+		constexpr ConstIterator crbegin() const { return ConstIterator(this, m_size - 1, -1); }
+		constexpr ConstIterator crend() const { return ConstIterator(this, -1, -1); }
 
 		//silly non-stl iterators. Task
-		Iterator iterator() { return Iterator(this); }
-		Iterator reverseIterator() { return Iterator(this, m_size - 1, -1); }
-		ConstIterator constIterator() const { return ConstIterator(this); }
-		ConstIterator constReverseIterator() const { return ConstIterator(this, m_size - 1, -1); }
+		constexpr Iterator iterator() { return Iterator(this); }
+		constexpr Iterator reverseIterator() { return Iterator(this, m_size - 1, -1); }
+		constexpr ConstIterator constIterator() const { return ConstIterator(this); }
+		constexpr ConstIterator constReverseIterator() const { return ConstIterator(this, m_size - 1, -1); }
 
 	public:
-		Array();
-		Array(size_t capacity);
-		Array(std::initializer_list<T> initList);
+		constexpr Array();
+		constexpr Array(size_t capacity);
+		constexpr Array(std::initializer_list<T> initList);
 
-		Array(const Array<T>& other);
-		Array(Array<T>&& other);
-		Array<T>& operator=(Array<T> other) noexcept(
+		constexpr Array(const Array<T>& other);
+		constexpr Array(Array<T>&& other);
+		constexpr Array<T>& operator=(Array<T> other) noexcept(
 			std::is_nothrow_move_constructible_v<T> &&
 			std::is_nothrow_move_assignable_v<T>);
 
-		~Array();
+		constexpr ~Array();
 
 	public:
-		size_t size() const { return m_size; }
-		size_t capacity() const { return m_capacity; }
+		constexpr size_t size() const { return m_size; }
+		constexpr size_t capacity() const { return m_capacity; }
 
-		size_t insert(const T& value);
-		size_t insert(T&& value);
-		size_t insert(size_t index, const T& value);
-		size_t insert(size_t index, T&& value);
+		constexpr size_t insert(const T& value);
+		constexpr size_t insert(T&& value);
+		constexpr size_t insert(size_t index, const T& value);
+		constexpr size_t insert(size_t index, T&& value);
 
-		size_t insert(const std::initializer_list<T>& initList);
-		size_t insert(size_t index, const std::initializer_list<T>& initList);
+		constexpr size_t insert(const std::initializer_list<T>& initList);
+		constexpr size_t insert(size_t index, const std::initializer_list<T>& initList);
 
-		void remove(size_t index);
+		constexpr void remove(size_t index);
 		
-		const T& operator[](size_t index) const;
-		T& operator[](size_t index);
+		constexpr const T& operator[](size_t index) const;
+		constexpr T& operator[](size_t index);
 
-		friend bool operator==(const Array<T>& a, const Array<T>& b)
+		friend constexpr bool operator==(const Array<T>& a, const Array<T>& b)
 		{
 			if (a.size() != b.size()) {
 				return false;
@@ -213,8 +221,8 @@ namespace myStl
 		}
 
 	private:
-		void reserve(size_t newCapacity);
-		void swap(Array<T>& other) noexcept;
+		constexpr void reserve(size_t newCapacity);
+		constexpr void swap(Array<T>& other) noexcept;
 	private:
 		T* m_data;
 		size_t m_size;
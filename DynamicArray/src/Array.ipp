@@ -2,60 +2,52 @@
 
 #include "Array.h"
 
-#include "stdexcept"
+#include <memory>
 
 namespace myStl
 {
 	template<typename T>
-	inline Array<T>::Array()
+	constexpr Array<T>::Array()
 		: m_size(0), m_capacity(8)
 	{
-		m_data = (T*)my_malloc(sizeof(T) * m_capacity);
-		if (!m_data)
-			throw std::bad_alloc();
+		m_data = my_allocate<T>(m_capacity);
 	}
 
 
 	template<typename T>
-	inline Array<T>::Array(size_t capacity)
+	constexpr Array<T>::Array(size_t capacity)
 		: m_size(0), m_capacity(capacity)
 	{
-		m_data = (T*)my_malloc(sizeof(T) * m_capacity);
-		if (!m_data)
-			throw std::bad_alloc();
+		m_data = my_allocate<T>(m_capacity);
 	}
 
 
 	template<typename T>
-	inline Array<T>::Array(std::initializer_list<T> initList)
+	constexpr Array<T>::Array(std::initializer_list<T> initList)
 		: m_size(initList.size()), m_capacity(initList.size())
 	{
-		m_data = (T*)my_malloc(sizeof(T) * m_capacity);
-		if (!m_data)
-			throw std::bad_alloc();
+		m_data = my_allocate<T>(m_capacity);
 		int i = 0;
 		for (const auto& item : initList)
-			new (&m_data[i++]) T(item);
+			std::construct_at(&m_data[i++], item);
 	}
 
 	
 	template<typename T>
-	inline Array<T>::Array(const Array<T>& other)
+	constexpr Array<T>::Array(const Array<T>& other)
 	{
 		m_capacity = other.m_capacity;
 		m_size = other.m_size;
 
-		m_data = (T*)my_malloc(sizeof(T) * m_capacity);
-		if (!m_data)
-			throw std::bad_alloc();
+		m_data = my_allocate<T>(m_capacity);
 
 		for (size_t i = 0; i < m_size; i++)
-			new (&m_data[i]) T(other.m_data[i]);
+			std::construct_at(&m_data[i], other.m_data[i]);
 	}
 
 
 	template<typename T>
-	inline Array<T>::Array(Array<T>&& other)
+	constexpr Array<T>::Array(Array<T>&& other)
 	{
 		m_capacity = other.m_capacity;
 		m_size = other.m_size;
@@ -68,7 +60,7 @@ namespace myStl
 
 	
 	template<typename T>
-	inline Array<T>& Array<T>::operator=(Array<T> other) noexcept(
+	constexpr Array<T>& Array<T>::operator=(Array<T> other) noexcept(
 		std::is_nothrow_move_constructible_v<T> &&
 		std::is_nothrow_move_assignable_v<T>)
 	{
@@ -78,23 +70,23 @@ namespace myStl
 
 
 	template<typename T>
-	inline Array<T>::~Array()
+	constexpr Array<T>::~Array()
 	{
 		for (size_t i = 0; i < m_size; i++)
-			m_data[i].~T();
-		my_free(m_data);
+			std::destroy_at(&m_data[i]);
+		my_deallocate(m_data, m_capacity);
 	}
 
 
 	template<typename T>
-	inline size_t Array<T>::insert(const T& value)
+	constexpr size_t Array<T>::insert(const T& value)
 	{
 		return insert(m_size, value);
 	}
 
 
 	template<typename T>
-	inline size_t Array<T>::insert(T&& value)
+	constexpr size_t Array<T>::insert(T&& value)
 	{
 		//move семантика
 		return insert(m_size, std::move(value));
@@ -102,7 +94,7 @@ namespace myStl
 
 
 	template<typename T>
-	inline size_t Array<T>::insert(size_t index, const T& value)
+	constexpr size_t Array<T>::insert(size_t index, const T& value)
 	{
 		if (m_size == m_capacity)
 		{
@@ -116,20 +108,20 @@ namespace myStl
 		{
 			for (size_t i = m_size; i > index; i--)
 			{
-				new (&m_data[i]) T(std::move(m_data[i - 1]));
-				m_data[i - 1].~T();
+				std::construct_at(&m_data[i], std::move(m_data[i - 1]));
+				std::destroy_at(&m_data[i - 1]);
 			}
 		}
 		else
 		{
 			for (size_t i = m_size; i > index; i--)
 			{
-				new (&m_data[i]) T(m_data[i - 1]);
-				m_data[i - 1].~T();
+				std::construct_at(&m_data[i], m_data[i - 1]);
+				std::destroy_at(&m_data[i - 1]);
 			}
 		}
 
-		new (&m_data[index]) T(value);
+		std::construct_at(&m_data[index], value);
 		m_size++;
 
 		return index;
@@ -137,7 +129,7 @@ namespace myStl
 
 
 	template<typename T>
-	inline size_t Array<T>::insert(size_t index, T&& value)
+	constexpr size_t Array<T>::insert(size_t index, T&& value)
 	{
 		if (m_size == m_capacity)
 		{
@@ -151,20 +143,20 @@ namespace myStl
 		{
 			for (size_t i = m_size; i > index; i--)
 			{
-				new (&m_data[i]) T(std::move(m_data[i - 1]));
-				m_data[i - 1].~T();
+				std::construct_at(&m_data[i], std::move(m_data[i - 1]));
+				std::destroy_at(&m_data[i - 1]);
 			}
 		}
 		else
 		{
 			for (size_t i = m_size; i > index; i--)
 			{
-				new (&m_data[i]) T(m_data[i - 1]);
-				m_data[i - 1].~T();
+				std::construct_at(&m_data[i], m_data[i - 1]);
+				std::destroy_at(&m_data[i - 1]);
 			}
 		}
 
-		new (&m_data[index]) T(std::move(value));
+		std::construct_at(&m_data[index], std::move(value));
 		m_size++;
 
 		return index;
@@ -172,14 +164,14 @@ namespace myStl
 
 
 	template<typename T>
-	inline size_t Array<T>::insert(const std::initializer_list<T>& initList)
+	constexpr size_t Array<T>::insert(const std::initializer_list<T>& initList)
 	{
 		return insert(m_size, initList);
 	}
 
 
 	template<typename T>
-	inline size_t Array<T>::insert(size_t index, const std::initializer_list<T>& initList)
+	constexpr size_t Array<T>::insert(size_t index, const std::initializer_list<T>& initList)
 	{
 		size_t n = initList.size();
 		if ((m_size + n) >= m_capacity)
@@ -201,21 +193,21 @@ namespace myStl
 		{
 			for (size_t i = m_size + n - 1; i > index + n - 1; i--)
 			{
-				new (&m_data[i]) T(std::move(m_data[i - n]));
-				m_data[i - n].~T();
+				std::construct_at(&m_data[i], std::move(m_data[i - n]));
+				std::destroy_at(&m_data[i - n]);
 			}
 		}
 		else
 		{
 			for (size_t i = m_size + n - 1; i > index + n - 1; i--)
 			{
-				new (&m_data[i]) T(m_data[i - n]);
-				m_data[i - n].~T();
+				std::construct_at(&m_data[i], m_data[i - n]);
+				std::destroy_at(&m_data[i - n]);
 			}
 		}
 		size_t j = index;
 		for (const auto& it : initList)
-			new (&m_data[j++]) T(it);
+			std::construct_at(&m_data[j++], it);
 
 		m_size += n;
 		return index;
@@ -223,23 +215,23 @@ namespace myStl
 
 
 	template<typename T>
-	inline void Array<T>::remove(size_t index)
+	constexpr void Array<T>::remove(size_t index)
 	{
-		m_data[index].~T();
+		std::destroy_at(&m_data[index]);
 		if constexpr (std::is_move_assignable<T>::value)
 		{
 			for (size_t i = index; i < m_size - 1; i++)
 			{
-				new(&m_data[i]) T(std::move(m_data[i + 1]));
-				m_data[i + 1].~T();
+				std::construct_at(&m_data[i], std::move(m_data[i + 1]));
+				std::destroy_at(&m_data[i + 1]);
 			}
 		}
 		else
 		{
 			for (size_t i = index; i < m_size - 1; i++)
 			{
-				new(&m_data[i]) T(m_data[i + 1]);
-				m_data[i + 1].~T();
+				std::construct_at(&m_data[i], m_data[i + 1]);
+				std::destroy_at(&m_data[i + 1]);
 			}
 		}
 		m_size--;
@@ -247,51 +239,49 @@ namespace myStl
 
 	// Индексация
 	template<typename T>
-	inline const T& Array<T>::operator[](size_t index) const
+	constexpr const T& Array<T>::operator[](size_t index) const
 	{
 		return m_data[index];
 	}
 
 
 	template<typename T>
-	inline T& Array<T>::operator[](size_t index)
+	constexpr T& Array<T>::operator[](size_t index)
 	{
 		return m_data[index];
 	}
 
 
 	template<typename T>
-	void inline Array<T>::reserve(size_t newCapacity)
+	constexpr void Array<T>::reserve(size_t newCapacity)
 	{
-		T* tmp = (T*)my_malloc(sizeof(T) * newCapacity);
-		if (!tmp)
-			throw std::bad_alloc();
+		T* tmp = my_allocate<T>(newCapacity);
 
 		if constexpr (std::is_move_constructible<T>::value)
 		{
 			for (size_t i = 0; i < m_size; i++)
 			{
-				new (&tmp[i]) T(std::move(m_data[i]));
-				m_data[i].~T();
+				std::construct_at(&tmp[i], std::move(m_data[i]));
+				std::destroy_at(&m_data[i]);
 			}
 		}
 		else
 		{
 			for (size_t i = 0; i < m_size; i++)
 			{
-				new (&tmp[i]) T(m_data[i]);
-				m_data[i].~T();
+				std::construct_at(&tmp[i], m_data[i]);
+				std::destroy_at(&m_data[i]);
 			}
 		}
 
-		my_free(m_data);
+		my_deallocate(m_data, m_capacity);
 		m_data = tmp;
 		m_capacity = newCapacity;
 	}
 
 
 	template<typename T>
-	inline void Array<T>::swap(Array<T>& other) noexcept
+	constexpr void Array<T>::swap(Array<T>& other) noexcept
 	{
 		using std::swap;
 		swap(m_data, other.m_data);
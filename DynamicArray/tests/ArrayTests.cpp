@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "../src/Array.h"
+#include <array>
 #include <string>
 #include <cmath>
 
@@ -327,3 +328,92 @@ TEST(ArrayTest, SizeAndCapacity_String)
 	EXPECT_EQ(arr.size(), 10);
 	EXPECT_GE(arr.capacity(), arr.size());
 }
+
+// ============================================================================
+// Вычисление на этапе компиляции (constexpr)
+// ============================================================================
+
+// Таблица собирается в Array во время компиляции и копируется в std::array:
+// память Array должна быть освобождена до конца вычисления
+constexpr std::array<int, 20> MakeSquaresTable()
+{
+	Array<int> squares;
+	for (int i = 0; i < 20; ++i)
+		squares.insert(i * i);
+
+	std::array<int, 20> table{};
+	size_t j = 0;
+	for (int value : squares)
+		table[j++] = value;
+	return table;
+}
+
+constexpr std::array<int, 20> SQUARES = MakeSquaresTable();
+
+// Тест 13: Таблица, посчитанная при компиляции
+TEST(ArrayConstexprTest, TableBuiltAtCompileTime)
+{
+	static_assert(SQUARES[0] == 0 && SQUARES[19] == 361);
+	for (int i = 0; i < 20; ++i)
+		EXPECT_EQ(SQUARES[i], i * i);
+}
+
+// Тест 14: Вставка и удаление при компиляции
+constexpr bool EditAtCompileTime()
+{
+	Array<int> arr = { 1, 2, 3 };
+	arr.insert(0, 10);
+	arr.insert(2, { 20, 30 });
+	arr.remove(1);
+	return arr == Array<int>{ 10, 20, 30, 2, 3 };
+}
+
+TEST(ArrayConstexprTest, InsertRemove)
+{
+	static_assert(EditAtCompileTime());
+	EXPECT_TRUE(EditAtCompileTime());
+}
+
+// Тест 15: Копирование, перемещение и итераторы при компиляции
+constexpr bool CopyMoveIterateAtCompileTime()
+{
+	Array<int> source = { 1, 2, 3, 4 };
+	Array<int> copy(source);
+	copy[0] = 100;
+	Array<int> moved(std::move(copy));
+	Array<int> assigned;
+	assigned = moved;
+
+	int reversed = 0;
+	for (auto it = assigned.reverseIterator(); it.hasNext(); it.next())
+		reversed = reversed * 10 + it.get() % 10;
+
+	return source[0] == 1 && moved[0] == 100 && copy.size() == 0
+		&& reversed == 4320 && assigned.end() - assigned.begin() == 4;
+}
+
+TEST(ArrayConstexprTest, CopyMoveIterate)
+{
+	static_assert(CopyMoveIterateAtCompileTime());
+	EXPECT_TRUE(CopyMoveIterateAtCompileTime());
+}
+
+// Тест 16: Элементы с нетривиальным деструктором при компиляции
+constexpr size_t StringsAtCompileTime()
+{
+	Array<std::string> arr;
+	for (int i = 0; i < 10; ++i)
+		arr.insert(std::string(i + 1, 'x'));
+	arr.remove(0);
+
+	size_t total = 0;
+	for (auto it = arr.cbegin(); it != arr.cend(); ++it)
+		total += it->size();
+	return total;
+}
+
+TEST(ArrayConstexprTest, Strings)
+{
+	static_assert(StringsAtCompileTime() == 54);
+	EXPECT_EQ(StringsAtCompileTime(), 54);
+}
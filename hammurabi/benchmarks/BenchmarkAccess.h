@@ -0,0 +1,109 @@
+#pragma once
+
+#include "../src/services/DisplayManager.h"
+#include "../src/services/GameEngine.h"
+#include "../src/services/SaveManager.h"
+#include <cstdio>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Доступ замеров к закрытым шагам движка, отрисовки и сохранения (друг этих классов)
+class BenchmarkAccess
+{
+public:
+	template<typename Rules>
+	static CityState& GetState(BasicGameEngine<Rules>& engine) { return engine.m_State; }
+	template<typename Rules>
+	static void SetDecisions(BasicGameEngine<Rules>& engine, const PlayerDecisions& decisions) { engine.m_Decisions = decisions; }
+
+	template<typename Rules>
+	static void DrawRoundRandom(BasicGameEngine<Rules>& engine) { engine.DrawRoundRandom(); }
+	template<typename Rules>
+	static void ApplyPlayerDecisions(BasicGameEngine<Rules>& engine, const PlayerDecisions& decisions) { engine.ApplyPlayerDecisions(decisions); }
+	template<typename Rules>
+	static void ProcessHarvest(BasicGameEngine<Rules>& engine) { engine.ProcessHarvest(); }
+	template<typename Rules>
+	static void ProcessRats(BasicGameEngine<Rules>& engine) { engine.ProcessRats(); }
+	template<typename Rules>
+	static void ProcessHunger(BasicGameEngine<Rules>& engine) { engine.ProcessHunger(); }
+	template<typename Rules>
+	static void ProcessNewPeople(BasicGameEngine<Rules>& engine) { engine.ProcessNewPeople(); }
+	template<typename Rules>
+	static void ProcessPlague(BasicGameEngine<Rules>& engine) { engine.ProcessPlague(); }
+	template<typename Rules>
+	static void SimulateRound(BasicGameEngine<Rules>& engine) { engine.SimulateRound(); }
+	template<typename Rules>
+	static void EndRound(BasicGameEngine<Rules>& engine) { engine.EndRound(); }
+
+	static void BuildRoundStartText(DisplayManager& display, const CityState& state) { display.BuildRoundStartText(state); }
+	static void PrintArtWithText(DisplayManager& display, const ArtAsset& art, const std::vector<std::string_view>& text) { display.PrintArtWithText(art, text); }
+	static const std::vector<std::string_view>& GetReportLines(const DisplayManager& display) { return display.m_ReportLines; }
+
+	static bool SaveToFile(SaveManager& saves, const std::filesystem::path& filePath, const CityState& state, const GameStatistics& stats)
+	{
+		return saves.SaveToFile(filePath, state, stats);
+	}
+	static bool LoadFromFile(const SaveManager& saves, const std::filesystem::path& filePath, CityState& state, GameStatistics& stats)
+	{
+		return saves.LoadFromFile(filePath, state, stats);
+	}
+};
+
+// Вывод в терминал уходит в /dev/null, пока объект жив: замер отрисовки не зависит от терминала
+class StdoutToNull
+{
+public:
+	StdoutToNull()
+		: m_Saved(-1)
+	{
+#ifdef __linux__
+		std::fflush(stdout);
+		int null = open("/dev/null", O_WRONLY);
+		if (null < 0)
+			return;
+		m_Saved = dup(STDOUT_FILENO);
+		dup2(null, STDOUT_FILENO);
+		close(null);
+#endif
+	}
+
+	~StdoutToNull()
+	{
+#ifdef __linux__
+		std::fflush(stdout);
+		if (m_Saved >= 0)
+		{
+			dup2(m_Saved, STDOUT_FILENO);
+			close(m_Saved);
+		}
+#endif
+	}
+
+	StdoutToNull(const StdoutToNull&) = delete;
+	StdoutToNull& operator=(const StdoutToNull&) = delete;
+
+private:
+	int m_Saved;
+};
+
+// Город середины партии: все шаги раунда идут по своим обычным веткам
+inline CityState MakeBenchmarkCity()
+{
+	CityState state;
+	state.Round = 5;
+	state.Population = 120;
+	state.Area = 1100;
+	state.WheatReserves = 3200;
+	state.AcrePrice = 21;
+	return state;
+}
+
+inline PlayerDecisions MakeBenchmarkDecisions()
+{
+	return PlayerDecisions{ 10, 0, 2300, 900 };
+}
@@ -0,0 +1,180 @@
+#include "BenchmarkAccess.h"
+#include "../src/services/EnginePool.h"
+#include "../src/services/StatePublisher.h"
+#include <benchmark/benchmark.h>
+
+// Шаги раунда движка. Каждая итерация начинает с одного и того же города
+// (копия CityState входит в замер), поэтому шаг всегда идет по одной ветке.
+// Обе политики правил: DefaultRules сворачивает правила в константы, RuntimeRules читает поля.
+
+namespace
+{
+	template<typename Rules>
+	using EngineStep = void (*)(BasicGameEngine<Rules>&);
+
+	template<typename Rules>
+	void RunRoundStep(benchmark::State& state, EngineStep<Rules> step)
+	{
+		BasicGameEngine<Rules> engine;
+		engine.Reset(42, MakeBenchmarkCity());
+		BenchmarkAccess::ApplyPlayerDecisions(engine, MakeBenchmarkDecisions());
+		BenchmarkAccess::DrawRoundRandom(engine);
+
+		CityState& city = BenchmarkAccess::GetState(engine);
+		const CityState start = city;
+		for (auto _ : state)
+		{
+			city = start;
+			step(engine);
+			benchmark::DoNotOptimize(city);
+		}
+	}
+}
+
+template<typename Rules>
+void BM_ApplyPlayerDecisions(benchmark::State& state)
+{
+	BasicGameEngine<Rules> engine;
+	engine.Reset(42, MakeBenchmarkCity());
+	PlayerDecisions decisions = MakeBenchmarkDecisions();
+
+	CityState& city = BenchmarkAccess::GetState(engine);
+	const CityState start = city;
+	for (auto _ : state)
+	{
+		city = start;
+		BenchmarkAccess::ApplyPlayerDecisions(engine, decisions);
+		benchmark::DoNotOptimize(city);
+	}
+}
+BENCHMARK_TEMPLATE(BM_ApplyPlayerDecisions, DefaultRules);
+BENCHMARK_TEMPLATE(BM_ApplyPlayerDecisions, RuntimeRules);
+
+template<typename Rules>
+void BM_DrawRoundRandom(benchmark::State& state)
+{
+	RunRoundStep<Rules>(state, BenchmarkAccess::DrawRoundRandom<Rules>);
+}
+BENCHMARK_TEMPLATE(BM_DrawRoundRandom, DefaultRules);
+BENCHMARK_TEMPLATE(BM_DrawRoundRandom, RuntimeRules);
+
+template<typename Rules>
+void BM_ProcessHarvest(benchmark::State& state)
+{
+	RunRoundStep<Rules>(state, BenchmarkAccess::ProcessHarvest<Rules>);
+}
+BENCHMARK_TEMPLATE(BM_ProcessHarvest, DefaultRules);
+BENCHMARK_TEMPLATE(BM_ProcessHarvest, RuntimeRules);
+
+template<typename Rules>
+void BM_ProcessRats(benchmark::State& state)
+{
+	RunRoundStep<Rules>(state, BenchmarkAccess::ProcessRats<Rules>);
+}
+BENCHMARK_TEMPLATE(BM_ProcessRats, DefaultRules);
+BENCHMARK_TEMPLATE(BM_ProcessRats, RuntimeRules);
+
+template<typename Rules>
+void BM_ProcessHunger(benchmark::State& state)
+{
+	RunRoundStep<Rules>(state, BenchmarkAccess::ProcessHunger<Rules>);
+}
+BENCHMARK_TEMPLATE(BM_ProcessHunger, DefaultRules);
+BENCHMARK_TEMPLATE(BM_ProcessHunger, RuntimeRules);
+
+template<typename Rules>
+void BM_ProcessNewPeople(benchmark::State& state)
+{
+	RunRoundStep<Rules>(state, BenchmarkAccess::ProcessNewPeople<Rules>);
+}
+BENCHMARK_TEMPLATE(BM_ProcessNewPeople, DefaultRules);
+BENCHMARK_TEMPLATE(BM_ProcessNewPeople, RuntimeRules);
+
+template<typename Rules>
+void BM_ProcessPlague(benchmark::State& state)
+{
+	RunRoundStep<Rules>(state, BenchmarkAccess::ProcessPlague<Rules>);
+}
+BENCHMARK_TEMPLATE(BM_ProcessPlague, DefaultRules);
+BENCHMARK_TEMPLATE(BM_ProcessPlague, RuntimeRules);
+
+// Конец раунда целиком: розыгрыш, пять шагов и запись в журнал (журнал закрыт).
+// Аргумент 1 - с публикацией состояния наблюдателю после каждого шага.
+void BM_SimulateRound(benchmark::State& state)
+{
+	StatePublisher publisher;
+	GameEngine engine;
+	engine.Reset(42, MakeBenchmarkCity());
+	if (state.range(0) != 0)
+	{
+		if (!publisher.Open())
+		{
+			state.SkipWithError("Разделяемая память недоступна");
+			return;
+		}
+		engine.SetPublisher(&publisher);
+	}
+	BenchmarkAccess::ApplyPlayerDecisions(engine, MakeBenchmarkDecisions());
+
+	CityState& city = BenchmarkAccess::GetState(engine);
+	const CityState start = city;
+	for (auto _ : state)
+	{
+		city = start;
+		BenchmarkAccess::SimulateRound(engine);
+		benchmark::DoNotOptimize(city);
+	}
+}
+BENCHMARK(BM_SimulateRound)->Arg(0)->Arg(1);
+
+void BM_GetRating(benchmark::State& state)
+{
+	GameStatistics stats;
+	for (uint32_t round = 1; round <= 10; round++)
+	{
+		stats.SetRoundStatistics(round, EconomyFixed::FromRatio(round, 100));
+	}
+
+	Quantity area = 1000;
+	Quantity population = 100;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(area);
+		benchmark::DoNotOptimize(stats.GetRating(area, population));
+	}
+}
+BENCHMARK(BM_GetRating);
+
+// Новая партия: сброс того же движка, создание нового и выдача из пула потока
+void BM_EngineReset(benchmark::State& state)
+{
+	GameEngine engine;
+	uint32_t seed = 0;
+	for (auto _ : state)
+	{
+		engine.Reset(seed++);
+		benchmark::DoNotOptimize(engine.GetState());
+	}
+}
+BENCHMARK(BM_EngineReset);
+
+void BM_EngineConstruct(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		GameEngine engine;
+		benchmark::DoNotOptimize(engine.GetState());
+	}
+}
+BENCHMARK(BM_EngineConstruct);
+
+void BM_EnginePoolAcquire(benchmark::State& state)
+{
+	uint32_t seed = 0;
+	for (auto _ : state)
+	{
+		GameEnginePool::Handle engine = GameEnginePool::Acquire(seed++);
+		benchmark::DoNotOptimize(engine->GetState());
+	}
+}
+BENCHMARK(BM_EnginePoolAcquire);
@@ -0,0 +1,164 @@
+#include "BenchmarkAccess.h"
+#include "../src/services/AutoSaver.h"
+#include "../src/services/ReplayJournal.h"
+#include "../src/services/ScriptedInput.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+// Сохранения, автосохранение и журнал партии. Файлы пишутся в рабочий каталог замеров.
+
+namespace
+{
+	const std::filesystem::path BENCH_SAVE = "./Saves/bench_save";
+	const std::filesystem::path BENCH_JOURNAL = "./Journals/bench_journal.bin";
+	constexpr auto SLOW_WRITE = std::chrono::milliseconds(20);
+
+	GameStatistics MakeBenchmarkStats()
+	{
+		GameStatistics stats;
+		for (uint32_t round = 1; round <= 5; round++)
+		{
+			stats.SetRoundStatistics(round, EconomyFixed::FromRatio(round, 50));
+		}
+		return stats;
+	}
+}
+
+void BM_SaveToFile(benchmark::State& state)
+{
+	SaveManager saves;
+	CityState city = MakeBenchmarkCity();
+	GameStatistics stats = MakeBenchmarkStats();
+
+	for (auto _ : state)
+	{
+		if (!BenchmarkAccess::SaveToFile(saves, BENCH_SAVE, city, stats))
+		{
+			state.SkipWithError("Не удалось записать сохранение");
+			break;
+		}
+	}
+}
+BENCHMARK(BM_SaveToFile)->Unit(benchmark::kMicrosecond);
+
+void BM_LoadFromFile(benchmark::State& state)
+{
+	SaveManager saves;
+	CityState city = MakeBenchmarkCity();
+	GameStatistics stats = MakeBenchmarkStats();
+	BenchmarkAccess::SaveToFile(saves, BENCH_SAVE, city, stats);
+
+	for (auto _ : state)
+	{
+		CityState loaded;
+		GameStatistics loadedStats;
+		if (!BenchmarkAccess::LoadFromFile(saves, BENCH_SAVE, loaded, loadedStats))
+		{
+			state.SkipWithError("Не удалось прочитать сохранение");
+			break;
+		}
+		benchmark::DoNotOptimize(loaded);
+	}
+}
+BENCHMARK(BM_LoadFromFile)->Unit(benchmark::kMicrosecond);
+
+// Запись и чтение одного и того же сохранения подряд, с проверкой, что город вернулся тем же
+void BM_SaveLoadRoundTrip(benchmark::State& state)
+{
+	SaveManager saves;
+	CityState city = MakeBenchmarkCity();
+	GameStatistics stats = MakeBenchmarkStats();
+
+	for (auto _ : state)
+	{
+		CityState loaded;
+		GameStatistics loadedStats;
+		if (!BenchmarkAccess::SaveToFile(saves, BENCH_SAVE, city, stats)
+			|| !BenchmarkAccess::LoadFromFile(saves, BENCH_SAVE, loaded, loadedStats)
+			|| loaded.Population != city.Population || loaded.WheatReserves != city.WheatReserves)
+		{
+			state.SkipWithError("Сохранение не прошло круг записи и чтения");
+			break;
+		}
+	}
+}
+BENCHMARK(BM_SaveLoadRoundTrip)->Unit(benchmark::kMicrosecond);
+
+// Сколько раунд ждет автосохранение: только передача снимка фоновому потоку
+void BM_AutoSaverSubmit(benchmark::State& state)
+{
+	AutoSaver saver;
+	CityState city = MakeBenchmarkCity();
+	GameStatistics stats = MakeBenchmarkStats();
+
+	for (auto _ : state)
+	{
+		city.Round++;
+		saver.Submit(city, stats);
+	}
+	state.counters["coalesced"] = (double)saver.GetCoalescedCount();
+}
+BENCHMARK(BM_AutoSaverSubmit);
+
+// Задержка конца раунда: 0 - без автосохранения, 1 - автосохранение на диск,
+// 2 - запись снимка занимает SLOW_WRITE (медленный диск). Раунд не должен ее ждать.
+void BM_EndRoundAutosave(benchmark::State& state)
+{
+	AutoSaver diskSaver;
+	AutoSaver slowSaver([](const GameSnapshot&)
+	{
+		std::this_thread::sleep_for(SLOW_WRITE);
+		return true;
+	});
+
+	// Пустой сценарий: раунд не спрашивает о сохранении и не ждет клавишу
+	ScriptedInput script;
+	GameEngine engine;
+	engine.Reset(42, MakeBenchmarkCity());
+	engine.SetScript(&script);
+	if (state.range(0) == 1)
+		engine.SetAutoSaver(&diskSaver);
+	else if (state.range(0) == 2)
+		engine.SetAutoSaver(&slowSaver);
+	BenchmarkAccess::ApplyPlayerDecisions(engine, MakeBenchmarkDecisions());
+
+	CityState& city = BenchmarkAccess::GetState(engine);
+	const CityState start = city;
+	double maxSeconds = 0.0;
+	for (auto _ : state)
+	{
+		city = start;
+		auto started = std::chrono::steady_clock::now();
+		BenchmarkAccess::EndRound(engine);
+		maxSeconds = std::max(maxSeconds, std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count());
+	}
+	state.counters["max_us"] = maxSeconds * 1e6;
+	state.counters["written"] = (double)(diskSaver.GetWrittenCount() + slowSaver.GetWrittenCount());
+}
+BENCHMARK(BM_EndRoundAutosave)->Arg(0)->Arg(1)->Arg(2);
+
+// Запись раунда в журнал (в буфер; на диск - пачками)
+void BM_JournalAppendRound(benchmark::State& state)
+{
+	std::filesystem::create_directories(BENCH_JOURNAL.parent_path());
+	ReplayJournal journal;
+	CityState city = MakeBenchmarkCity();
+	if (!journal.Open(BENCH_JOURNAL, city, RuntimeRules()))
+	{
+		state.SkipWithError("Не удалось открыть журнал");
+		return;
+	}
+
+	RoundRecord record{ city.Round, RoundDraws(), MakeBenchmarkDecisions() };
+	for (auto _ : state)
+	{
+		record.Round++;
+		journal.AppendRound(record, city);
+	}
+	journal.Close();
+	state.SetBytesProcessed((int64_t)std::filesystem::file_size(BENCH_JOURNAL));
+}
+BENCHMARK(BM_JournalAppendRound);
@@ -0,0 +1,94 @@
+#include "BenchmarkAccess.h"
+#include "../src/services/ArtCache.h"
+#include "../src/services/ReportTemplate.h"
+#include "../tests/AllocationCounter.h"
+#include <benchmark/benchmark.h>
+#include <string>
+
+// Отчет раунда и кадр экрана. Счетчик allocations - выделений памяти
+// на итерацию после разгона: у отчета и кадра он должен быть нулевым.
+// Считаются только выделения потока замера внутри цикла (AllocationCounter).
+
+namespace
+{
+	void ReportAllocations(benchmark::State& state, const AllocationCounter& allocations)
+	{
+		state.counters["allocations"] = benchmark::Counter((double)allocations.GetCount(), benchmark::Counter::kAvgIterations);
+	}
+}
+
+void BM_BuildRoundStartText(benchmark::State& state)
+{
+	DisplayManager display;
+	CityState city = MakeBenchmarkCity();
+	city.HasPlague = true;
+	BenchmarkAccess::BuildRoundStartText(display, city);
+
+	AllocationCounter allocations;
+	for (auto _ : state)
+	{
+		BenchmarkAccess::BuildRoundStartText(display, city);
+		benchmark::DoNotOptimize(BenchmarkAccess::GetReportLines(display).data());
+	}
+	ReportAllocations(state, allocations);
+}
+BENCHMARK(BM_BuildRoundStartText);
+
+void BM_ReportTemplateAppend(benchmark::State& state)
+{
+	ReportTemplate report("В этом году умерло {DeadFromHunger} человек, прибыло {NewPeople}, население {Population}");
+	CityState city = MakeBenchmarkCity();
+	std::string output;
+	output.reserve(256);
+
+	AllocationCounter allocations;
+	for (auto _ : state)
+	{
+		output.clear();
+		report.AppendTo(city, output);
+		benchmark::DoNotOptimize(output.data());
+	}
+	ReportAllocations(state, allocations);
+}
+BENCHMARK(BM_ReportTemplateAppend);
+
+// Кадр без вывода: аргумент 1 - каждый раз новый кадр целиком, 0 - разница с прошлым
+void BM_ComposeRoundStart(benchmark::State& state)
+{
+	DisplayManager display;
+	CityState city = MakeBenchmarkCity();
+	display.ComposeRoundStart(city);
+
+	AllocationCounter allocations;
+	for (auto _ : state)
+	{
+		if (state.range(0) != 0)
+			display.InvalidateFrame();
+		city.Population ^= 1;
+		benchmark::DoNotOptimize(display.ComposeRoundStart(city).data());
+	}
+	ReportAllocations(state, allocations);
+}
+BENCHMARK(BM_ComposeRoundStart)->Arg(0)->Arg(1);
+
+// Кадр вместе с выводом в терминал, направленным в /dev/null
+void BM_PrintArtWithText(benchmark::State& state)
+{
+	DisplayManager display;
+	CityState city = MakeBenchmarkCity();
+	BenchmarkAccess::BuildRoundStartText(display, city);
+	const std::vector<std::string_view>& lines = BenchmarkAccess::GetReportLines(display);
+	const ArtAsset& art = ArtCache::Instance().GetAdvisor();
+
+	StdoutToNull silence;
+	BenchmarkAccess::PrintArtWithText(display, art, lines);
+
+	AllocationCounter allocations;
+	for (auto _ : state)
+	{
+		display.InvalidateFrame();
+		BenchmarkAccess::PrintArtWithText(display, art, lines);
+	}
+	ReportAllocations(state, allocations);
+}
+BENCHMARK(BM_PrintArtWithText);
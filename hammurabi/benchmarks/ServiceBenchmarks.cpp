@@ -0,0 +1,210 @@
+#include "BenchmarkAccess.h"
+#include "../src/domain/ScriptedStrategy.h"
+#include "../src/services/Leaderboard.h"
+#include "../src/services/OutcomeQuery.h"
+#include "../src/services/OutcomeStore.h"
+#include "../src/services/StatePublisher.h"
+#include "../src/utils/SplitMix64.h"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+// Общие службы процесса: таблица лучших, хранилище исходов и публикация состояния
+
+namespace
+{
+	const std::filesystem::path BENCH_STORE = "./bench_outcomes";
+	constexpr uint32_t STORE_GAMES = 100000;
+
+	uint64_t MakeRandomScore(SplitMix64& random)
+	{
+		OutcomeClass outcome = (OutcomeClass)(random() % (uint64_t)OutcomeClass::Count);
+		return Leaderboard::MakeScore(outcome, (int32_t)(random() % 40), EconomyFixed::FromRaw((int64_t)(random() % EconomyFixed::ONE_RAW)));
+	}
+
+	// Таблица с миллионом партий, общая для замеров чтения
+	Leaderboard& GetFilledLeaderboard()
+	{
+		static std::unique_ptr<Leaderboard> leaderboard = []
+		{
+			auto filled = std::make_unique<Leaderboard>();
+			SplitMix64 random(1);
+			for (uint32_t i = 0; i < 1000000; i++)
+			{
+				filled->Insert(MakeRandomScore(random), 100, 1000, EconomyFixed());
+			}
+			return filled;
+		}();
+		return *leaderboard;
+	}
+
+	// Хранилище исходов STORE_GAMES партий: строится один раз за запуск
+	const OutcomeStore& GetBenchmarkStore()
+	{
+		static OutcomeStore store = []
+		{
+			std::filesystem::remove_all(BENCH_STORE);
+			{
+				OutcomeStoreWriter writer(BENCH_STORE, 0);
+				GameEngine engine;
+				for (uint32_t game = 0; game < STORE_GAMES; game++)
+				{
+					engine.Reset(game);
+					while (true)
+					{
+						engine.StartRound();
+						engine.PlayRound(DecideScripted(ScriptedStrategy::FeedAndPlant, engine.GetState(), DefaultRules{}));
+						const CityState& city = engine.GetState();
+						writer.Append(0, game, city, engine.GetStats().GetRoundStatistics(city.Round).DeadFromHungerPercent);
+						if (engine.CheckGameOver())
+							break;
+						engine.AdvanceRound();
+						if (engine.IsCompleted())
+							break;
+					}
+				}
+			}
+
+			OutcomeStore opened;
+			opened.Open(BENCH_STORE);
+			return opened;
+		}();
+		return store;
+	}
+}
+
+// Запись итога партии; из нескольких потоков - каждый в свою часть таблицы
+void BM_LeaderboardInsert(benchmark::State& state)
+{
+	static Leaderboard* leaderboard = nullptr;
+	if (state.thread_index() == 0)
+		leaderboard = new Leaderboard();
+
+	SplitMix64 random(state.thread_index() + 1);
+	for (auto _ : state)
+	{
+		leaderboard->Insert(MakeRandomScore(random), 100, 1000, EconomyFixed());
+	}
+	state.SetItemsProcessed(state.iterations());
+
+	if (state.thread_index() == 0)
+	{
+		delete leaderboard;
+		leaderboard = nullptr;
+	}
+}
+BENCHMARK(BM_LeaderboardInsert)->Threads(1)->Threads(4);
+
+void BM_LeaderboardTop(benchmark::State& state)
+{
+	Leaderboard& leaderboard = GetFilledLeaderboard();
+	std::vector<LeaderboardEntry> top;
+	for (auto _ : state)
+	{
+		leaderboard.GetTop((size_t)state.range(0), top);
+		benchmark::DoNotOptimize(top.data());
+	}
+}
+BENCHMARK(BM_LeaderboardTop)->Arg(10)->Arg(100);
+
+void BM_LeaderboardPercentileRank(benchmark::State& state)
+{
+	Leaderboard& leaderboard = GetFilledLeaderboard();
+	SplitMix64 random(2);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(leaderboard.GetPercentileRank(MakeRandomScore(random)));
+	}
+}
+BENCHMARK(BM_LeaderboardPercentileRank);
+
+// Добавление строки в хранилище, включая сжатие и запись полных сегментов
+void BM_OutcomeStoreAppend(benchmark::State& state)
+{
+	std::filesystem::path directory = BENCH_STORE / "append";
+	std::filesystem::remove_all(directory);
+	CityState city = MakeBenchmarkCity();
+
+	{
+		OutcomeStoreWriter writer(directory, 0);
+		uint64_t row = 0;
+		for (auto _ : state)
+		{
+			city.WheatReserves = (Quantity)(row % 5000);
+			writer.Append(0, row++, city, EconomyFixed());
+		}
+	}
+	state.SetItemsProcessed(state.iterations());
+	std::filesystem::remove_all(directory);
+}
+BENCHMARK(BM_OutcomeStoreAppend);
+
+// Запросы по хранилищу; bytes_per_second - разжатые значения прочитанных столбцов
+void BM_OutcomeQuery(benchmark::State& state, std::vector<std::string> words)
+{
+	const OutcomeStore& store = GetBenchmarkStore();
+	OutcomeQuery query;
+	if (!query.Parse(words))
+	{
+		state.SkipWithError("Запрос не разобран");
+		return;
+	}
+
+	OutcomeQueryEngine engine(store);
+	QueryResult result;
+	uint64_t bytes = 0;
+	for (auto _ : state)
+	{
+		engine.Run(query, result);
+		bytes += result.BytesScanned;
+	}
+	state.SetBytesProcessed((int64_t)bytes);
+	state.counters["rows"] = (double)store.GetRowCount();
+}
+BENCHMARK_CAPTURE(BM_OutcomeQuery, filter, std::vector<std::string>{ "count", "where", "HasPlague" })
+	->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_OutcomeQuery, grouped, std::vector<std::string>{ "mean", "DeadFromHunger", "by", "Round", "where", "HasPlague" })
+	->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_OutcomeQuery, two_filters, std::vector<std::string>{ "max", "Population", "where", "Round", ">=", "5", "and", "HasPlague", "=", "0" })
+	->Unit(benchmark::kMicrosecond);
+
+// Стоимость публикации для игры и чтения снимка наблюдателем (в одном процессе)
+void BM_StatePublish(benchmark::State& state)
+{
+	StatePublisher publisher;
+	if (!publisher.Open())
+	{
+		state.SkipWithError("Разделяемая память недоступна");
+		return;
+	}
+
+	CityState city = MakeBenchmarkCity();
+	RoundStatistics statistics;
+	for (auto _ : state)
+	{
+		city.Population++;
+		publisher.Publish(city, statistics, ProfilePhase::ProcessHarvest);
+	}
+}
+BENCHMARK(BM_StatePublish);
+
+void BM_StateMonitorRead(benchmark::State& state)
+{
+	StatePublisher publisher;
+	StateMonitor monitor;
+	if (!publisher.Open())
+	{
+		state.SkipWithError("Разделяемая память недоступна");
+		return;
+	}
+	publisher.Publish(MakeBenchmarkCity(), RoundStatistics(), ProfilePhase::ProcessPlague);
+	monitor.Open((uint32_t)getpid());
+
+	MonitorSnapshot snapshot{};
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(monitor.Read(snapshot));
+	}
+}
+BENCHMARK(BM_StateMonitorRead);
@@ -0,0 +1,121 @@
+#include "BenchmarkAccess.h"
+#include "../src/domain/ScriptedStrategy.h"
+#include "../src/services/EmpireSimulation.h"
+#include "../src/services/VecEnv.h"
+#include "../src/services/WhatIfAdvisor.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+// Пакетные режимы: партии без консоли, империя, пакетная среда и прогноз советника.
+// Счетчики *_per_second - пропускная способность в единицах режима.
+
+// Полные партии без ввода и вывода: как в переборе правил, до свержения или последнего раунда
+template<typename Rules>
+void BM_HeadlessGame(benchmark::State& state)
+{
+	Rules rules;
+	BasicGameEngine<Rules> engine(rules);
+	ScriptedStrategy strategy = (ScriptedStrategy)state.range(0);
+
+	uint32_t seed = 0;
+	uint64_t rounds = 0;
+	for (auto _ : state)
+	{
+		engine.Reset(seed++);
+		while (true)
+		{
+			engine.StartRound();
+			engine.PlayRound(DecideScripted(strategy, engine.GetState(), rules));
+			rounds++;
+			if (engine.CheckGameOver())
+				break;
+			engine.AdvanceRound();
+			if (engine.IsCompleted())
+				break;
+		}
+		benchmark::DoNotOptimize(engine.GetState());
+	}
+
+	state.SetLabel(GetScriptedStrategyName(strategy));
+	state.counters["games_per_second"] = benchmark::Counter((double)state.iterations(), benchmark::Counter::kIsRate);
+	state.counters["rounds_per_second"] = benchmark::Counter((double)rounds, benchmark::Counter::kIsRate);
+}
+BENCHMARK_TEMPLATE(BM_HeadlessGame, DefaultRules)
+	->Arg((int64_t)ScriptedStrategy::FeedAndPlant)
+	->Arg((int64_t)ScriptedStrategy::LandTrader);
+BENCHMARK_TEMPLATE(BM_HeadlessGame, RuntimeRules)
+	->Arg((int64_t)ScriptedStrategy::FeedAndPlant)
+	->Arg((int64_t)ScriptedStrategy::LandTrader);
+
+// Раунд империи: аргументы - городов и потоков
+void BM_EmpireRound(benchmark::State& state)
+{
+	EmpireConfig config{ (uint32_t)state.range(0), 7, (uint32_t)state.range(1), ScriptedStrategy::FeedAndPlant };
+	auto empire = std::make_unique<EmpireSimulation>(config);
+
+	uint64_t cities = 0;
+	for (auto _ : state)
+	{
+		if (empire->IsCompleted())
+		{
+			state.PauseTiming();
+			empire = std::make_unique<EmpireSimulation>(config);
+			state.ResumeTiming();
+		}
+		empire->PlayRound();
+		cities += config.Cities;
+	}
+	state.counters["cities_per_second"] = benchmark::Counter((double)cities, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_EmpireRound)->Args({ 10000, 1 })->Args({ 100000, 1 })->Args({ 100000, 4 })->Unit(benchmark::kMillisecond);
+
+// Шаг пакетной среды с постоянным действием: аргументы - сред и потоков
+void BM_VecEnvStep(benchmark::State& state)
+{
+	VecEnvConfig config{ (uint32_t)state.range(0), 7, (uint32_t)state.range(1) };
+	VecEnv env(config);
+
+	std::vector<PlayerDecisions> actions(config.Envs, MakeBenchmarkDecisions());
+	std::vector<float> observations(config.Envs * VecEnv::OBSERVATION_SIZE);
+	std::vector<float> rewards(config.Envs);
+	std::vector<uint8_t> dones(config.Envs);
+	env.Reset(observations.data());
+
+	for (auto _ : state)
+	{
+		env.Step(actions.data(), observations.data(), rewards.data(), dones.data());
+		benchmark::DoNotOptimize(rewards.data());
+	}
+	state.counters["env_steps_per_second"] = benchmark::Counter((double)state.iterations() * config.Envs, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_VecEnvStep)->Args({ 1024, 1 })->Args({ 16384, 1 })->Args({ 16384, 4 });
+
+// Прогноз советника без кэша (сброс правил очищает кэш) и повторный прогноз из кэша
+void BM_AdvisorPreview(benchmark::State& state)
+{
+	WhatIfAdvisor advisor(DefaultRules{}, (uint32_t)state.range(0));
+	CityState city = MakeBenchmarkCity();
+	PlayerDecisions decisions = MakeBenchmarkDecisions();
+
+	for (auto _ : state)
+	{
+		advisor.SetRules(DefaultRules{});
+		benchmark::DoNotOptimize(advisor.Preview(city, decisions).Samples);
+	}
+}
+BENCHMARK(BM_AdvisorPreview)->Arg(1)->Arg(4)->Unit(benchmark::kMicrosecond);
+
+void BM_AdvisorPreviewCached(benchmark::State& state)
+{
+	WhatIfAdvisor advisor(DefaultRules{}, 1);
+	CityState city = MakeBenchmarkCity();
+	PlayerDecisions decisions = MakeBenchmarkDecisions();
+	advisor.Preview(city, decisions);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(advisor.Preview(city, decisions).Samples);
+	}
+}
+BENCHMARK(BM_AdvisorPreviewCached);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../utils/FixedPoint.h"
 #include <cstdint>
 #include <filesystem>
 #include <string>
@@ -32,29 +33,123 @@ namespace GameConfig
 		constexpr uint32_t PLAGUE_PROBABILITY = 15;      // Вероятность чумы в процентах
 		constexpr float MAX_DEAD_FROM_HUNGER = 0.45f;     // Максимальный процент умерших от голода (проигрыш)
 		constexpr uint32_t MAX_NEW_PEOPLE = 50;          // Максимум новых людей за раунд
+		constexpr uint32_t SAVES_PAGE_SIZE = 20;         // Сохранений на одной странице списка
+		constexpr uint32_t FIXED_POINT_BITS = 16;        // Дробных бит в экономике движка (доли, семена, крысы)
+		constexpr uint32_t STATS_HISTORY_ROUNDS = 64;    // Раундов, хранимых поштучно (дальше только сводные величины)
+		constexpr uint32_t STATS_RECENT_SHIFT = 2;       // Сглаживание недавней доли умерших: вес раунда 1/2^N
+		constexpr size_t ENGINE_POOL_IDLE = 16;          // Свободных движков в пуле одного потока
+		// Пределы правил из файла и прогона правил: с ними произведения
+		// акров на семена и жителей на акры остаются в int64
+		constexpr uint32_t MAX_RULE_ROUNDS = 1000;
+		constexpr uint32_t MAX_RULE_ACRES_PER_PERSON = 1000;
+		constexpr uint32_t MAX_RULE_SEEDS_PER_ACRE = 1000;
+	}
+	
+	// Журнал партий
+	namespace Replay
+	{
+		constexpr uint32_t CHECKPOINT_INTERVAL = 4;      // Раундов между полными снимками CityState
+		constexpr size_t FLUSH_BYTES = 4096;             // Размер пачки кадров перед записью в файл
+		constexpr size_t KEEP_JOURNALS = 32;             // Журналов в JOURNALS_DIR, старые удаляются
+	}
+	
+	// Ввод решений из файла или канала (режим --script)
+	namespace Script
+	{
+		constexpr size_t READ_CHUNK = 1 << 16;           // Байт за одно чтение
+	}
+	
+	// Профилирование (только в сборке с HAMMURABI_PROFILE)
+	namespace Profile
+	{
+		constexpr uint32_t SAMPLE_PERIOD = 64;                // Замеряется каждый N-й вызов фазы
+		constexpr size_t TRACE_EVENTS_PER_THREAD = 1 << 18;   // Событий трассы на поток, дальше только гистограммы
+	}
+	
+	// Империя из многих городов
+	namespace Empire
+	{
+		constexpr size_t CITIES_PER_CHUNK = 1024;        // Городов в куске параллельного раунда (не зависит от потоков)
+		constexpr uint32_t MAX_CITIES = 1000000;         // Предел числа городов в одном запуске
+		constexpr int64_t SURPLUS_EXPORT_PERCENT = 50;   // Какую часть излишка пшеницы город отдает голодающим
+	}
+	
+	// Пакетная среда для обучения агентов
+	namespace VecEnv
+	{
+		constexpr size_t ENVS_PER_CHUNK = 256;           // Сред в куске параллельного шага
+		constexpr float OVERTHROWN_REWARD = -10.0f;      // Награда за свержение из-за голода
+		constexpr float RATING_REWARD = 5.0f;            // Награда в конце партии за каждую ступень оценки выше "плохо"
+	}
+	
+	// Прогноз советника перед утверждением решений
+	namespace Advisor
+	{
+		constexpr size_t PREVIEW_SAMPLES = 4096;         // Исходов раунда в одном прогнозе
+		constexpr size_t SAMPLES_PER_CHUNK = 256;        // Исходов в куске параллельного прогона
+		constexpr size_t SAMPLES_PER_WAVE = 1024;        // Между волнами проверяется бюджет времени
+		constexpr uint32_t BUDGET_MICROSECONDS = 5000;   // Предел времени: после него прогноз неполный и не кэшируется
+		constexpr size_t CACHE_ENTRIES = 64;             // Прогнозов в кэше
+	}
+	
+	// Таблица лучших партий процесса
+	namespace Leaderboard
+	{
+		constexpr size_t SHARDS = 16;                    // Независимых частей со своей блокировкой
+		constexpr size_t TOP_PER_SHARD = 256;            // Лучших партий в части; top-k отвечает до стольких
+		constexpr uint32_t HISTOGRAM_ACRES = 32;         // Акров на жителя в гистограмме рангов (больше - в последней ячейке)
+		constexpr uint32_t SNAPSHOT_SECONDS = 60;        // Период записи снимка на диск
+	}
+	
+	// Столбцовое хранилище исходов раундов
+	namespace Store
+	{
+		constexpr uint32_t SEGMENT_ROWS = 1 << 16;       // Строк в одном файле сегмента
+		constexpr size_t BATCH_ROWS = 1024;              // Строк в пачке разжатия и фильтра запроса
+		constexpr uint64_t DENSE_GROUPS = 1 << 16;       // Ключи группировки меньше этого - в плоском массиве
+	}
+	
+	// Публикация состояния партии для внешнего наблюдателя
+	namespace Monitor
+	{
+		constexpr const char* SHARED_NAME_PREFIX = "/hammurabi-";   // Имя разделяемой памяти: префикс и pid игры
+		constexpr uint32_t READ_ATTEMPTS = 64;           // Попыток чтения, пока запись не закончится
+		constexpr uint32_t POLL_MILLISECONDS = 500;      // Период опроса в --monitor
 	}
 	
 	// Пути к файлам
 	namespace Paths
 	{
 		const std::filesystem::path SAVES_DIR = "./Saves/";
+		const std::filesystem::path SAVES_CATALOG = "./SavesCatalog.txt";
+		const std::filesystem::path AUTOSAVE_NAME = "autosave";
+		const std::filesystem::path JOURNALS_DIR = "./Journals/";
+		const std::filesystem::path LEADERBOARD = "./Leaderboard.txt";
 		const std::filesystem::path MAIN_SCREEN = "./Screens/MainScren.txt";
 		const std::filesystem::path ADVISOR_ART = "./Screens/advisor.txt";
 		const std::filesystem::path RAT_ART = "./Screens/rat.txt";
+		const std::filesystem::path PROFILE_TRACE = "./hammurabi_trace.json";
+		const std::filesystem::path PROFILE_SUMMARY = "./hammurabi_profile.txt";
 	}
 	
 	// Сообщения для пользователя
 	namespace Messages
 	{
 		const std::string INTEGER_INPUT_ERROR = "Повелитель, введи число, я не понимаю. ";
+		const std::string BUY_LAND_PROMPT = "\nСколько акров земли повелеваешь купить? ";
+		const std::string SELL_LAND_PROMPT = "Сколько акров земли повелеваешь продать? ";
+		const std::string WHEAT_FOR_FOOD_PROMPT = "Сколько бушелей пшеницы повелеваешь съесть? ";
+		const std::string ACRES_TO_PLANT_PROMPT = "Сколько акров земли повелеваешь засеять? ";
 		const std::string LOAD_SAVE_PROMPT = "Вы хотели бы продолжить игру с сохранения? Y/N\n";
 		const std::string SAVE_FILE_PROMPT = "Введите номер или название сохранения.\n";
+		const std::string SAVE_NEXT_PAGE_HINT = "Введите > для следующей страницы.\n";
 		const std::string SAVE_NAME_PROMPT = "Введите название файла: ";
 		const std::string SAVE_ERROR = "Не удалось сохранить файл, приносим своиз извинения. Скилл ишью.";
 		const std::string LOAD_ERROR = "Не удалось открыть файл, начинаем новую игру.\n";
 		const std::string GAME_OVER_HUNGER = "\n\nПо вашей вине погибло слишком много людей! Вы не достойны быть правителем!\n";
 		const std::string SAVE_ROUND_PROMPT = "\nОстановить игру и сохранить раунд? Y/N";
 		const std::string GAME_FINISHED = "\nПовелитель, ты окончил свое правление!\n";
+		const std::string CONFIRM_DECISIONS_PROMPT = "\nУтвердить решения? Y/N\n";
 	}
 	
 	// Оценки правления
@@ -67,3 +162,5 @@ namespace GameConfig
 	}
 }
 
+// Доли и коэффициенты экономики: целочисленные, с точностью FIXED_POINT_BITS
+using EconomyFixed = FixedPoint<GameConfig::Game::FIXED_POINT_BITS>;
@@ -0,0 +1,106 @@
+#include "GameRules.h"
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <string>
+
+RuntimeRules::RuntimeRules()
+	: MaxRounds(DefaultRules::MaxRounds),
+	WheatPerPerson(DefaultRules::WheatPerPerson),
+	AcresPerPerson(DefaultRules::AcresPerPerson),
+	SeedsPerAcre(DefaultRules::SeedsPerAcre),
+	MinAcrePrice(DefaultRules::MinAcrePrice),
+	MaxAcrePrice(DefaultRules::MaxAcrePrice),
+	MinWheatPerAcre(DefaultRules::MinWheatPerAcre),
+	MaxWheatPerAcre(DefaultRules::MaxWheatPerAcre),
+	RatsEatMaxPercent(DefaultRules::RatsEatMaxPercent),
+	PlagueProbability(DefaultRules::PlagueProbability),
+	MaxDeadFromHunger(DefaultRules::MaxDeadFromHunger),
+	MaxNewPeople(DefaultRules::MaxNewPeople)
+{
+}
+
+bool RuntimeRules::LoadFromFile(const std::filesystem::path& path)
+{
+	std::ifstream file(path);
+	if (!file.is_open())
+		return false;
+
+	RuntimeRules loaded;
+	std::string name;
+	double value = 0.0;
+	while (file >> name)
+	{
+		// Неизвестное имя или нечисловое значение - файл целиком отвергается
+		if (!(file >> value) || !loaded.Set(name, value))
+			return false;
+	}
+
+	if (!loaded.IsConsistent())
+		return false;
+
+	*this = loaded;
+	return true;
+}
+
+bool RuntimeRules::Set(const std::string& name, double value)
+{
+	uint32_t* count = nullptr;
+	EconomyFixed* fraction = nullptr;
+	if (name == "MAX_ROUNDS")
+		count = &MaxRounds;
+	else if (name == "WHEAT_PER_PERSON")
+		count = &WheatPerPerson;
+	else if (name == "ACRES_PER_PERSON")
+		count = &AcresPerPerson;
+	else if (name == "SEEDS_PER_ACRE")
+		fraction = &SeedsPerAcre;
+	else if (name == "MIN_ACRE_PRICE")
+		count = &MinAcrePrice;
+	else if (name == "MAX_ACRE_PRICE")
+		count = &MaxAcrePrice;
+	else if (name == "MIN_WHEAT_PER_ACRE")
+		count = &MinWheatPerAcre;
+	else if (name == "MAX_WHEAT_PER_ACRE")
+		count = &MaxWheatPerAcre;
+	else if (name == "RATS_EAT_MAX_PERCENT")
+		fraction = &RatsEatMaxPercent;
+	else if (name == "PLAGUE_PROBABILITY")
+		count = &PlagueProbability;
+	else if (name == "MAX_DEAD_FROM_HUNGER")
+		fraction = &MaxDeadFromHunger;
+	else if (name == "MAX_NEW_PEOPLE")
+		count = &MaxNewPeople;
+	else
+		return false;
+
+	// Проверка до приведения: (uint32_t) отрицательного или слишком большого double - UB.
+	// Отрицательное (и NaN) не проходит первое сравнение
+	if (!(value >= 0.0) || value > (double)std::numeric_limits<uint32_t>::max())
+		return false;
+
+	if (fraction != nullptr)
+	{
+		*fraction = EconomyFixed::FromDouble(value);
+		return true;
+	}
+
+	// Целое правило не округляется молча: 2.5 человека на акр - ошибка в файле
+	if (value != std::floor(value))
+		return false;
+	*count = (uint32_t)value;
+	return true;
+}
+
+bool RuntimeRules::IsConsistent() const
+{
+	return MaxRounds > 0 && MaxRounds <= GameConfig::Game::MAX_RULE_ROUNDS
+		&& WheatPerPerson > 0
+		&& AcresPerPerson <= GameConfig::Game::MAX_RULE_ACRES_PER_PERSON
+		&& SeedsPerAcre > EconomyFixed() && SeedsPerAcre <= EconomyFixed::FromRatio(GameConfig::Game::MAX_RULE_SEEDS_PER_ACRE, 1)
+		&& MinAcrePrice > 0 && MinAcrePrice <= MaxAcrePrice
+		&& MinWheatPerAcre <= MaxWheatPerAcre
+		&& RatsEatMaxPercent <= EconomyFixed::One()
+		&& PlagueProbability <= 100
+		&& MaxDeadFromHunger > EconomyFixed();
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "GameConfig.h"
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+// Политики правил для BasicGameEngine.
+// Дробные правила хранятся в EconomyFixed: движок считает их целочисленно.
+// Движок обращается к правилам как m_Rules.WheatPerPerson и т.п.: у DefaultRules
+// это static constexpr члены, и компилятор подставляет константы, как раньше
+// с GameConfig::Game. У RuntimeRules те же имена - обычные поля, загружаемые из файла.
+
+// Правила оригинальной игры, известные на этапе компиляции
+struct DefaultRules
+{
+	static constexpr uint32_t MaxRounds = GameConfig::Game::MAX_ROUNDS;
+	static constexpr uint32_t WheatPerPerson = GameConfig::Game::WHEAT_PER_PERSON;
+	static constexpr uint32_t AcresPerPerson = GameConfig::Game::ACRES_PER_PERSON;
+	static constexpr EconomyFixed SeedsPerAcre = EconomyFixed::FromFloat(GameConfig::Game::SEEDS_PER_ACRE);
+	static constexpr uint32_t MinAcrePrice = GameConfig::Game::MIN_ACRE_PRICE;
+	static constexpr uint32_t MaxAcrePrice = GameConfig::Game::MAX_ACRE_PRICE;
+	static constexpr uint32_t MinWheatPerAcre = GameConfig::Game::MIN_WHEAT_PER_ACRE;
+	static constexpr uint32_t MaxWheatPerAcre = GameConfig::Game::MAX_WHEAT_PER_ACRE;
+	static constexpr EconomyFixed RatsEatMaxPercent = EconomyFixed::FromFloat(GameConfig::Game::RATS_EAT_MAX_PERCENT);
+	static constexpr uint32_t PlagueProbability = GameConfig::Game::PLAGUE_PROBABILITY;
+	static constexpr EconomyFixed MaxDeadFromHunger = EconomyFixed::FromFloat(GameConfig::Game::MAX_DEAD_FROM_HUNGER);
+	static constexpr uint32_t MaxNewPeople = GameConfig::Game::MAX_NEW_PEOPLE;
+};
+
+// Правила, загружаемые во время работы - для экспериментов без перекомпиляции.
+// Файл: строки вида "ИМЯ значение", имена как в GameConfig::Game
+// (например "PLAGUE_PROBABILITY 30"). Отсутствующие строки берутся из DefaultRules.
+struct RuntimeRules
+{
+	uint32_t MaxRounds;
+	uint32_t WheatPerPerson;
+	uint32_t AcresPerPerson;
+	EconomyFixed SeedsPerAcre;
+	uint32_t MinAcrePrice;
+	uint32_t MaxAcrePrice;
+	uint32_t MinWheatPerAcre;
+	uint32_t MaxWheatPerAcre;
+	EconomyFixed RatsEatMaxPercent;
+	uint32_t PlagueProbability;
+	EconomyFixed MaxDeadFromHunger;
+	uint32_t MaxNewPeople;
+
+	RuntimeRules();
+
+	bool LoadFromFile(const std::filesystem::path& path);
+	// Установка правила по имени из GameConfig::Game. false для неизвестного имени и для
+	// недопустимого значения (отрицательного, дробного у целого правила, больше UINT32_MAX);
+	// при отказе правила не меняются
+	bool Set(const std::string& name, double value);
+	bool IsConsistent() const;
+
+	bool operator==(const RuntimeRules& other) const = default;
+};
+
+// Значения любой политики правил в полях RuntimeRules (например, для заголовка журнала)
+template<typename Rules>
+RuntimeRules MakeRuntimeRules(const Rules& rules)
+{
+	RuntimeRules result;
+	result.MaxRounds = rules.MaxRounds;
+	result.WheatPerPerson = rules.WheatPerPerson;
+	result.AcresPerPerson = rules.AcresPerPerson;
+	result.SeedsPerAcre = rules.SeedsPerAcre;
+	result.MinAcrePrice = rules.MinAcrePrice;
+	result.MaxAcrePrice = rules.MaxAcrePrice;
+	result.MinWheatPerAcre = rules.MinWheatPerAcre;
+	result.MaxWheatPerAcre = rules.MaxWheatPerAcre;
+	result.RatsEatMaxPercent = rules.RatsEatMaxPercent;
+	result.PlagueProbability = rules.PlagueProbability;
+	result.MaxDeadFromHunger = rules.MaxDeadFromHunger;
+	result.MaxNewPeople = rules.MaxNewPeople;
+	return result;
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "CityState.h"
+#include "PlayerDecisions.h"
+#include "RoundDraws.h"
+#include "../utils/SplitMix64.h"
+#include <cstdint>
+
+// Шаги раунда над одним городом.
+// Функции меняют только переданный CityState и не трогают ничего общего,
+// поэтому разные города можно считать в разных потоках. BasicGameEngine
+// вызывает их из своих Process*, EmpireSimulation - для каждого города империи.
+
+// Розыгрыш случайных величин раунда. Порядок обращений к генератору
+// фиксирован: цена акра в начале раунда, затем урожай, крысы, чума.
+// Числа берутся из NextInRange, а не из std::uniform_int_distribution,
+// поэтому журналы и контрольные суммы совпадают между компиляторами.
+template<typename Rules>
+uint32_t DrawAcrePrice(SplitMix64& random, const Rules& rules)
+{
+	return (uint32_t)random.NextInRange(rules.MinAcrePrice, rules.MaxAcrePrice);
+}
+
+template<typename Rules>
+void DrawCityRound(RoundDraws& draws, SplitMix64& random, const Rules& rules)
+{
+	draws.WheatPerAcre = (uint32_t)random.NextInRange(rules.MinWheatPerAcre, rules.MaxWheatPerAcre);
+
+	// Доля крыс разыгрывается сразу в единицах EconomyFixed
+	draws.RatsShare = EconomyFixed::FromRaw((int64_t)random.NextInRange(0, (uint64_t)rules.RatsEatMaxPercent.GetRaw()));
+
+	draws.PlagueRoll = (uint32_t)random.NextInRange(1, 100);
+}
+
+inline void ResetCityRound(CityState& state)
+{
+	state.DeadFromHunger = 0;
+	state.NewPeople = 0;
+	state.HasPlague = false;
+	state.WheatEatenByRats = 0;
+}
+
+template<typename Rules>
+void ApplyCityDecisions(CityState& state, const PlayerDecisions& decisions, const Rules& rules)
+{
+	if (decisions.BuyLand > 0)
+	{
+		Quantity cost = QuantityMul((Quantity)decisions.BuyLand, state.AcrePrice);
+		state.Area = QuantityAdd(state.Area, (Quantity)decisions.BuyLand);
+		state.WheatReserves = QuantitySub(state.WheatReserves, cost);
+	}
+	else if (decisions.SellLand > 0)
+	{
+		Quantity income = QuantityMul((Quantity)decisions.SellLand, state.AcrePrice);
+		state.Area = QuantitySub(state.Area, (Quantity)decisions.SellLand);
+		state.WheatReserves = QuantityAdd(state.WheatReserves, income);
+	}
+
+	state.WheatConsumed = decisions.WheatForFood;
+	state.WheatReserves = QuantitySub(state.WheatReserves, (Quantity)decisions.WheatForFood);
+
+	Quantity seedsNeeded = rules.SeedsPerAcre.Scale((Quantity)decisions.AcresToPlant);
+	state.WorkableArea = decisions.AcresToPlant;
+	state.WheatReserves = QuantitySub(state.WheatReserves, seedsNeeded);
+}
+
+inline void ApplyCityHarvest(CityState& state, const RoundDraws& draws)
+{
+	state.WheatPerAcre = draws.WheatPerAcre;
+	Quantity harvested = QuantityMul(state.WorkableArea, state.WheatPerAcre);
+	state.WheatReserves = QuantityAdd(state.WheatReserves, harvested);
+}
+
+inline void ApplyCityRats(CityState& state, const RoundDraws& draws)
+{
+	state.WheatEatenByRats = draws.RatsShare.Scale(state.WheatReserves);
+	state.WheatReserves = QuantitySub(state.WheatReserves, state.WheatEatenByRats);
+}
+
+// Возвращает долю умерших от голода - по ней решается, свергнут ли правитель
+template<typename Rules>
+EconomyFixed ApplyCityHunger(CityState& state, const Rules& rules)
+{
+	Quantity oldPop = state.Population;
+
+	Quantity peopleFed = state.WheatConsumed / rules.WheatPerPerson;
+	Quantity minVal = state.Population;
+	if (peopleFed < minVal)
+		minVal = peopleFed;
+	state.DeadFromHunger = state.Population - minVal;
+
+	EconomyFixed deadPercent;
+	if (oldPop > 0)
+	{
+		deadPercent = EconomyFixed::FromRatio(state.DeadFromHunger, oldPop);
+	}
+
+	state.Population = state.Population - state.DeadFromHunger;
+	return deadPercent;
+}
+
+template<typename Rules>
+void ApplyCityNewPeople(CityState& state, const Rules& rules)
+{
+	Quantity wheatBeforeRats = QuantityAdd(state.WheatReserves, state.WheatEatenByRats);
+
+	// Знаковая 64-битная формула: при больших запасах int32 здесь переполнялся
+	int64_t part1 = (int64_t)(state.DeadFromHunger / 2);
+	int64_t part2 = (5 - (int64_t)state.WheatPerAcre) * (int64_t)wheatBeforeRats / 600;
+	int64_t newPeople = part1 + part2 + 1;
+
+	if (newPeople < 0)
+		newPeople = 0;
+	if (newPeople > (int64_t)rules.MaxNewPeople)
+		newPeople = (int64_t)rules.MaxNewPeople;
+
+	state.NewPeople = (Quantity)newPeople;
+	state.Population = QuantityAdd(state.Population, state.NewPeople);
+}
+
+template<typename Rules>
+void ApplyCityPlague(CityState& state, const RoundDraws& draws, const Rules& rules)
+{
+	state.HasPlague = (draws.PlagueRoll <= rules.PlagueProbability);
+
+	if (state.HasPlague)
+	{
+		state.Population /= 2;
+	}
+}
@@ -16,7 +16,7 @@ CityState::CityState()
 {
 }
 
-CityState::CityState(uint32_t population, uint32_t area, uint32_t wheatReserves)
+CityState::CityState(Quantity population, Quantity area, Quantity wheatReserves)
 	: Population(population),
 	Area(area),
 	WheatReserves(wheatReserves),
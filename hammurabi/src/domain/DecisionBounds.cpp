@@ -0,0 +1,102 @@
+#include "DecisionBounds.h"
+#include <algorithm>
+#include <limits>
+
+DecisionBounds::DecisionBounds(const CityState& state)
+	: DecisionBounds(state, DefaultRules::AcresPerPerson, DefaultRules::SeedsPerAcre)
+{
+}
+
+DecisionBounds::DecisionBounds(const CityState& state, uint32_t acresPerPerson, EconomyFixed seedsPerAcre)
+	: m_Wheat(state.WheatReserves),
+	m_Area(state.Area),
+	m_Price(state.AcrePrice),
+	m_MaxAcresByPeople((int64_t)state.Population * acresPerPerson),
+	m_SeedsPerAcreRaw(seedsPerAcre.GetRaw()),
+	m_Population(state.Population),
+	m_MaxBuy(0)
+{
+	// До объявления цены (AcrePrice == 0) купить можно сколько угодно
+	m_MaxBuy = m_Price > 0 ? m_Wheat / m_Price : std::numeric_limits<int32_t>::max();
+	m_MaxBuy = std::min<int64_t>(m_MaxBuy, std::numeric_limits<int32_t>::max());
+}
+
+Quantity DecisionBounds::GetPopulation() const
+{
+	return m_Population;
+}
+
+int64_t DecisionBounds::GetAcrePrice() const
+{
+	return m_Price;
+}
+
+int32_t DecisionBounds::GetMaxBuy() const
+{
+	return (int32_t)m_MaxBuy;
+}
+
+int32_t DecisionBounds::GetMaxSell() const
+{
+	return (int32_t)std::min<int64_t>(m_Area, std::numeric_limits<int32_t>::max());
+}
+
+int32_t DecisionBounds::GetMaxFood(const PlayerDecisions& decisions) const
+{
+	int64_t wheat = GetWheatAfterTrade(decisions);
+	return (int32_t)std::clamp<int64_t>(wheat, 0, std::numeric_limits<int32_t>::max());
+}
+
+int32_t DecisionBounds::GetMaxPlant(const PlayerDecisions& decisions) const
+{
+	// floor(acres * raw / 2^bits) <= budget  <=>  acres * raw < (budget + 1) * 2^bits
+	int64_t seedBudget = GetSeedBudget(decisions);
+	int64_t bySeeds = std::numeric_limits<int32_t>::max();
+	if (m_SeedsPerAcreRaw > 0)
+		bySeeds = seedBudget < 0 ? -1 : (((seedBudget + 1) << EconomyFixed::FRACTION_BITS) - 1) / m_SeedsPerAcreRaw;
+	int64_t maxPlant = std::min({ bySeeds, GetAreaAfterTrade(decisions), m_MaxAcresByPeople });
+	return (int32_t)std::clamp<int64_t>(maxPlant, 0, std::numeric_limits<int32_t>::max());
+}
+
+int64_t DecisionBounds::GetWheatAfterTrade(const PlayerDecisions& decisions) const
+{
+	return m_Wheat + ((int64_t)decisions.SellLand - decisions.BuyLand) * m_Price;
+}
+
+int64_t DecisionBounds::GetAreaAfterTrade(const PlayerDecisions& decisions) const
+{
+	return m_Area + (int64_t)decisions.BuyLand - decisions.SellLand;
+}
+
+int64_t DecisionBounds::GetSeedBudget(const PlayerDecisions& decisions) const
+{
+	return GetWheatAfterTrade(decisions) - decisions.WheatForFood;
+}
+
+int64_t DecisionBounds::GetMaxAcresByPeople() const
+{
+	return m_MaxAcresByPeople;
+}
+
+bool DecisionBounds::IsValid(const PlayerDecisions& decisions) const
+{
+	int64_t buy = decisions.BuyLand;
+	int64_t sell = decisions.SellLand;
+	int64_t food = decisions.WheatForFood;
+	int64_t plant = decisions.AcresToPlant;
+
+	int64_t areaAfterTrade = m_Area + buy - sell;
+	int64_t seedBudget = m_Wheat + (sell - buy) * m_Price - food;
+
+	// Битовые & вместо && - все сравнения считаются без условных переходов
+	return (buy >= 0) & (sell >= 0) & ((buy == 0) | (sell == 0))
+		& (buy <= m_MaxBuy) & (sell <= m_Area)
+		& (food >= 0) & (seedBudget >= 0)
+		& (plant >= 0) & (plant <= areaAfterTrade) & (plant <= m_MaxAcresByPeople)
+		& (SeedsFor(plant) <= seedBudget);
+}
+
+int64_t DecisionBounds::SeedsFor(int64_t acres) const
+{
+	return (acres * m_SeedsPerAcreRaw) >> EconomyFixed::FRACTION_BITS;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "../config/GameRules.h"
+#include "CityState.h"
+#include "PlayerDecisions.h"
+#include <cstdint>
+
+// Шаги решетки решений для перебора: торговля землей, еда, посев
+struct DecisionLatticeStep
+{
+	int32_t Land;
+	int32_t Food;
+	int32_t Plant;
+};
+
+// Границы допустимых решений, посчитанные один раз за раунд по CityState.
+// Учитывает связь решений: купленная земля дорожает семенами и едой,
+// проданная - приносит пшеницу, но уменьшает площадь для посева.
+// Все проверки целочисленные: семена считаются в EconomyFixed, как в движке.
+class DecisionBounds
+{
+public:
+	explicit DecisionBounds(const CityState& state);
+	template<typename Rules>
+	DecisionBounds(const CityState& state, const Rules& rules);
+
+	Quantity GetPopulation() const;
+	int64_t GetAcrePrice() const;
+	int32_t GetMaxBuy() const;
+	int32_t GetMaxSell() const;
+	int32_t GetMaxFood(const PlayerDecisions& decisions) const;
+	int32_t GetMaxPlant(const PlayerDecisions& decisions) const;
+
+	// Пшеница и земля после торговли, пшеница после еды
+	int64_t GetWheatAfterTrade(const PlayerDecisions& decisions) const;
+	int64_t GetAreaAfterTrade(const PlayerDecisions& decisions) const;
+	int64_t GetSeedBudget(const PlayerDecisions& decisions) const;
+	int64_t GetMaxAcresByPeople() const;
+
+	// Проверка всех ограничений сразу, без ветвлений
+	bool IsValid(const PlayerDecisions& decisions) const;
+
+	// Обход всех допустимых решений на решетке с заданными шагами.
+	// Отрицательная торговля землей - продажа, положительная - покупка.
+	template<typename Visitor>
+	void ForEachFeasible(const DecisionLatticeStep& step, Visitor&& visit) const;
+
+	int64_t SeedsFor(int64_t acres) const;
+
+private:
+	DecisionBounds(const CityState& state, uint32_t acresPerPerson, EconomyFixed seedsPerAcre);
+
+private:
+	int64_t m_Wheat;
+	int64_t m_Area;
+	int64_t m_Price;
+	int64_t m_MaxAcresByPeople;
+	int64_t m_SeedsPerAcreRaw;      // EconomyFixed::GetRaw()
+	Quantity m_Population;
+	int64_t m_MaxBuy;
+};
+
+template<typename Rules>
+DecisionBounds::DecisionBounds(const CityState& state, const Rules& rules)
+	: DecisionBounds(state, rules.AcresPerPerson, rules.SeedsPerAcre)
+{
+}
+
+template<typename Visitor>
+void DecisionBounds::ForEachFeasible(const DecisionLatticeStep& step, Visitor&& visit) const
+{
+	if (step.Land <= 0 || step.Food <= 0 || step.Plant <= 0)
+		return;
+
+	// Торговля кратна шагу и проходит через ноль
+	int64_t firstTrade = -(m_Area / step.Land) * step.Land;
+	PlayerDecisions decisions{};
+
+	for (int64_t trade = firstTrade; trade <= m_MaxBuy; trade += step.Land)
+	{
+		decisions.BuyLand = trade > 0 ? (int32_t)trade : 0;
+		decisions.SellLand = trade < 0 ? (int32_t)-trade : 0;
+
+		int64_t maxFood = GetWheatAfterTrade(decisions);
+		for (int64_t food = 0; food <= maxFood; food += step.Food)
+		{
+			decisions.WheatForFood = (int32_t)food;
+			decisions.AcresToPlant = 0;
+
+			int64_t maxPlant = GetMaxPlant(decisions);
+			for (int64_t plant = 0; plant <= maxPlant; plant += step.Plant)
+			{
+				decisions.AcresToPlant = (int32_t)plant;
+				visit(static_cast<const PlayerDecisions&>(decisions));
+			}
+		}
+	}
+}
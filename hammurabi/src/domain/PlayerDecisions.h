@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+// Решения правителя за раунд
+struct PlayerDecisions
+{
+	int32_t BuyLand;
+	int32_t SellLand;
+	int32_t WheatForFood;
+	int32_t AcresToPlant;
+};
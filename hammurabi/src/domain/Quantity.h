@@ -0,0 +1,50 @@
+#pragma once
+
+#include "../utils/SaturatingMath.h"
+#include <cstdint>
+
+// Тип количеств города (население, акры, бушели) и операции над ними.
+//
+// По умолчанию - uint32_t и обычная арифметика, как в исходной игре;
+// только умножение идет в 64 битах с насыщением.
+// При сборке с HAMMURABI_LARGE_SCALE (/D HAMMURABI_LARGE_SCALE) - uint64_t
+// и арифметика с насыщением: сценарии с империями в 10^8 акров
+// не переполняются молча, а упираются в предел типа.
+#ifdef HAMMURABI_LARGE_SCALE
+using Quantity = uint64_t;
+
+inline Quantity QuantityAdd(Quantity a, Quantity b)
+{
+	return SaturatingAdd(a, b);
+}
+
+inline Quantity QuantitySub(Quantity a, Quantity b)
+{
+	return SaturatingSub(a, b);
+}
+
+inline Quantity QuantityMul(Quantity a, Quantity b)
+{
+	return SaturatingMul(a, b);
+}
+#else
+using Quantity = uint32_t;
+
+inline Quantity QuantityAdd(Quantity a, Quantity b)
+{
+	return a + b;
+}
+
+inline Quantity QuantitySub(Quantity a, Quantity b)
+{
+	return a - b;
+}
+
+// Произведение (стоимость земли, урожай) считается в 64 битах и насыщается
+// до предела uint32_t, а не заворачивается через ноль
+inline Quantity QuantityMul(Quantity a, Quantity b)
+{
+	uint64_t product = (uint64_t)a * b;
+	return product > UINT32_MAX ? UINT32_MAX : (Quantity)product;
+}
+#endif
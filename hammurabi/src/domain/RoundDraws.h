@@ -0,0 +1,15 @@
+#pragma once
+
+#include "../config/GameConfig.h"
+#include <cstdint>
+
+// Случайные величины одного раунда.
+// Движок сначала разыгрывает их, а затем применяет в шагах Process*,
+// поэтому раунд можно повторить, подставив записанные значения.
+struct RoundDraws
+{
+	uint32_t AcrePrice;     // Цена акра (разыгрывается в начале раунда)
+	uint32_t WheatPerAcre;  // Урожайность
+	EconomyFixed RatsShare; // Доля запасов, съеденная крысами
+	uint32_t PlagueRoll;    // Бросок 1..100 для чумы
+};
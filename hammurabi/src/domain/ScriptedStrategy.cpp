@@ -0,0 +1,28 @@
+#include "ScriptedStrategy.h"
+
+bool ParseScriptedStrategy(const std::string& name, ScriptedStrategy& strategy)
+{
+	if (name == "feed")
+	{
+		strategy = ScriptedStrategy::FeedAndPlant;
+		return true;
+	}
+	if (name == "trader")
+	{
+		strategy = ScriptedStrategy::LandTrader;
+		return true;
+	}
+	return false;
+}
+
+const char* GetScriptedStrategyName(ScriptedStrategy strategy)
+{
+	switch (strategy)
+	{
+	case ScriptedStrategy::FeedAndPlant:
+		return "feed";
+	case ScriptedStrategy::LandTrader:
+		return "trader";
+	}
+	return "unknown";
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CityState.h"
+#include "DecisionBounds.h"
+#include "PlayerDecisions.h"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+// Простые правители для симуляций без игрока
+enum class ScriptedStrategy : uint8_t
+{
+	FeedAndPlant,   // Кормить всех, засеять сколько можно, землей не торговать
+	LandTrader,     // То же, плюс покупать дешевую землю и продавать лишнюю дорогую
+};
+
+bool ParseScriptedStrategy(const std::string& name, ScriptedStrategy& strategy);
+const char* GetScriptedStrategyName(ScriptedStrategy strategy);
+
+// Решения стратегии всегда проходят DecisionBounds::IsValid
+template<typename Rules>
+PlayerDecisions DecideScripted(ScriptedStrategy strategy, const CityState& state, const Rules& rules)
+{
+	DecisionBounds bounds(state, rules);
+	PlayerDecisions decisions{};
+
+	int64_t foodNeeded = (int64_t)state.Population * rules.WheatPerPerson;
+	int64_t areaNeeded = (int64_t)state.Population * rules.AcresPerPerson;
+
+	if (strategy == ScriptedStrategy::LandTrader)
+	{
+		int64_t cheapPrice = rules.MinAcrePrice + (rules.MaxAcrePrice - rules.MinAcrePrice) / 3;
+		int64_t dearPrice = rules.MaxAcrePrice - (rules.MaxAcrePrice - rules.MinAcrePrice) / 3;
+
+		if (state.AcrePrice <= cheapPrice && (int64_t)state.Area < areaNeeded)
+		{
+			// Покупаем на то, что останется после еды и семян на всю землю
+			int64_t spare = (int64_t)state.WheatReserves - foodNeeded - bounds.SeedsFor(areaNeeded);
+			int64_t buy = std::min<int64_t>(spare / std::max<int64_t>(state.AcrePrice, 1), areaNeeded - (int64_t)state.Area);
+			decisions.BuyLand = (int32_t)std::clamp<int64_t>(buy, 0, bounds.GetMaxBuy());
+		}
+		else if (state.AcrePrice >= dearPrice && (int64_t)state.Area > areaNeeded)
+		{
+			// Земля, которую некому обрабатывать, продается
+			decisions.SellLand = (int32_t)std::min<int64_t>((int64_t)state.Area - areaNeeded, bounds.GetMaxSell());
+		}
+	}
+
+	decisions.WheatForFood = (int32_t)std::min<int64_t>(foodNeeded, bounds.GetMaxFood(decisions));
+	decisions.AcresToPlant = bounds.GetMaxPlant(decisions);
+	return decisions;
+}
@@ -1,40 +1,111 @@
 #include "Statistics.h"
 #include <algorithm>
-#include <numeric>
+#include <istream>
+#include <ostream>
+
+namespace
+{
+	// Экспоненциальное среднее: к прошлому значению добавляется 1/2^STATS_RECENT_SHIFT разницы
+	EconomyFixed Smooth(EconomyFixed previous, EconomyFixed value)
+	{
+		int64_t delta = value.GetRaw() - previous.GetRaw();
+		return EconomyFixed::FromRaw(previous.GetRaw() + delta / ((int64_t)1 << GameConfig::Game::STATS_RECENT_SHIFT));
+	}
+}
 
 GameStatistics::GameStatistics()
+	: m_Rounds(0),
+	m_Sum(0),
+	m_SumSquares(0),
+	m_Min(),
+	m_Max(),
+	m_EvictedMin(),
+	m_EvictedMax(),
+	m_Recent(),
+	m_RecentBefore()
 {
-	m_Rounds.fill(RoundStatistics{});
+	m_History.fill(RoundStatistics{});
 }
 
-void GameStatistics::SetRoundStatistics(uint32_t round, float deadFromHungerPercent)
+void GameStatistics::SetRoundStatistics(uint32_t round, EconomyFixed deadFromHungerPercent)
 {
-	if (round > 0 && round <= MAX_ROUNDS)
+	if (round == 0)
+		return;
+	
+	if (round > m_Rounds)
+	{
+		// Длинный пропуск: нулевые раунды не меняют суммы и вытесняют весь буфер
+		if (round - m_Rounds > HISTORY_ROUNDS)
+		{
+			// Вытесняются все записанные раунды и нулевые, не поместившиеся в буфер
+			bool skippedEvicted = round - 1 - m_Rounds > HISTORY_ROUNDS;
+			if (m_Rounds == 0)
+			{
+				m_EvictedMin = EconomyFixed();
+				m_EvictedMax = EconomyFixed();
+			}
+			else
+			{
+				m_EvictedMin = skippedEvicted ? std::min(m_Min, EconomyFixed()) : m_Min;
+				m_EvictedMax = m_Max;
+			}
+			m_History.fill(RoundStatistics{});
+			m_Min = EconomyFixed();
+			m_Recent = EconomyFixed();
+			m_Rounds = round - 1;
+		}
+		while (m_Rounds + 1 < round)
+		{
+			AppendRound(EconomyFixed());
+		}
+		AppendRound(deadFromHungerPercent);
+		return;
+	}
+	
+	// Перезапись: например, раунд переигрывается после загрузки сохранения
+	if (!IsInHistory(round))
+		return;
+	
+	RoundStatistics& slot = m_History[(round - 1) % HISTORY_ROUNDS];
+	int64_t oldRaw = slot.DeadFromHungerPercent.GetRaw();
+	int64_t newRaw = deadFromHungerPercent.GetRaw();
+	m_Sum += newRaw - oldRaw;
+	m_SumSquares += (uint64_t)(newRaw * newRaw) - (uint64_t)(oldRaw * oldRaw);
+	if (round == m_Rounds)
 	{
-		m_Rounds[round - 1].DeadFromHungerPercent = deadFromHungerPercent;
+		m_Recent = m_Rounds == 1 ? deadFromHungerPercent : Smooth(m_RecentBefore, deadFromHungerPercent);
+	}
+	slot.DeadFromHungerPercent = deadFromHungerPercent;
+	
+	// Старое значение было крайним - другого такого раунда может и не быть
+	if (oldRaw == m_Min.GetRaw() || oldRaw == m_Max.GetRaw())
+	{
+		RecalculateBounds();
+	}
+	else
+	{
+		m_Min = std::min(m_Min, deadFromHungerPercent);
+		m_Max = std::max(m_Max, deadFromHungerPercent);
 	}
 }
 
 RoundStatistics GameStatistics::GetRoundStatistics(uint32_t round) const
 {
-	if (round > 0 && round <= MAX_ROUNDS)
+	if (IsInHistory(round))
 	{
-		return m_Rounds[round - 1];
+		return m_History[(round - 1) % HISTORY_ROUNDS];
 	}
 	return RoundStatistics{};
 }
 
-float GameStatistics::CalculateAverageDeadFromHunger() const
+EconomyFixed GameStatistics::CalculateAverageDeadFromHunger() const
 {
-	float sum = 0.0f;
-	for (int i = 0; i < MAX_ROUNDS; i++)
-	{
-		sum = sum + m_Rounds[i].DeadFromHungerPercent;
-	}
-	return sum / (float)MAX_ROUNDS;
+	// Как и прежде, несыгранные раунды обычной партии считаются нулевыми
+	uint32_t divisor = std::max<uint32_t>(m_Rounds, (uint32_t)MAX_ROUNDS);
+	return EconomyFixed::FromRaw(m_Sum / divisor);
 }
 
-int32_t GameStatistics::CalculateAcresPerPerson(uint32_t area, uint32_t population) const
+int32_t GameStatistics::CalculateAcresPerPerson(Quantity area, Quantity population) const
 {
 	if (population == 0)
 		return 0;
@@ -42,18 +113,170 @@ int32_t GameStatistics::CalculateAcresPerPerson(uint32_t area, uint32_t populati
 	return result;
 }
 
-GameStatistics::Rating GameStatistics::GetRating(uint32_t area, uint32_t population) const
+uint32_t GameStatistics::GetRecordedRounds() const
+{
+	return m_Rounds;
+}
+
+EconomyFixed GameStatistics::GetMinDeadFromHunger() const
+{
+	return m_Min;
+}
+
+EconomyFixed GameStatistics::GetMaxDeadFromHunger() const
 {
-	float averageDead = CalculateAverageDeadFromHunger();
+	return m_Max;
+}
+
+EconomyFixed GameStatistics::GetRecentDeadFromHunger() const
+{
+	return m_Recent;
+}
+
+double GameStatistics::GetDeadFromHungerVariance() const
+{
+	if (m_Rounds == 0)
+		return 0.0;
+	
+	// Суммы целые и точные, поэтому вычитание в конце не теряет точность
+	double rounds = (double)m_Rounds;
+	double mean = (double)m_Sum / rounds;
+	double variance = (double)m_SumSquares / rounds - mean * mean;
+	double one = (double)EconomyFixed::ONE_RAW;
+	return std::max(variance, 0.0) / (one * one);
+}
+
+void GameStatistics::WriteAggregates(std::ostream& stream) const
+{
+	stream << m_Rounds << ' ' << m_Sum << ' ' << m_SumSquares << ' '
+		<< m_Min.GetRaw() << ' ' << m_Max.GetRaw() << ' '
+		<< m_Recent.GetRaw() << ' ' << m_RecentBefore.GetRaw() << '\n';
+	
+	uint32_t stored = std::min<uint32_t>(m_Rounds, (uint32_t)HISTORY_ROUNDS);
+	for (uint32_t round = m_Rounds - stored + 1; round <= m_Rounds; round++)
+	{
+		stream << m_History[(round - 1) % HISTORY_ROUNDS].DeadFromHungerPercent.GetRaw() << ' ';
+	}
+	stream << '\n';
+	stream << m_EvictedMin.GetRaw() << ' ' << m_EvictedMax.GetRaw() << '\n';
+}
+
+bool GameStatistics::ReadAggregates(std::istream& stream)
+{
+	GameStatistics loaded;
+	int64_t minRaw = 0;
+	int64_t maxRaw = 0;
+	int64_t recentRaw = 0;
+	int64_t recentBeforeRaw = 0;
+	if (!(stream >> loaded.m_Rounds >> loaded.m_Sum >> loaded.m_SumSquares >> minRaw >> maxRaw >> recentRaw >> recentBeforeRaw))
+		return false;
+	
+	loaded.m_Min = EconomyFixed::FromRaw(minRaw);
+	loaded.m_Max = EconomyFixed::FromRaw(maxRaw);
+	loaded.m_Recent = EconomyFixed::FromRaw(recentRaw);
+	loaded.m_RecentBefore = EconomyFixed::FromRaw(recentBeforeRaw);
+	
+	uint32_t stored = std::min<uint32_t>(loaded.m_Rounds, (uint32_t)HISTORY_ROUNDS);
+	for (uint32_t round = loaded.m_Rounds - stored + 1; round <= loaded.m_Rounds; round++)
+	{
+		int64_t raw = 0;
+		if (!(stream >> raw))
+			return false;
+		loaded.m_History[(round - 1) % HISTORY_ROUNDS].DeadFromHungerPercent = EconomyFixed::FromRaw(raw);
+	}
+	
+	// Без крайних вытесненных долей (сохранение прежней версии) границами остаются
+	// общие минимум и максимум: перезапись их лишь не сузит
+	int64_t evictedMinRaw = minRaw;
+	int64_t evictedMaxRaw = maxRaw;
+	if (!(stream >> evictedMinRaw >> evictedMaxRaw))
+	{
+		evictedMinRaw = minRaw;
+		evictedMaxRaw = maxRaw;
+	}
+	loaded.m_EvictedMin = EconomyFixed::FromRaw(evictedMinRaw);
+	loaded.m_EvictedMax = EconomyFixed::FromRaw(evictedMaxRaw);
+	
+	*this = loaded;
+	return true;
+}
+
+GameStatistics::Rating GameStatistics::GetRating(Quantity area, Quantity population) const
+{
+	constexpr EconomyFixed POOR_DEAD = EconomyFixed::FromFloat(0.33f);
+	constexpr EconomyFixed FAIR_DEAD = EconomyFixed::FromFloat(0.1f);
+	constexpr EconomyFixed GOOD_DEAD = EconomyFixed::FromFloat(0.03f);
+	
+	EconomyFixed averageDead = CalculateAverageDeadFromHunger();
 	int32_t acresPerPerson = CalculateAcresPerPerson(area, population);
 	
-	if (averageDead > 0.33f && acresPerPerson < 7)
+	if (averageDead > POOR_DEAD && acresPerPerson < 7)
 		return Rating::Poor;
-	else if (averageDead > 0.1f && acresPerPerson < 9)
+	else if (averageDead > FAIR_DEAD && acresPerPerson < 9)
 		return Rating::Fair;
-	else if (averageDead > 0.03f && acresPerPerson < 10)
+	else if (averageDead > GOOD_DEAD && acresPerPerson < 10)
 		return Rating::Good;
 	else
 		return Rating::Excellent;
 }
 
+bool GameStatistics::IsInHistory(uint32_t round) const
+{
+	return round > 0 && round <= m_Rounds && m_Rounds - round < HISTORY_ROUNDS;
+}
+
+void GameStatistics::AppendRound(EconomyFixed deadFromHungerPercent)
+{
+	// Раунд m_Rounds + 1 - HISTORY_ROUNDS уходит из буфера на место нового
+	RoundStatistics& slot = m_History[m_Rounds % HISTORY_ROUNDS];
+	if (m_Rounds == HISTORY_ROUNDS)
+	{
+		m_EvictedMin = slot.DeadFromHungerPercent;
+		m_EvictedMax = slot.DeadFromHungerPercent;
+	}
+	else if (m_Rounds > HISTORY_ROUNDS)
+	{
+		m_EvictedMin = std::min(m_EvictedMin, slot.DeadFromHungerPercent);
+		m_EvictedMax = std::max(m_EvictedMax, slot.DeadFromHungerPercent);
+	}
+	
+	m_Rounds++;
+	slot.DeadFromHungerPercent = deadFromHungerPercent;
+	
+	int64_t raw = deadFromHungerPercent.GetRaw();
+	m_Sum += raw;
+	m_SumSquares += (uint64_t)(raw * raw);
+	
+	m_RecentBefore = m_Recent;
+	if (m_Rounds == 1)
+	{
+		m_Min = deadFromHungerPercent;
+		m_Max = deadFromHungerPercent;
+		m_Recent = deadFromHungerPercent;
+		return;
+	}
+	
+	m_Min = std::min(m_Min, deadFromHungerPercent);
+	m_Max = std::max(m_Max, deadFromHungerPercent);
+	m_Recent = Smooth(m_Recent, deadFromHungerPercent);
+}
+
+void GameStatistics::RecalculateBounds()
+{
+	uint32_t stored = std::min<uint32_t>(m_Rounds, (uint32_t)HISTORY_ROUNDS);
+	uint32_t first = m_Rounds - stored + 1;
+	m_Min = m_History[(first - 1) % HISTORY_ROUNDS].DeadFromHungerPercent;
+	m_Max = m_Min;
+	for (uint32_t round = first + 1; round <= m_Rounds; round++)
+	{
+		EconomyFixed value = m_History[(round - 1) % HISTORY_ROUNDS].DeadFromHungerPercent;
+		m_Min = std::min(m_Min, value);
+		m_Max = std::max(m_Max, value);
+	}
+	
+	if (m_Rounds > HISTORY_ROUNDS)
+	{
+		m_Min = std::min(m_Min, m_EvictedMin);
+		m_Max = std::max(m_Max, m_EvictedMax);
+	}
+}
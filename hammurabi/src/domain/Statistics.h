@@ -1,25 +1,50 @@
 #pragma once
 
+#include "../config/GameConfig.h"
+#include "Quantity.h"
 #include <cstdint>
 #include <array>
+#include <iosfwd>
 
 // Статистика одного раунда
 struct RoundStatistics
 {
-	float DeadFromHungerPercent;
-	RoundStatistics() : DeadFromHungerPercent(0.0f) {}
+	EconomyFixed DeadFromHungerPercent;    // Доля умерших от голода
+	RoundStatistics() : DeadFromHungerPercent() {}
 };
 
+// Статистика партии любой длины.
+// Последние HISTORY_ROUNDS раундов хранятся поштучно в кольцевом буфере,
+// по всем раундам ведутся сводные величины: сумма и сумма квадратов долей
+// (целые, в единицах EconomyFixed), минимум, максимум и экспоненциальное
+// среднее последних раундов. Запись раунда и оценка правления - O(1);
+// перезапись раунда, бывшего минимумом или максимумом, пересчитывает их
+// по буферу и крайним значениям уже вытесненных раундов - O(HISTORY_ROUNDS).
 class GameStatistics
 {
 public:
-	static constexpr size_t MAX_ROUNDS = 10;
+	static constexpr size_t MAX_ROUNDS = 10;    // Средняя для оценки делится не меньше чем на столько раундов
+	static constexpr size_t HISTORY_ROUNDS = GameConfig::Game::STATS_HISTORY_ROUNDS;
 	
 	GameStatistics();
-	void SetRoundStatistics(uint32_t round, float deadFromHungerPercent);
+	// Раунды пишутся по порядку; пропущенные считаются нулевыми.
+	// Повторная запись раунда из буфера исправляет суммы точно.
+	void SetRoundStatistics(uint32_t round, EconomyFixed deadFromHungerPercent);
+	// Раунд вне буфера (слишком старый или еще не сыгранный) - нулевой
 	RoundStatistics GetRoundStatistics(uint32_t round) const;
-	float CalculateAverageDeadFromHunger() const;
-	int32_t CalculateAcresPerPerson(uint32_t area, uint32_t population) const;
+	EconomyFixed CalculateAverageDeadFromHunger() const;
+	int32_t CalculateAcresPerPerson(Quantity area, Quantity population) const;
+	
+	uint32_t GetRecordedRounds() const;
+	EconomyFixed GetMinDeadFromHunger() const;
+	EconomyFixed GetMaxDeadFromHunger() const;
+	EconomyFixed GetRecentDeadFromHunger() const;
+	double GetDeadFromHungerVariance() const;
+	
+	// Сводные величины и буфер для сохранения; false - в потоке их нет (старый формат)
+	void WriteAggregates(std::ostream& stream) const;
+	bool ReadAggregates(std::istream& stream);
+	
 	enum class Rating
 	{
 		Poor,           // Плохо
@@ -28,9 +53,22 @@ public:
 		Excellent       // Отлично
 	};
 	
-	Rating GetRating(uint32_t area, uint32_t population) const;
+	Rating GetRating(Quantity area, Quantity population) const;
 
 private:
-	std::array<RoundStatistics, MAX_ROUNDS> m_Rounds;
-};
+	bool IsInHistory(uint32_t round) const;
+	void AppendRound(EconomyFixed deadFromHungerPercent);
+	void RecalculateBounds();
 
+private:
+	std::array<RoundStatistics, HISTORY_ROUNDS> m_History;    // Раунд r лежит в (r - 1) % HISTORY_ROUNDS
+	uint32_t m_Rounds;              // Последний записанный раунд
+	int64_t m_Sum;                  // Сумма долей, raw EconomyFixed
+	uint64_t m_SumSquares;          // Сумма квадратов raw
+	EconomyFixed m_Min;
+	EconomyFixed m_Max;
+	EconomyFixed m_EvictedMin;      // Крайние доли раундов, вытесненных из буфера
+	EconomyFixed m_EvictedMax;      // (есть, только если m_Rounds > HISTORY_ROUNDS)
+	EconomyFixed m_Recent;          // Экспоненциальное среднее с последним раундом
+	EconomyFixed m_RecentBefore;    // То же до последнего раунда - для его перезаписи
+};
@@ -1,33 +1,508 @@
 #include "services/GameEngine.h"
+#include "services/ArtCache.h"
+#include "services/EmpireSimulation.h"
+#include "services/GameReplay.h"
+#include "services/GameServer.h"
+#include "services/Leaderboard.h"
+#include "services/LoadGenerator.h"
+#include "services/OutcomeQuery.h"
+#include "services/RuleSweep.h"
+#include "services/StatePublisher.h"
+#include "services/VecEnv.h"
 #include "utils/utility.h"
+#include "utils/Profiler.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <iomanip>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
 #include <windows.h>
+#endif
 
-int main()
+namespace
 {
-	SetConsoleOutputCP(65001);
-	SetConsoleCP(65001);
+	// Адрес вида "unix:/path/to/socket" или номер TCP-порта
+	bool ParseEndpoint(const std::string& endpoint, std::string& unixPath, uint16_t& port)
+	{
+		const std::string unixPrefix = "unix:";
+		if (endpoint.compare(0, unixPrefix.size(), unixPrefix) == 0)
+		{
+			unixPath = endpoint.substr(unixPrefix.size());
+			port = 0;
+			return !unixPath.empty();
+		}
+		
+		int32_t value = 0;
+		if (!TryParseInteger(endpoint, value) || value <= 0 || value > 65535)
+			return false;
+		port = (uint16_t)value;
+		return true;
+	}
+	
+	uint32_t ParseCount(int argc, char* argv[], int index, uint32_t defaultValue)
+	{
+		int32_t value = 0;
+		if (index >= argc || !TryParseInteger(argv[index], value) || value < 0)
+			return defaultValue;
+		return (uint32_t)value;
+	}
+	
+	bool s_LeaderboardStarted = false;
+	
+	// Режимы, где партии доигрываются, продолжают таблицу лучших с прошлого снимка
+	void StartLeaderboard()
+	{
+		Leaderboard& leaderboard = Leaderboard::Instance();
+		leaderboard.LoadSnapshot(GameConfig::Paths::LEADERBOARD);
+		leaderboard.StartSnapshots(GameConfig::Paths::LEADERBOARD, std::chrono::seconds(GameConfig::Leaderboard::SNAPSHOT_SECONDS));
+		s_LeaderboardStarted = true;
+	}
+	
+	const char* GetOutcomeName(OutcomeClass outcome)
+	{
+		switch (outcome)
+		{
+		case OutcomeClass::Overthrown:
+			return "свергнут";
+		case OutcomeClass::Poor:
+			return "плохо";
+		case OutcomeClass::Fair:
+			return "удовлетворительно";
+		case OutcomeClass::Good:
+			return "хорошо";
+		case OutcomeClass::Excellent:
+		default:
+			return "отлично";
+		}
+	}
+	
+	// hammurabi --leaderboard [k] - лучшие партии из последнего снимка
+	int RunLeaderboard(int argc, char* argv[])
+	{
+		Leaderboard& leaderboard = Leaderboard::Instance();
+		if (!leaderboard.LoadSnapshot(GameConfig::Paths::LEADERBOARD))
+		{
+			std::cout << "Снимок таблицы лучших не найден: " << GameConfig::Paths::LEADERBOARD.string() << "\n";
+			return 1;
+		}
+		
+		std::vector<LeaderboardEntry> top;
+		leaderboard.GetTop(ParseCount(argc, argv, 2, 10), top);
+		
+		std::cout << "Партий: " << leaderboard.GetGameCount() << "\n";
+		for (size_t i = 0; i < top.size(); i++)
+		{
+			const LeaderboardEntry& entry = top[i];
+			std::cout << i + 1 << ". " << GetOutcomeName(Leaderboard::GetOutcomeClass(entry.Score))
+				<< ", жителей " << entry.Population << ", акров " << entry.Area
+				<< ", умирало от голода " << entry.AverageDead.ToFloat() * 100.0f << "%"
+				<< ", партия #" << entry.GameId << "\n";
+		}
+		return 0;
+	}
+	
+	// hammurabi --server <порт|unix:путь> [потоков]
+	int RunServer(int argc, char* argv[])
+	{
+		ServerConfig config{};
+		if (argc < 3 || !ParseEndpoint(argv[2], config.UnixSocketPath, config.Port))
+		{
+			std::cout << "Использование: hammurabi --server <порт|unix:путь> [потоков]\n";
+			return 1;
+		}
+		config.WorkerCount = ParseCount(argc, argv, 3, 0);
+		
+		StartLeaderboard();
+		GameServer server(config);
+		return server.Run() ? 0 : 1;
+	}
+	
+	// hammurabi --loadgen <порт|unix:путь> <сессий> <секунд> [ядер сервера]
+	int RunLoadGenerator(int argc, char* argv[])
+	{
+		LoadGeneratorConfig config{};
+		if (argc < 5 || !ParseEndpoint(argv[2], config.UnixSocketPath, config.Port))
+		{
+			std::cout << "Использование: hammurabi --loadgen <порт|unix:путь> <сессий> <секунд> [ядер сервера]\n";
+			return 1;
+		}
+		config.Sessions = ParseCount(argc, argv, 3, 100);
+		config.DurationSeconds = ParseCount(argc, argv, 4, 10);
+		config.ServerCores = ParseCount(argc, argv, 5, 1);
+		
+		LoadGenerator generator(config);
+		return generator.Run() ? 0 : 1;
+	}
+	
+	// hammurabi --sweep <задание> <результат.csv>
+	int RunSweep(int argc, char* argv[])
+	{
+		SweepConfig config;
+		if (argc < 4 || !config.LoadFromFile(argv[2]))
+		{
+			std::cout << "Использование: hammurabi --sweep <задание> <результат.csv>\n";
+			return 1;
+		}
+		
+		RuleSweep sweep(config);
+		return sweep.Run(argv[3]) ? 0 : 1;
+	}
+	
+	// hammurabi --query <каталог> <запрос> - агрегаты по хранилищу исходов (см. OutcomeQuery)
+	int RunQuery(int argc, char* argv[])
+	{
+		OutcomeQuery query;
+		std::vector<std::string> words(argv + std::min(argc, 3), argv + argc);
+		if (argc < 4 || !query.Parse(words))
+		{
+			std::cout << "Использование: hammurabi --query <каталог> <count|sum|mean|min|max> [столбец] [by столбец] [where условие {and условие}]\n";
+			return 1;
+		}
+		
+		OutcomeStore store;
+		if (!store.Open(argv[2]))
+		{
+			std::cout << "Не удалось открыть хранилище исходов " << argv[2] << "\n";
+			return 1;
+		}
+		
+		OutcomeQueryEngine engine(store);
+		QueryResult result;
+		engine.Run(query, result);
+		
+		std::cout << std::setprecision(12);
+		for (const QueryGroup& group : result.Groups)
+		{
+			if (query.Grouped)
+				std::cout << GetOutcomeColumnName(query.GroupBy) << ' ' << OutcomeQueryEngine::ToColumnUnits(query.GroupBy, group.Key) << ": ";
+			std::cout << OutcomeQueryEngine::GetValue(query, group) << " (строк: " << group.Count << ")\n";
+		}
+		if (result.Groups.empty())
+			std::cout << "Подходящих строк нет\n";
+		
+		double gigabytes = (double)result.BytesScanned / 1e9;
+		std::cout << "Строк: " << result.RowsScanned << " из " << store.GetRowCount()
+			<< ", подошло: " << result.RowsMatched
+			<< ", сегментов пропущено: " << result.SegmentsSkipped
+			<< ", время: " << result.Seconds << " с, "
+			<< (result.Seconds > 0.0 ? gigabytes / result.Seconds : 0.0) << " ГБ/с\n";
+		return 0;
+	}
+	
+	// hammurabi --monitor <pid> [период мс] - состояние идущей партии другого процесса.
+	// Печатает каждую новую публикацию, пока игра не завершится.
+	int RunMonitor(int argc, char* argv[])
+	{
+		int32_t processId = 0;
+		if (argc < 3 || !TryParseInteger(argv[2], processId) || processId <= 0)
+		{
+			std::cout << "Использование: hammurabi --monitor <pid> [период мс]\n";
+			return 1;
+		}
+		uint32_t period = ParseCount(argc, argv, 3, GameConfig::Monitor::POLL_MILLISECONDS);
+		
+		uint64_t shownUpdates = 0;
+		while (true)
+		{
+			// Игра удаляет память при выходе, поэтому она открывается заново каждый раз
+			StateMonitor monitor;
+			if (!monitor.Open((uint32_t)processId))
+			{
+				std::cout << (shownUpdates == 0 ? "Нет партии с таким pid\n" : "Игра завершилась\n");
+				return shownUpdates == 0 ? 1 : 0;
+			}
+			
+			MonitorSnapshot snapshot{};
+			if (monitor.Read(snapshot) && snapshot.Updates != shownUpdates)
+			{
+				const CityState& state = snapshot.State;
+				std::cout << "Раунд " << state.Round << ", " << GetProfilePhaseName(snapshot.Phase)
+					<< ": население " << state.Population
+					<< ", акров " << state.Area
+					<< ", пшеницы " << state.WheatReserves
+					<< ", цена акра " << state.AcrePrice
+					<< ", умерло " << state.DeadFromHunger
+					<< " (" << snapshot.Statistics.DeadFromHungerPercent.ToFloat() * 100.0f << "%)"
+					<< (state.HasPlague ? ", чума" : "") << "\n";
+				shownUpdates = snapshot.Updates;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(period));
+		}
+	}
+	
+	// hammurabi --empire <городов> [потоков] [зерно]
+	// hammurabi --empire scaling [макс. потоков] [зерно]
+	int RunEmpire(int argc, char* argv[])
+	{
+		if (argc < 3)
+		{
+			std::cout << "Использование: hammurabi --empire <городов|scaling> [потоков] [зерно]\n";
+			return 1;
+		}
+		
+		uint32_t threads = ParseCount(argc, argv, 3, 0);
+		uint32_t seed = ParseCount(argc, argv, 4, 1);
+		if (std::string(argv[2]) == "scaling")
+		{
+			RunEmpireScaling(threads, seed);
+			return 0;
+		}
+		
+		EmpireConfig config{ParseCount(argc, argv, 2, 0), seed, threads, ScriptedStrategy::LandTrader};
+		if (config.Cities == 0)
+		{
+			std::cout << "Число городов должно быть положительным\n";
+			return 1;
+		}
+		
+		EmpireSimulation empire(config);
+		std::cout << "Городов: " << empire.GetCities().size() << ", потоков: " << empire.GetThreadCount() << "\n";
+		
+		auto started = std::chrono::steady_clock::now();
+		while (!empire.IsCompleted())
+		{
+			empire.PlayRound();
+			
+			const EmpireSummary& summary = empire.GetSummary();
+			std::cout << "Раунд " << summary.Round - 1
+				<< ": городов " << summary.ActiveCities
+				<< ", население " << summary.Population
+				<< ", акров " << summary.Area
+				<< ", пшеницы " << summary.WheatReserves
+				<< ", продано акров " << summary.AcresTraded
+				<< ", отправлено пшеницы " << summary.WheatShipped << "\n";
+		}
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+		
+		std::cout << "Время: " << seconds << " с, контрольная сумма: " << std::hex << empire.GetChecksum() << std::dec << "\n";
+		return 0;
+	}
 	
-	static bool firstRun = true;
+	// hammurabi --vecenv <сред> <шагов> [потоков] [зерно] - замер скорости пакетной среды
+	int RunVecEnv(int argc, char* argv[])
+	{
+		VecEnvConfig config{ParseCount(argc, argv, 2, 0), ParseCount(argc, argv, 5, 1), ParseCount(argc, argv, 4, 0)};
+		uint32_t steps = ParseCount(argc, argv, 3, 0);
+		if (argc < 4 || config.Envs == 0 || steps == 0)
+		{
+			std::cout << "Использование: hammurabi --vecenv <сред> <шагов> [потоков] [зерно]\n";
+			return 1;
+		}
+		
+		VecEnv env(config);
+		std::vector<PlayerDecisions> actions(config.Envs);
+		std::vector<float> observations(config.Envs * VecEnv::OBSERVATION_SIZE);
+		std::vector<float> rewards(config.Envs);
+		std::vector<uint8_t> dones(config.Envs);
+		env.Reset(observations.data());
+		
+		// Агент-заглушка: кормит всех и засевает всю землю, остальное обрежут границы
+		double seconds = 0.0;
+		double rewardSum = 0.0;
+		for (uint32_t step = 0; step < steps; step++)
+		{
+			for (size_t i = 0; i < actions.size(); i++)
+			{
+				const float* observation = observations.data() + i * VecEnv::OBSERVATION_SIZE;
+				float population = observation[(size_t)VecEnvObservation::Population];
+				actions[i] = PlayerDecisions{0, 0, (int32_t)(population * GameConfig::Game::WHEAT_PER_PERSON),
+					(int32_t)observation[(size_t)VecEnvObservation::Area]};
+			}
+			
+			auto started = std::chrono::steady_clock::now();
+			env.Step(actions.data(), observations.data(), rewards.data(), dones.data());
+			seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+			
+			for (float reward : rewards)
+			{
+				rewardSum += reward;
+			}
+		}
+		
+		double total = (double)steps * config.Envs;
+		std::cout << "Сред: " << config.Envs << ", потоков: " << env.GetThreadCount()
+			<< ", шагов: " << total << ", партий: " << env.GetEpisodeCount()
+			<< ", средняя награда за партию: " << rewardSum / (double)std::max<uint64_t>(env.GetEpisodeCount(), 1)
+			<< "\nВремя в Step: " << seconds << " с, шагов в секунду: " << (seconds > 0.0 ? total / seconds : 0.0) << "\n";
+		return 0;
+	}
 	
-	do
+	// hammurabi --script <файл|-> - партии подряд по ответам из файла или канала.
+	// Ответы проходят те же проверки Validate*, что и с консоли; экраны идут
+	// в stdout, итог - в stderr, чтобы вывод игры можно было отбросить.
+	int RunScript(int argc, char* argv[])
 	{
+		ScriptedInput script;
+		if (argc < 3 || !script.Open(argv[2]))
+		{
+			std::cout << "Использование: hammurabi --script <файл|->\n";
+			return 1;
+		}
+		
+		ArtCache::Instance();
+		StartLeaderboard();
+		
+		StatePublisher publisher;
+		publisher.Open();
+		
+		uint32_t games = 0;
+		auto started = std::chrono::steady_clock::now();
 		GameEngine engine;
+		engine.SetScript(&script);
+		engine.SetPublisher(&publisher);
+		while (!script.IsExhausted())
+		{
+			engine.Reset(SplitMix64::MakeSeed(SplitMix64::GetProcessSeed(), games));
+			engine.Run();
+			games++;
+		}
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+		
+		std::cerr << "Партий: " << games << ", ответов: " << script.GetTokenCount()
+			<< ", время: " << seconds << " с, ответов в секунду: "
+			<< (seconds > 0.0 ? (double)script.GetTokenCount() / seconds : 0.0) << "\n";
+		return 0;
+	}
+	
+	// hammurabi --replay <журнал> - состояние города после каждого записанного раунда.
+	// Правила берутся из заголовка журнала, так что партии с --rules повторяются верно.
+	int RunReplay(int argc, char* argv[])
+	{
+		BasicGameReplay<RuntimeRules> replay;
+		if (argc < 3 || !replay.Load(argv[2]))
+		{
+			std::cout << "Не удалось прочитать журнал. Использование: hammurabi --replay <журнал>\n";
+			return 1;
+		}
+		
+		if (replay.GetRoundCount() == 0)
+		{
+			std::cout << "В журнале нет сыгранных раундов\n";
+			return 0;
+		}
 		
-	if (firstRun)
+		CityState state;
+		for (uint32_t round = replay.GetFirstRound(); round <= replay.GetLastRound(); round++)
+		{
+			if (!replay.GetStateAfterRound(round, state))
+			{
+				std::cout << "Раунд " << round << ": не удалось восстановить\n";
+				return 1;
+			}
+			std::cout << "Раунд " << round
+				<< ": население " << state.Population
+				<< ", акров " << state.Area
+				<< ", пшеницы " << state.WheatReserves
+				<< ", умерло от голода " << state.DeadFromHunger
+				<< (state.HasPlague ? ", чума" : "") << "\n";
+		}
+		return 0;
+	}
+	
+	template<typename Rules>
+	int RunInteractive(const Rules& rules)
 	{
-			engine.ShowMainScreen();
-		firstRun = false;
+#ifdef _WIN32
+		SetConsoleOutputCP(65001);
+		SetConsoleCP(65001);
+		
+		// Экран очищается и перерисовывается ANSI-последовательностями
+		HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+		DWORD consoleMode = 0;
+		if (GetConsoleMode(console, &consoleMode))
+			SetConsoleMode(console, consoleMode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+#endif
+		
+		// Экраны загружаются один раз до начала игры
+		ArtCache::Instance();
+		StartLeaderboard();
+		
+		// Состояние видно из другого процесса: hammurabi --monitor <pid>
+		StatePublisher publisher;
+		publisher.Open();
+		
+		// Движок один на все партии: новая игра начинается сбросом
+		AutoSaver autoSaver;
+		BasicGameEngine<Rules> engine(rules);
+		engine.SetPublisher(&publisher);
+		engine.SetAutoSaver(&autoSaver);
+		engine.SetJournaling(true);
+		engine.ShowMainScreen();
+		
+		// Первая партия идет на зерне из конструктора движка, следующие - на своих
+		uint64_t games = 0;
+		while (true)
+		{
+			engine.Run();
+			
+			ClearScreen();
+			std::cout << "\n\n";
+			std::cout << std::setw(60) << std::setfill(' ') << "Хотите сыграть снова? Y/N\n";
+			if (!ProcessOneshotInput())
+				break;
+			
+			engine.Reset(SplitMix64::MakeSeed(SplitMix64::GetProcessSeed(), ++games));
+		}
+		
+		return 0;
 	}
 	
-		engine.Run();
-
-		system("cls");
-		std::cout << "\n\n";
-		std::cout << std::setw(60) << std::setfill(' ') << "Хотите сыграть снова? Y/N\n";
+	int RunMode(int argc, char* argv[])
+	{
+		std::string mode = argc > 1 ? argv[1] : "";
+		
+		if (mode == "--server")
+			return RunServer(argc, argv);
+		if (mode == "--loadgen")
+			return RunLoadGenerator(argc, argv);
+		if (mode == "--sweep")
+			return RunSweep(argc, argv);
+		if (mode == "--empire")
+			return RunEmpire(argc, argv);
+		if (mode == "--vecenv")
+			return RunVecEnv(argc, argv);
+		if (mode == "--script")
+			return RunScript(argc, argv);
+		if (mode == "--leaderboard")
+			return RunLeaderboard(argc, argv);
+		if (mode == "--query")
+			return RunQuery(argc, argv);
+		if (mode == "--monitor")
+			return RunMonitor(argc, argv);
+		if (mode == "--replay")
+			return RunReplay(argc, argv);
+		
+		// hammurabi --rules <файл> - партия по правилам из файла
+		if (mode == "--rules")
+		{
+			RuntimeRules rules;
+			if (argc < 3 || !rules.LoadFromFile(argv[2]))
+			{
+				std::cout << "Не удалось загрузить правила. Использование: hammurabi --rules <файл>\n";
+				return 1;
+			}
+			return RunInteractive(rules);
+		}
+		
+		return RunInteractive(DefaultRules{});
 	}
-	while (ProcessOneshotInput());
+}
+
+int main(int argc, char* argv[])
+{
+	int result = RunMode(argc, argv);
+	
+	// Последний снимок пишется до выхода из main, пока живы все статические объекты
+	if (s_LeaderboardStarted)
+		Leaderboard::Instance().StopSnapshots();
+	
+#ifdef HAMMURABI_PROFILE
+	// Трасса открывается в chrome://tracing или ui.perfetto.dev
+	Profiler::Instance().Export(GameConfig::Paths::PROFILE_TRACE, GameConfig::Paths::PROFILE_SUMMARY);
+#endif
 	
-	return 0;
+	return result;
 }
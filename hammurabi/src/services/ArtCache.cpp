@@ -0,0 +1,66 @@
+#include "ArtCache.h"
+#include "../config/GameConfig.h"
+#include "../utils/utility.h"
+
+ArtAsset::ArtAsset()
+	: m_MaxWidth(0)
+{
+}
+
+bool ArtAsset::LoadFromFile(const std::filesystem::path& filePath)
+{
+	m_Lines.clear();
+	m_MaxWidth = 0;
+
+	if (!LoadFileContent(filePath, m_Buffer))
+	{
+		m_Buffer.clear();
+		return false;
+	}
+
+	SplitLines(m_Buffer, m_Lines);
+	for (size_t i = 0; i < m_Lines.size(); i++)
+	{
+		if (m_Lines[i].length() > m_MaxWidth)
+			m_MaxWidth = m_Lines[i].length();
+	}
+	return true;
+}
+
+const std::vector<std::string_view>& ArtAsset::GetLines() const
+{
+	return m_Lines;
+}
+
+size_t ArtAsset::GetMaxWidth() const
+{
+	return m_MaxWidth;
+}
+
+const ArtCache& ArtCache::Instance()
+{
+	static const ArtCache cache;
+	return cache;
+}
+
+ArtCache::ArtCache()
+{
+	m_MainScreen.LoadFromFile(GameConfig::Paths::MAIN_SCREEN);
+	m_Advisor.LoadFromFile(GameConfig::Paths::ADVISOR_ART);
+	m_Rat.LoadFromFile(GameConfig::Paths::RAT_ART);
+}
+
+const ArtAsset& ArtCache::GetMainScreen() const
+{
+	return m_MainScreen;
+}
+
+const ArtAsset& ArtCache::GetAdvisor() const
+{
+	return m_Advisor;
+}
+
+const ArtAsset& ArtCache::GetRat() const
+{
+	return m_Rat;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ASCII-арт в одном буфере: строки - это string_view поверх него
+class ArtAsset
+{
+public:
+	ArtAsset();
+	ArtAsset(const ArtAsset&) = delete;
+	ArtAsset& operator=(const ArtAsset&) = delete;
+
+	bool LoadFromFile(const std::filesystem::path& filePath);
+	const std::vector<std::string_view>& GetLines() const;
+	size_t GetMaxWidth() const;
+
+private:
+	std::string m_Buffer;
+	std::vector<std::string_view> m_Lines;
+	size_t m_MaxWidth;
+};
+
+// Кэш экранов из ./Screens/: файлы читаются один раз за процесс,
+// дальше отрисовка раунда обходится без файлового ввода-вывода
+class ArtCache
+{
+public:
+	static const ArtCache& Instance();
+
+	const ArtAsset& GetMainScreen() const;
+	const ArtAsset& GetAdvisor() const;
+	const ArtAsset& GetRat() const;
+
+private:
+	ArtCache();
+
+private:
+	ArtAsset m_MainScreen;
+	ArtAsset m_Advisor;
+	ArtAsset m_Rat;
+};
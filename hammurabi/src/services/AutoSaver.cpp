@@ -0,0 +1,91 @@
+#include "AutoSaver.h"
+#include <utility>
+
+AutoSaver::AutoSaver()
+	: AutoSaver(nullptr)
+{
+}
+
+AutoSaver::AutoSaver(Writer writer)
+	: m_HasPending(false),
+	m_Stopping(false),
+	m_WrittenCount(0),
+	m_CoalescedCount(0),
+	m_Write(std::move(writer))
+{
+	if (!m_Write)
+	{
+		m_Write = [this](const GameSnapshot& snapshot)
+		{
+			return m_SaveManager.SaveAutosave(snapshot.State, snapshot.Stats);
+		};
+	}
+}
+
+AutoSaver::~AutoSaver()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stopping = true;
+	}
+	m_Wakeup.notify_one();
+
+	// Поток дописывает последний снимок перед выходом
+	if (m_Writer.joinable())
+		m_Writer.join();
+}
+
+void AutoSaver::Submit(const CityState& state, const GameStatistics& stats)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		if (m_HasPending)
+			m_CoalescedCount++;
+
+		m_Pending.State = state;
+		m_Pending.Stats = stats;
+		m_HasPending = true;
+
+		if (!m_Writer.joinable())
+			m_Writer = std::thread(&AutoSaver::WriterLoop, this);
+	}
+	m_Wakeup.notify_one();
+}
+
+uint64_t AutoSaver::GetWrittenCount() const
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_WrittenCount;
+}
+
+uint64_t AutoSaver::GetCoalescedCount() const
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_CoalescedCount;
+}
+
+void AutoSaver::WriterLoop()
+{
+	GameSnapshot snapshot;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Wakeup.wait(lock, [this] { return m_HasPending || m_Stopping; });
+
+			if (!m_HasPending)
+				return;
+
+			snapshot = m_Pending;
+			m_HasPending = false;
+		}
+
+		// Запись идет без блокировки: Submit в это время только обновляет слот
+		bool saved = m_Write(snapshot);
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		if (saved)
+			m_WrittenCount++;
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "../domain/CityState.h"
+#include "../domain/Statistics.h"
+#include "SaveManager.h"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Снимок игры для автосохранения (копия по значению)
+struct GameSnapshot
+{
+	CityState State;
+	GameStatistics Stats;
+};
+
+// Фоновое автосохранение: раунд отдает снимок и сразу продолжает игру,
+// запись на диск выполняет отдельный поток.
+// Очередь ограничена одним слотом: новый снимок заменяет еще не записанный,
+// поэтому на диск всегда попадает самое свежее состояние.
+// Движок пишет автосохранение, только если ему отдали AutoSaver (SetAutoSaver):
+// одна интерактивная партия - один поток записи и один файл autosave.
+class AutoSaver
+{
+public:
+	// Запись снимка; по умолчанию - SaveManager::SaveAutosave
+	using Writer = std::function<bool(const GameSnapshot& snapshot)>;
+
+	AutoSaver();
+	explicit AutoSaver(Writer writer);
+	~AutoSaver();
+
+	AutoSaver(const AutoSaver&) = delete;
+	AutoSaver& operator=(const AutoSaver&) = delete;
+
+	void Submit(const CityState& state, const GameStatistics& stats);
+	uint64_t GetWrittenCount() const;
+	uint64_t GetCoalescedCount() const;
+
+private:
+	void WriterLoop();
+
+private:
+	mutable std::mutex m_Mutex;
+	std::condition_variable m_Wakeup;
+	GameSnapshot m_Pending;
+	bool m_HasPending;
+	bool m_Stopping;
+	uint64_t m_WrittenCount;      // Записано снимков
+	uint64_t m_CoalescedCount;    // Снимков, замененных более новыми до записи
+
+	SaveManager m_SaveManager;    // Используется только потоком записи
+	Writer m_Write;
+	std::thread m_Writer;         // Запускается при первом снимке
+};
@@ -0,0 +1,76 @@
+#include "DecisionTask.h"
+#include <exception>
+#include <utility>
+
+std::atomic<size_t> DecisionTask::s_FrameSize{ 0 };
+std::atomic<size_t> DecisionTask::s_LiveFrames{ 0 };
+
+void* DecisionTask::promise_type::operator new(std::size_t size)
+{
+	s_FrameSize.store(size, std::memory_order_relaxed);
+	s_LiveFrames.fetch_add(1, std::memory_order_relaxed);
+	return ::operator new(size);
+}
+
+void DecisionTask::promise_type::operator delete(void* frame, std::size_t size)
+{
+	s_LiveFrames.fetch_sub(1, std::memory_order_relaxed);
+	::operator delete(frame, size);
+}
+
+DecisionTask DecisionTask::promise_type::get_return_object()
+{
+	return DecisionTask(std::coroutine_handle<promise_type>::from_promise(*this));
+}
+
+void DecisionTask::promise_type::unhandled_exception()
+{
+	std::terminate();
+}
+
+DecisionTask::DecisionTask()
+	: m_Handle(nullptr)
+{
+}
+
+DecisionTask::DecisionTask(std::coroutine_handle<promise_type> handle)
+	: m_Handle(handle)
+{
+}
+
+DecisionTask::DecisionTask(DecisionTask&& other) noexcept
+	: m_Handle(std::exchange(other.m_Handle, nullptr))
+{
+}
+
+DecisionTask& DecisionTask::operator=(DecisionTask&& other) noexcept
+{
+	if (this != &other)
+	{
+		if (m_Handle)
+			m_Handle.destroy();
+		m_Handle = std::exchange(other.m_Handle, nullptr);
+	}
+	return *this;
+}
+
+DecisionTask::~DecisionTask()
+{
+	if (m_Handle)
+		m_Handle.destroy();
+}
+
+bool DecisionTask::IsDone() const
+{
+	return m_Handle && m_Handle.done();
+}
+
+size_t DecisionTask::GetFrameSize()
+{
+	return s_FrameSize.load(std::memory_order_relaxed);
+}
+
+size_t DecisionTask::GetLiveFrames()
+{
+	return s_LiveFrames.load(std::memory_order_relaxed);
+}
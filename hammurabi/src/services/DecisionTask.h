@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+
+// Корутина опроса игрока за один раунд. Запускается сразу и идет до первого
+// вопроса; после последнего ответа останавливается, чтобы IsDone() вернул true.
+// Кадр корутины выделяется через promise_type::operator new, который запоминает
+// его размер - это и есть память, занимаемая приостановленной партией.
+class DecisionTask
+{
+public:
+	struct promise_type
+	{
+		static void* operator new(std::size_t size);
+		static void operator delete(void* frame, std::size_t size);
+
+		DecisionTask get_return_object();
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_always final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception();
+	};
+
+	DecisionTask();
+	DecisionTask(DecisionTask&& other) noexcept;
+	DecisionTask& operator=(DecisionTask&& other) noexcept;
+	DecisionTask(const DecisionTask&) = delete;
+	DecisionTask& operator=(const DecisionTask&) = delete;
+	~DecisionTask();
+
+	bool IsDone() const;
+
+	static size_t GetFrameSize();
+	static size_t GetLiveFrames();
+
+private:
+	explicit DecisionTask(std::coroutine_handle<promise_type> handle);
+
+private:
+	std::coroutine_handle<promise_type> m_Handle;
+
+	static std::atomic<size_t> s_FrameSize;    // Размер последнего выделенного кадра
+	static std::atomic<size_t> s_LiveFrames;   // Кадров, живущих прямо сейчас
+};
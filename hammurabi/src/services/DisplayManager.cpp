@@ -2,21 +2,69 @@
 #include "../config/GameConfig.h"
 #include "../utils/utility.h"
 #include <iostream>
-#include <iomanip>
 #include <algorithm>
 #include <cstdint>
+#include <iterator>
+
+namespace
+{
+	// Полный отчет раунда с шестизначными числами - меньше 500 байт
+	constexpr size_t REPORT_RESERVE = 512;
+
+	// Строка отчета показывается, только если поле условия не ноль
+	struct ReportLineText
+	{
+		ReportField Condition;
+		std::string_view Text;
+	};
+
+	constexpr ReportLineText ROUND_REPORT[] = {
+		{ ReportField::None, "Мой повелитель, я хочу поведать тебе о {Round} годе твоего правления" },
+		{ ReportField::None, "" },
+		{ ReportField::DeadFromHunger, "{DeadFromHunger} человек умерло от голода." },
+		{ ReportField::NewPeople, "{NewPeople} человек прибыло в наш великий город" },
+		{ ReportField::HasPlague, "Наш город также постигла чума." },
+		{ ReportField::None, "Сейчас в городе {Population} жителей." },
+		{ ReportField::None, "" },
+		{ ReportField::None, "С каждого акра было собрано {WheatPerAcre} бушелей," },
+		{ ReportField::None, "а всего собрано {Harvested} бушелей." },
+		{ ReportField::None, "" },
+		{ ReportField::None, "Крысы съели {WheatEatenByRats} бушелей пшена!" },
+		{ ReportField::None, "" },
+		{ ReportField::None, "В запасах города осталось {WheatReserves} бушелей." },
+		{ ReportField::None, "" },
+		{ ReportField::None, "В этом году цена акра составляет {AcrePrice} бушелей пшена." }
+	};
+
+	struct CompiledReportLine
+	{
+		ReportField Condition;
+		ReportTemplate Template;
+	};
+
+	// Шаблоны разбираются один раз на процесс и дальше только читаются - в том числе из разных сессий
+	const std::vector<CompiledReportLine>& GetRoundReport()
+	{
+		static const std::vector<CompiledReportLine> report = [] {
+			std::vector<CompiledReportLine> lines;
+			for (const ReportLineText& line : ROUND_REPORT)
+			{
+				lines.push_back(CompiledReportLine{ line.Condition, ReportTemplate(line.Text) });
+			}
+			return lines;
+		}();
+		return report;
+	}
+}
 
 DisplayManager::DisplayManager()
+	: m_Art(ArtCache::Instance())
 {
 }
 
-void DisplayManager::ShowMainScreen() const
+void DisplayManager::ShowMainScreen()
 {
-	system("cls");
-	
-	std::vector<std::string> artLines = LoadMainScreenArt();
-	
-	std::vector<std::string> textLines = {
+	static const std::vector<std::string_view> textLines = {
 		"",
 		"═════════════════════════════════════════════════════════",
 		"               ПРАВИТЕЛЬ ЕГИПТА - ХАММУРАПИ",
@@ -30,51 +78,50 @@ void DisplayManager::ShowMainScreen() const
 		""
 	};
 	
-	PrintArtWithText(artLines, textLines);
+	PrintArtWithText(m_Art.GetMainScreen(), textLines);
 	ProcessOneshotInput(false);
 }
 
-void DisplayManager::ShowRoundStart(const CityState& state) const
+void DisplayManager::ShowRoundStart(const CityState& state)
 {
-	system("cls");
-	
-	std::vector<std::string> advisorArt;
-	if (state.HasPlague)
-	{
-		advisorArt = LoadRatArt();
-	}
-	else
-	{
-		advisorArt = LoadAdvisorArt();
-	}
+	ComposeRoundStart(state);
+	m_Renderer.Present();
+}
+
+std::string_view DisplayManager::ComposeRoundStart(const CityState& state)
+{
+	const ArtAsset& advisorArt = state.HasPlague ? m_Art.GetRat() : m_Art.GetAdvisor();
 	
-	std::vector<std::string> textLines = BuildRoundStartText(state);
+	BuildRoundStartText(state);
 	
-	PrintArtWithText(advisorArt, textLines);
+	m_Renderer.Compose(advisorArt, m_ReportLines);
+	return m_Renderer.GetOutput();
 }
 
-void DisplayManager::ShowFinalRating(const CityState& state, const GameStatistics& stats) const
+void DisplayManager::ShowFinalRating(const CityState& state, const GameStatistics& stats)
 {
-	system("cls");
-	
-	GameStatistics::Rating rating = stats.GetRating(state.Area, state.Population);
+	ClearScreen();
+	m_Renderer.Invalidate();
 	
 	std::cout << GameConfig::Messages::GAME_FINISHED;
+	std::cout << GetRatingText(state, stats);
+}
+
+const std::string& DisplayManager::GetRatingText(const CityState& state, const GameStatistics& stats) const
+{
+	GameStatistics::Rating rating = stats.GetRating(state.Area, state.Population);
 	
 	switch (rating)
 	{
 	case GameStatistics::Rating::Poor:
-		std::cout << GameConfig::Ratings::POOR;
-		break;
+		return GameConfig::Ratings::POOR;
 	case GameStatistics::Rating::Fair:
-		std::cout << GameConfig::Ratings::FAIR;
-		break;
+		return GameConfig::Ratings::FAIR;
 	case GameStatistics::Rating::Good:
-		std::cout << GameConfig::Ratings::GOOD;
-		break;
+		return GameConfig::Ratings::GOOD;
 	case GameStatistics::Rating::Excellent:
-		std::cout << GameConfig::Ratings::EXCELLENT;
-		break;
+	default:
+		return GameConfig::Ratings::EXCELLENT;
 	}
 }
 
@@ -84,94 +131,58 @@ void DisplayManager::ShowGameOver() const
 	std::cout << "Нажмите любую клавишу, чтобы продолжить.";
 }
 
-std::vector<std::string> DisplayManager::LoadMainScreenArt() const
+void DisplayManager::ShowOutcomePreview(const OutcomePreview& preview) const
 {
-	return LoadASCIIArtFromFile(GameConfig::Paths::MAIN_SCREEN);
+	auto percent = [](float share) { return (int)(share * 100.0f + 0.5f); };
+	
+	std::cout << "\nСоветник просчитал " << preview.Samples << " исходов следующего года:\n";
+	std::cout << "   угроза свержения за голод - " << percent(preview.OverthrowRisk) << "%,\n";
+	std::cout << "   запасов не хватит прокормить всех через год - " << percent(preview.StarvationRisk) << "%.\n";
+	std::cout << "   Жителей будет " << preview.Population.Median
+		<< " (от " << preview.Population.Low << " до " << preview.Population.High << "),\n";
+	std::cout << "   в запасах - " << preview.Reserves.Median
+		<< " бушелей (от " << preview.Reserves.Low << " до " << preview.Reserves.High << ").\n";
 }
 
-std::vector<std::string> DisplayManager::LoadAdvisorArt() const
+void DisplayManager::InvalidateFrame()
 {
-	return LoadASCIIArtFromFile(GameConfig::Paths::ADVISOR_ART);
+	// После постороннего вывода терминал мог прокрутиться - следующий кадр рисуется целиком
+	m_Renderer.Invalidate();
 }
 
-std::vector<std::string> DisplayManager::LoadRatArt() const
+void DisplayManager::PrintArtWithText(const ArtAsset& art, const std::vector<std::string_view>& text)
 {
-	return LoadASCIIArtFromFile(GameConfig::Paths::RAT_ART);
+	m_Renderer.Compose(art, text);
+	m_Renderer.Present();
 }
 
-void DisplayManager::PrintArtWithText(const std::vector<std::string>& art, const std::vector<std::string>& text) const
+void DisplayManager::BuildRoundStartText(const CityState& state)
 {
-	size_t maxHeight = art.size();
-	if (text.size() > maxHeight)
-		maxHeight = text.size();
-	
-	size_t maxArtWidth = 0;
-	for (size_t i = 0; i < art.size(); i++)
+	// Буферы живут вместе с DisplayManager: после первого раунда память не выделяется
+	if (m_ReportText.capacity() < REPORT_RESERVE)
 	{
-		if (art[i].length() > maxArtWidth)
-			maxArtWidth = art[i].length();
+		m_ReportText.reserve(REPORT_RESERVE);
+		m_ReportOffsets.reserve(std::size(ROUND_REPORT) + 1);
+		m_ReportLines.reserve(std::size(ROUND_REPORT));
 	}
 	
-	size_t ART_WIDTH = maxArtWidth + 5;
-	
-	for (size_t i = 0; i < maxHeight; i++)
+	m_ReportText.clear();
+	m_ReportOffsets.clear();
+	for (const CompiledReportLine& line : GetRoundReport())
 	{
-		if (i < art.size())
-		{
-			std::cout << std::left << std::setw((int)ART_WIDTH) 
-				<< std::setfill(' ') << art[i];
-		}
-		else
-		{
-			for (size_t j = 0; j < ART_WIDTH; j++)
-				std::cout << " ";
-		}
+		m_ReportOffsets.push_back(m_ReportText.size());
 		
-		if (i < text.size())
-		{
-			std::cout << text[i];
-		}
-		
-		std::cout << std::endl;
+		// Пропущенная строка остается пустой, чтобы кадр не менял высоту
+		if (line.Condition == ReportField::None || ReportTemplate::GetFieldValue(state, line.Condition) != 0)
+			line.Template.AppendTo(state, m_ReportText);
 	}
-}
-
-std::vector<std::string> DisplayManager::BuildRoundStartText(const CityState& state) const
-{
-	std::vector<std::string> textLines;
-	
-	textLines.push_back("Мой повелитель, я хочу поведать тебе о " + 
-		std::to_string(state.Round) + " годе твоего правления");
-	textLines.push_back("");
-	
-	if (state.DeadFromHunger > 0)
-		textLines.push_back(std::to_string(state.DeadFromHunger) + " человек умерло от голода.");
-	else
-		textLines.push_back("");
-	
-	if (state.NewPeople > 0)
-		textLines.push_back(std::to_string(state.NewPeople) + " человек прибыло в наш великий город");
-	else
-		textLines.push_back("");
-	
-	if (state.HasPlague)
-		textLines.push_back("Наш город также постигла чума.");
-	else
-		textLines.push_back("");
+	m_ReportOffsets.push_back(m_ReportText.size());
 	
-	textLines.push_back("Сейчас в городе " + std::to_string(state.Population) + " жителей.");
-	textLines.push_back("");
-	textLines.push_back("С каждого акра было собрано " + std::to_string(state.WheatPerAcre) + " бушелей,");
-	textLines.push_back("а всего собрано " + std::to_string(state.WorkableArea * state.WheatPerAcre) + " бушелей.");
-	textLines.push_back("");
-	textLines.push_back("Крысы съели " + std::to_string(state.WheatEatenByRats) + " бушелей пшена!");
-	textLines.push_back("");
-	textLines.push_back("В запасах города осталось " + std::to_string(state.WheatReserves) + " бушелей.");
-	textLines.push_back("");
-	
-	textLines.push_back("В этом году цена акра составляет " + 
-		std::to_string(state.AcrePrice) + " бушелей пшена.");
-	
-	return textLines;
+	// Строки ссылаются на m_ReportText, поэтому берутся, когда он уже не растет
+	std::string_view text = m_ReportText;
+	m_ReportLines.clear();
+	for (size_t i = 0; i + 1 < m_ReportOffsets.size(); i++)
+	{
+		m_ReportLines.push_back(text.substr(m_ReportOffsets[i], m_ReportOffsets[i + 1] - m_ReportOffsets[i]));
+	}
 }
-
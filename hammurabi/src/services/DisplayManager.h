@@ -2,23 +2,41 @@
 
 #include "../domain/CityState.h"
 #include "../domain/Statistics.h"
+#include "ArtCache.h"
+#include "FrameRenderer.h"
+#include "ReportTemplate.h"
+#include "WhatIfAdvisor.h"
 #include <string>
+#include <string_view>
 #include <vector>
 
 class DisplayManager
 {
+	// Замеры HammurabiBench вызывают закрытые методы напрямую
+	friend class BenchmarkAccess;
+
 public:
 	DisplayManager();
-	void ShowMainScreen() const;
-	void ShowRoundStart(const CityState& state) const;
-	void ShowFinalRating(const CityState& state, const GameStatistics& stats) const;
+	void ShowMainScreen();
+	void ShowRoundStart(const CityState& state);
+	void ShowFinalRating(const CityState& state, const GameStatistics& stats);
 	void ShowGameOver() const;
+	void ShowOutcomePreview(const OutcomePreview& preview) const;
+	void InvalidateFrame();
+	
+	std::string_view ComposeRoundStart(const CityState& state);
+	const std::string& GetRatingText(const CityState& state, const GameStatistics& stats) const;
+
+private:
+	void PrintArtWithText(const ArtAsset& art, const std::vector<std::string_view>& text);
+	// Отчет раунда по шаблонам в m_ReportText, строки - в m_ReportLines
+	void BuildRoundStartText(const CityState& state);
 
 private:
-	std::vector<std::string> LoadMainScreenArt() const;
-	std::vector<std::string> LoadAdvisorArt() const;
-	std::vector<std::string> LoadRatArt() const;
-	void PrintArtWithText(const std::vector<std::string>& art, const std::vector<std::string>& text) const;
-	std::vector<std::string> BuildRoundStartText(const CityState& state) const;
+	const ArtCache& m_Art;
+	FrameRenderer m_Renderer;
+	std::string m_ReportText;                   // Строки отчета подряд
+	std::vector<size_t> m_ReportOffsets;        // Начала строк в m_ReportText (+ конец последней)
+	std::vector<std::string_view> m_ReportLines;
 };
 
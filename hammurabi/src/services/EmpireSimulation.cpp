@@ -0,0 +1,331 @@
+#include "EmpireSimulation.h"
+#include "../domain/CityRound.h"
+#include "../utils/SplitMix64.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+namespace
+{
+	constexpr size_t CHUNK = GameConfig::Empire::CITIES_PER_CHUNK;
+	constexpr uint64_t MARKET_STREAM = std::numeric_limits<uint32_t>::max();
+	constexpr double SCALING_MIN_SECONDS = 0.2;      // Сколько гонять каждую клетку таблицы масштабирования
+
+	// У каждого города свой поток случайных чисел из (зерно, раунд, город) без общего состояния
+	SplitMix64 MakeCityRandom(uint32_t seed, uint32_t round, uint64_t city)
+	{
+		return SplitMix64(SplitMix64::MakeSeed((uint64_t)seed << 32 | round, city));
+	}
+
+	// Пшеница сверх еды и семян на будущий год; отрицательная - нехватка
+	int64_t GetWheatSpare(const CityState& city)
+	{
+		int64_t workable = std::min<int64_t>(city.Area, (int64_t)city.Population * DefaultRules::AcresPerPerson);
+		int64_t needed = (int64_t)city.Population * DefaultRules::WheatPerPerson
+			+ (int64_t)DefaultRules::SeedsPerAcre.Scale((Quantity)workable);
+		return (int64_t)city.WheatReserves - needed;
+	}
+
+	// Доля заявки, попавшая в сделку: заявки обслуживаются по порядку,
+	// пока их сумма не достигнет объема сделки
+	uint64_t TakeShare(uint64_t traded, uint64_t& before, uint64_t amount)
+	{
+		uint64_t share = traded > before ? std::min(traded - before, amount) : 0;
+		before += amount;
+		return share;
+	}
+}
+
+EmpireSimulation::EmpireSimulation(const EmpireConfig& config)
+	: m_Config(config),
+	m_Pool(config.Threads),
+	m_AcrePrice(0),
+	m_Traded(0),
+	m_Summary()
+{
+	m_Config.Cities = std::clamp<uint32_t>(m_Config.Cities, 1, GameConfig::Empire::MAX_CITIES);
+
+	m_Cities.assign(m_Config.Cities, CityState());
+	m_Overthrown.assign(m_Config.Cities, 0);
+	m_Balance.assign(m_Config.Cities, 0);
+	m_Chunks.assign((m_Config.Cities + CHUNK - 1) / CHUNK, ChunkTotals{});
+
+	m_Summary.Round = 1;
+	Summarize();
+}
+
+void EmpireSimulation::PlayRound()
+{
+	if (IsCompleted())
+		return;
+
+	// Цена акра общая для всей империи
+	SplitMix64 market = MakeCityRandom(m_Config.Seed, m_Summary.Round, MARKET_STREAM);
+	m_AcrePrice = DrawAcrePrice(market, DefaultRules{});
+
+	m_Pool.ParallelFor(m_Cities.size(), CHUNK, [this](size_t begin, size_t end) { PlayCities(begin, end); });
+	m_Traded = SettleChunks();
+	m_Summary.AcresTraded = m_Traded;
+
+	m_Pool.ParallelFor(m_Cities.size(), CHUNK, [this](size_t begin, size_t end) { TradeLand(begin, end); });
+	m_Traded = SettleChunks();
+	m_Summary.WheatShipped = m_Traded;
+
+	m_Pool.ParallelFor(m_Cities.size(), CHUNK, [this](size_t begin, size_t end) { ShipWheat(begin, end); });
+
+	m_Summary.Round++;
+	Summarize();
+}
+
+bool EmpireSimulation::IsCompleted() const
+{
+	return m_Summary.Round >= DefaultRules::MaxRounds || m_Summary.ActiveCities == 0;
+}
+
+const EmpireSummary& EmpireSimulation::GetSummary() const
+{
+	return m_Summary;
+}
+
+const std::vector<CityState>& EmpireSimulation::GetCities() const
+{
+	return m_Cities;
+}
+
+uint32_t EmpireSimulation::GetThreadCount() const
+{
+	return m_Pool.GetThreadCount();
+}
+
+uint64_t EmpireSimulation::GetChecksum() const
+{
+	// FNV-1a по итоговым количествам городов
+	uint64_t hash = 0xCBF29CE484222325ull;
+	auto mix = [&hash](uint64_t value)
+	{
+		hash ^= value;
+		hash *= 0x100000001B3ull;
+	};
+
+	for (size_t i = 0; i < m_Cities.size(); i++)
+	{
+		const CityState& city = m_Cities[i];
+		mix(city.Population);
+		mix(city.Area);
+		mix(city.WheatReserves);
+		mix(m_Overthrown[i]);
+	}
+	return hash;
+}
+
+void EmpireSimulation::PlayCities(size_t begin, size_t end)
+{
+	DefaultRules rules;
+	ChunkTotals& totals = m_Chunks[begin / CHUNK];
+	totals = ChunkTotals{};
+
+	for (size_t i = begin; i < end; i++)
+	{
+		m_Balance[i] = 0;
+		if (m_Overthrown[i])
+			continue;
+
+		CityState& city = m_Cities[i];
+		ResetCityRound(city);
+		city.AcrePrice = m_AcrePrice;
+		ApplyCityDecisions(city, DecideScripted(m_Config.Strategy, city, rules), rules);
+
+		SplitMix64 random = MakeCityRandom(m_Config.Seed, city.Round, i);
+		RoundDraws draws{};
+		draws.AcrePrice = m_AcrePrice;
+		DrawCityRound(draws, random, rules);
+		ApplyCityHarvest(city, draws);
+		ApplyCityRats(city, draws);
+		if (ApplyCityHunger(city, rules) >= rules.MaxDeadFromHunger)
+		{
+			m_Overthrown[i] = 1;
+			continue;
+		}
+		ApplyCityNewPeople(city, rules);
+		ApplyCityPlague(city, draws, rules);
+
+		// Землю, которую некому обрабатывать, город продает;
+		// недостающую покупает на пшеницу сверх нужд будущего года
+		int64_t spareArea = (int64_t)city.Area - (int64_t)city.Population * rules.AcresPerPerson;
+		if (spareArea > 0)
+		{
+			m_Balance[i] = spareArea;
+			totals.Offered += (uint64_t)spareArea;
+		}
+		else
+		{
+			int64_t affordable = std::max<int64_t>(GetWheatSpare(city), 0) / m_AcrePrice;
+			int64_t wanted = std::min(-spareArea, affordable);
+			m_Balance[i] = -wanted;
+			totals.Wanted += (uint64_t)wanted;
+		}
+	}
+}
+
+void EmpireSimulation::TradeLand(size_t begin, size_t end)
+{
+	ChunkTotals& totals = m_Chunks[begin / CHUNK];
+	uint64_t offeredBefore = totals.OfferedBefore;
+	uint64_t wantedBefore = totals.WantedBefore;
+	totals = ChunkTotals{};
+
+	for (size_t i = begin; i < end; i++)
+	{
+		if (m_Overthrown[i])
+		{
+			m_Balance[i] = 0;
+			continue;
+		}
+
+		CityState& city = m_Cities[i];
+		if (m_Balance[i] > 0)
+		{
+			Quantity sold = (Quantity)TakeShare(m_Traded, offeredBefore, (uint64_t)m_Balance[i]);
+			city.Area = QuantitySub(city.Area, sold);
+			city.WheatReserves = QuantityAdd(city.WheatReserves, QuantityMul(sold, m_AcrePrice));
+		}
+		else if (m_Balance[i] < 0)
+		{
+			Quantity bought = (Quantity)TakeShare(m_Traded, wantedBefore, (uint64_t)-m_Balance[i]);
+			city.Area = QuantityAdd(city.Area, bought);
+			city.WheatReserves = QuantitySub(city.WheatReserves, QuantityMul(bought, m_AcrePrice));
+		}
+
+		// Заявка на пшеницу: часть излишка уходит голодающим
+		int64_t spare = GetWheatSpare(city);
+		if (spare > 0)
+		{
+			m_Balance[i] = spare * GameConfig::Empire::SURPLUS_EXPORT_PERCENT / 100;
+			totals.Offered += (uint64_t)m_Balance[i];
+		}
+		else
+		{
+			m_Balance[i] = spare;
+			totals.Wanted += (uint64_t)-spare;
+		}
+	}
+}
+
+void EmpireSimulation::ShipWheat(size_t begin, size_t end)
+{
+	ChunkTotals& totals = m_Chunks[begin / CHUNK];
+	uint64_t offeredBefore = totals.OfferedBefore;
+	uint64_t wantedBefore = totals.WantedBefore;
+
+	for (size_t i = begin; i < end; i++)
+	{
+		if (m_Overthrown[i])
+			continue;
+
+		CityState& city = m_Cities[i];
+		if (m_Balance[i] > 0)
+		{
+			Quantity sent = (Quantity)TakeShare(m_Traded, offeredBefore, (uint64_t)m_Balance[i]);
+			city.WheatReserves = QuantitySub(city.WheatReserves, sent);
+		}
+		else if (m_Balance[i] < 0)
+		{
+			Quantity received = (Quantity)TakeShare(m_Traded, wantedBefore, (uint64_t)-m_Balance[i]);
+			city.WheatReserves = QuantityAdd(city.WheatReserves, received);
+		}
+		city.Round++;
+	}
+}
+
+uint64_t EmpireSimulation::SettleChunks()
+{
+	uint64_t offered = 0;
+	uint64_t wanted = 0;
+	for (ChunkTotals& totals : m_Chunks)
+	{
+		totals.OfferedBefore = offered;
+		totals.WantedBefore = wanted;
+		offered += totals.Offered;
+		wanted += totals.Wanted;
+	}
+	return std::min(offered, wanted);
+}
+
+void EmpireSimulation::Summarize()
+{
+	m_Summary.ActiveCities = 0;
+	m_Summary.Population = 0;
+	m_Summary.Area = 0;
+	m_Summary.WheatReserves = 0;
+
+	for (size_t i = 0; i < m_Cities.size(); i++)
+	{
+		if (m_Overthrown[i])
+			continue;
+
+		const CityState& city = m_Cities[i];
+		m_Summary.ActiveCities++;
+		m_Summary.Population += city.Population;
+		m_Summary.Area += city.Area;
+		m_Summary.WheatReserves += city.WheatReserves;
+	}
+}
+
+void RunEmpireScaling(uint32_t maxThreads, uint32_t seed)
+{
+	if (maxThreads == 0)
+		maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+	std::vector<uint32_t> threadCounts;
+	for (uint32_t threads = 1; threads < maxThreads; threads *= 2)
+	{
+		threadCounts.push_back(threads);
+	}
+	threadCounts.push_back(maxThreads);
+
+	// Ширина заголовков подогнана под столбцы вручную: setw считает байты, а не буквы
+	std::cout << " городов потоков  нс/город-раунд   ускорение  итог\n";
+
+	for (uint32_t cities = 1; cities <= 100000; cities *= 10)
+	{
+		double singleThreaded = 0.0;
+		uint64_t reference = 0;
+
+		for (uint32_t threads : threadCounts)
+		{
+			EmpireConfig config{cities, seed, threads, ScriptedStrategy::LandTrader};
+			double seconds = 0.0;
+			uint64_t cityRounds = 0;
+			uint64_t checksum = 0;
+
+			// Империя играется целиком, пока не наберется достаточно времени для замера
+			while (seconds < SCALING_MIN_SECONDS)
+			{
+				EmpireSimulation empire(config);
+				auto started = std::chrono::steady_clock::now();
+				while (!empire.IsCompleted())
+				{
+					cityRounds += empire.GetSummary().ActiveCities;
+					empire.PlayRound();
+				}
+				seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+				checksum = empire.GetChecksum();
+			}
+
+			double nanoseconds = seconds * 1e9 / (double)std::max<uint64_t>(cityRounds, 1);
+			if (threads == 1)
+			{
+				singleThreaded = nanoseconds;
+				reference = checksum;
+			}
+
+			std::cout << std::setw(8) << cities << std::setw(8) << threads
+				<< std::setw(16) << std::fixed << std::setprecision(1) << nanoseconds
+				<< std::setw(12) << std::setprecision(2) << singleThreaded / nanoseconds
+				<< "  " << (checksum == reference ? "совпадает" : "РАСХОДИТСЯ") << "\n";
+		}
+	}
+}
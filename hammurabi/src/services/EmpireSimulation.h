@@ -0,0 +1,89 @@
+#pragma once
+
+#include "../config/GameRules.h"
+#include "../domain/CityState.h"
+#include "../domain/ScriptedStrategy.h"
+#include "../utils/ThreadPool.h"
+#include <cstdint>
+#include <vector>
+
+// Параметры империи
+struct EmpireConfig
+{
+	uint32_t Cities;
+	uint32_t Seed;
+	uint32_t Threads;               // 0 - по числу ядер
+	ScriptedStrategy Strategy;      // Как наместники ведут свои города
+};
+
+// Итоги империи после раунда
+struct EmpireSummary
+{
+	uint32_t Round;
+	uint32_t ActiveCities;          // Города, где наместника не свергли за голод
+	uint64_t Population;
+	uint64_t Area;
+	uint64_t WheatReserves;
+	uint64_t AcresTraded;           // Земли перешло между городами за раунд
+	uint64_t WheatShipped;          // Пшеницы отправлено голодающим городам за раунд
+};
+
+// Империя из многих городов под одним правителем.
+// Раунд идет в три прохода по городам, каждый параллельно на пуле потоков:
+//   1. Свой раунд каждого города: решения наместника, урожай, крысы, голод,
+//      прирост, чума (шаги из CityRound.h), затем заявка на рынок земли.
+//   2. Торговля землей по общей цене, затем заявка на перевозку пшеницы.
+//   3. Перевозка пшеницы из городов с излишком в голодающие.
+// Между проходами заявки сводятся по кускам в фиксированном порядке:
+// продавцы и покупатели обслуживаются по номерам городов, поэтому итог
+// раунда не зависит от числа потоков. Случайные величины города
+// вычисляются из (зерно, раунд, номер города) без общего генератора.
+class EmpireSimulation
+{
+public:
+	explicit EmpireSimulation(const EmpireConfig& config);
+
+	void PlayRound();
+	bool IsCompleted() const;
+
+	const EmpireSummary& GetSummary() const;
+	const std::vector<CityState>& GetCities() const;
+	uint32_t GetThreadCount() const;
+	// Хеш состояния всех городов - для сравнения прогонов с разным числом потоков
+	uint64_t GetChecksum() const;
+
+private:
+	// Заявки одного куска городов
+	struct ChunkTotals
+	{
+		uint64_t Offered;           // Сколько готовы отдать (акры или бушели)
+		uint64_t Wanted;            // Сколько хотят получить
+		uint64_t OfferedBefore;     // Сумма Offered всех предыдущих кусков
+		uint64_t WantedBefore;
+	};
+
+	void PlayCities(size_t begin, size_t end);
+	void TradeLand(size_t begin, size_t end);
+	void ShipWheat(size_t begin, size_t end);
+	// Префиксные суммы заявок по кускам; возвращает объем сделки
+	uint64_t SettleChunks();
+	void Summarize();
+
+private:
+	EmpireConfig m_Config;
+	ThreadPool m_Pool;
+
+	std::vector<CityState> m_Cities;
+	std::vector<uint8_t> m_Overthrown;      // 1 - город вышел из империи
+	std::vector<int64_t> m_Balance;         // > 0 - предложение города, < 0 - спрос
+	std::vector<ChunkTotals> m_Chunks;
+
+	uint32_t m_AcrePrice;                   // Цена акра на рынке империи в этом раунде
+	uint64_t m_Traded;                      // Объем текущей сделки
+	EmpireSummary m_Summary;
+};
+
+// Таблица масштабирования: империи от 1 до 100000 городов на 1, 2, 4... maxThreads потоках.
+// Для каждой клетки - время на город-раунд, ускорение к одному потоку
+// и сверка итога с однопоточным прогоном.
+void RunEmpireScaling(uint32_t maxThreads, uint32_t seed);
@@ -0,0 +1,57 @@
+#include "EnginePool.h"
+#include "../config/GameConfig.h"
+#include <vector>
+
+namespace
+{
+	template<typename Rules>
+	std::vector<std::unique_ptr<BasicGameEngine<Rules>>>& GetIdleEngines()
+	{
+		thread_local std::vector<std::unique_ptr<BasicGameEngine<Rules>>> idle;
+		return idle;
+	}
+}
+
+template<typename Rules>
+void BasicEnginePool<Rules>::Release::operator()(Engine* engine) const
+{
+	std::unique_ptr<Engine> owned(engine);
+	// Следующий владелец не должен писать в чужие, возможно уже удаленные, объекты
+	owned->Detach();
+	std::vector<std::unique_ptr<Engine>>& idle = GetIdleEngines<Rules>();
+	if (idle.size() >= GameConfig::Game::ENGINE_POOL_IDLE)
+		return;
+
+	idle.reserve(GameConfig::Game::ENGINE_POOL_IDLE);
+	idle.push_back(std::move(owned));
+}
+
+template<typename Rules>
+typename BasicEnginePool<Rules>::Handle BasicEnginePool<Rules>::Acquire(uint64_t seed, const Rules& rules, const CityState& initialState)
+{
+	std::vector<std::unique_ptr<Engine>>& idle = GetIdleEngines<Rules>();
+
+	std::unique_ptr<Engine> engine;
+	if (idle.empty())
+	{
+		engine = std::make_unique<Engine>(rules);
+	}
+	else
+	{
+		engine = std::move(idle.back());
+		idle.pop_back();
+		engine->SetRules(rules);
+	}
+
+	engine->Reset(seed, initialState);
+	return Handle(engine.release());
+}
+
+template<typename Rules>
+size_t BasicEnginePool<Rules>::GetIdleCount()
+{
+	return GetIdleEngines<Rules>().size();
+}
+
+template class BasicEnginePool<DefaultRules>;
+template class BasicEnginePool<RuntimeRules>;
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "../config/GameRules.h"
+#include "../domain/CityState.h"
+#include "GameEngine.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Пул готовых движков своего потока.
+// Движок тяжелый: менеджеры сохранений, ввода и отрисовки с их буферами,
+// журнал партии - поэтому партии берут его из пула и сбрасывают Reset,
+// а не создают заново. Отданный движок возвращается в пул того потока,
+// где его отпустили, без сценария, наблюдателя и автосохранения; сверх GameConfig::Game::ENGINE_POOL_IDLE свободных он удаляется.
+template<typename Rules>
+class BasicEnginePool
+{
+public:
+	using Engine = BasicGameEngine<Rules>;
+
+	struct Release
+	{
+		void operator()(Engine* engine) const;
+	};
+	using Handle = std::unique_ptr<Engine, Release>;
+
+	static Handle Acquire(uint64_t seed, const Rules& rules = Rules(), const CityState& initialState = CityState());
+	static size_t GetIdleCount();
+};
+
+extern template class BasicEnginePool<DefaultRules>;
+extern template class BasicEnginePool<RuntimeRules>;
+
+using GameEnginePool = BasicEnginePool<DefaultRules>;
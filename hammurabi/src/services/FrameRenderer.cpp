@@ -0,0 +1,132 @@
+#include "FrameRenderer.h"
+#include "../utils/utility.h"
+#include "../utils/Profiler.h"
+#include <charconv>
+
+namespace
+{
+	// Самый большой кадр - арт в 29 строк рядом с отчетом раунда, около 1.9 КБ
+	constexpr size_t FRAME_RESERVE = 2 * 1024;
+	constexpr size_t ROWS_RESERVE = 32;
+	constexpr size_t ART_PADDING = 5;
+}
+
+FrameRenderer::FrameRenderer()
+	: m_PreviousValid(false)
+{
+}
+
+void FrameRenderer::Compose(const ArtAsset& artAsset, const std::vector<std::string_view>& text)
+{
+	// Буферы выделяются при первом кадре: рендерер без кадров (например, в симуляции) памяти не занимает
+	if (m_Output.capacity() < FRAME_RESERVE)
+	{
+		m_Rows.reserve(FRAME_RESERVE);
+		m_PrevRows.reserve(FRAME_RESERVE);
+		m_Output.reserve(FRAME_RESERVE);
+		m_RowOffsets.reserve(ROWS_RESERVE);
+		m_PrevRowOffsets.reserve(ROWS_RESERVE);
+	}
+
+	const std::vector<std::string_view>& art = artAsset.GetLines();
+
+	size_t maxHeight = art.size();
+	if (text.size() > maxHeight)
+		maxHeight = text.size();
+
+	size_t artWidth = artAsset.GetMaxWidth() + ART_PADDING;
+
+	m_Rows.clear();
+	m_RowOffsets.clear();
+	for (size_t i = 0; i < maxHeight; i++)
+	{
+		m_RowOffsets.push_back(m_Rows.size());
+
+		size_t artLength = 0;
+		if (i < art.size())
+		{
+			m_Rows.append(art[i]);
+			artLength = art[i].length();
+		}
+		m_Rows.append(artWidth - artLength, ' ');
+
+		if (i < text.size())
+			m_Rows.append(text[i]);
+	}
+	m_RowOffsets.push_back(m_Rows.size());
+
+	if (m_PreviousValid && m_PrevRowOffsets.size() == m_RowOffsets.size())
+		BuildDiffOutput();
+	else
+		BuildFullOutput();
+
+	m_Rows.swap(m_PrevRows);
+	m_RowOffsets.swap(m_PrevRowOffsets);
+	m_PreviousValid = true;
+}
+
+std::string_view FrameRenderer::GetOutput() const
+{
+	return m_Output;
+}
+
+void FrameRenderer::Present() const
+{
+	PROFILE_SCOPE(ProfilePhase::Render);
+	
+	WriteConsoleBytes(m_Output);
+}
+
+void FrameRenderer::Invalidate()
+{
+	m_PreviousValid = false;
+}
+
+void FrameRenderer::BuildFullOutput()
+{
+	m_Output.clear();
+	m_Output.append(ANSI_CLEAR_SCREEN);
+
+	size_t rowCount = m_RowOffsets.size() - 1;
+	for (size_t i = 0; i < rowCount; i++)
+	{
+		m_Output.append(GetRow(m_Rows, m_RowOffsets, i));
+		m_Output.push_back('\n');
+	}
+}
+
+void FrameRenderer::BuildDiffOutput()
+{
+	m_Output.clear();
+
+	size_t rowCount = m_RowOffsets.size() - 1;
+	for (size_t i = 0; i < rowCount; i++)
+	{
+		std::string_view row = GetRow(m_Rows, m_RowOffsets, i);
+		if (row == GetRow(m_PrevRows, m_PrevRowOffsets, i))
+			continue;
+
+		AppendCursorMove(i);
+		m_Output.append(row);
+		m_Output.append("\x1b[K");
+	}
+
+	// Курсор под кадр, все ниже него стираем
+	AppendCursorMove(rowCount);
+	m_Output.append("\x1b[J");
+}
+
+std::string_view FrameRenderer::GetRow(const std::string& rows, const std::vector<size_t>& offsets, size_t index) const
+{
+	return std::string_view(rows).substr(offsets[index], offsets[index + 1] - offsets[index]);
+}
+
+void FrameRenderer::AppendCursorMove(size_t row)
+{
+	char digits[24];
+	auto result = std::to_chars(digits, digits + sizeof(digits), row + 1);
+
+	m_Output.append("\x1b[");
+	m_Output.append(digits, result.ptr);
+	m_Output.append(";1H");
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "ArtCache.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Отрисовка экрана одним блоком: арт слева, текст справа.
+// Кадр собирается в заранее выделенный буфер и уходит в терминал одним вызовом write.
+// Экран очищается ANSI-последовательностями, а если предыдущий кадр еще на экране,
+// перерисовываются только изменившиеся строки.
+class FrameRenderer
+{
+public:
+	FrameRenderer();
+
+	void Compose(const ArtAsset& art, const std::vector<std::string_view>& text);
+	std::string_view GetOutput() const;
+	void Present() const;
+	void Invalidate();
+
+private:
+	void BuildFullOutput();
+	void BuildDiffOutput();
+	std::string_view GetRow(const std::string& rows, const std::vector<size_t>& offsets, size_t index) const;
+	void AppendCursorMove(size_t row);
+
+private:
+	std::string m_Rows;                   // Строки текущего кадра подряд
+	std::vector<size_t> m_RowOffsets;     // Начала строк в m_Rows (+ конец последней)
+	std::string m_PrevRows;
+	std::vector<size_t> m_PrevRowOffsets;
+	std::string m_Output;                 // Байты для терминала
+	bool m_PreviousValid;                 // Предыдущий кадр все еще на экране
+};
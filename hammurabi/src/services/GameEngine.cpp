@@ -1,26 +1,68 @@
 #include "GameEngine.h"
+#include "Leaderboard.h"
 #include "../config/GameConfig.h"
 #include "../utils/utility.h"
+#include "../utils/Profiler.h"
 #include <algorithm>
-#include <ctime>
-#include <random>
+#include <chrono>
+#include <string>
 
-GameEngine::GameEngine()
-	: m_State(),
+template<typename Rules>
+BasicGameEngine<Rules>::BasicGameEngine(const Rules& rules)
+	: m_Rules(rules),
+	m_State(),
 	m_Stats(),
 	m_GameState(GameState::Ongoing),
-	m_RandomGenerator(static_cast<unsigned>(std::time(nullptr)))
+	m_Draws(),
+	m_Decisions(),
+	m_Advisor(rules),
+	m_Publisher(nullptr),
+	m_AutoSaver(nullptr),
+	m_Journaling(false),
+	m_RandomGenerator(SplitMix64::GetProcessSeed())
 {
 	CalculateAcrePrice();
 }
 
-void GameEngine::Run()
+template<typename Rules>
+void BasicGameEngine<Rules>::Reset(uint64_t seed, const CityState& initialState)
 {
-	if (m_SaveManager.HasSaves())
+	m_Journal.Close();
+	m_DisplayManager.InvalidateFrame();
+	
+	m_State = initialState;
+	m_Stats = GameStatistics();
+	m_GameState = GameState::Ongoing;
+	m_Draws = RoundDraws();
+	m_Decisions = PlayerDecisions();
+	Seed(seed);
+	
+	// Цена для экрана первого раунда берется из копии генератора: поток остается
+	// в начале, и партия с этим зерном идет так же, как после Seed у нового движка
+	SplitMix64 preview = m_RandomGenerator;
+	m_Draws.AcrePrice = DrawAcrePrice(preview, m_Rules);
+	m_State.AcrePrice = m_Draws.AcrePrice;
+}
+
+template<typename Rules>
+void BasicGameEngine<Rules>::SetRules(const Rules& rules)
+{
+	m_Rules = rules;
+	m_Advisor.SetRules(rules);
+}
+
+template<typename Rules>
+void BasicGameEngine<Rules>::Run()
+{
+	// По сценарию всегда играется новая партия: выбор сохранения - вопрос к человеку
+	if (!m_InputHandler.IsScripted() && m_SaveManager.HasSaves())
 	{
 		LoadGame();
 	}
 	
+	if (m_Journaling)
+		OpenJournal();
+	
 	while (m_GameState == GameState::Ongoing)
 	{
 		BeginRound();
@@ -31,78 +73,172 @@ void GameEngine::Run()
 		bool win = CheckWin();
 		if (gameOver || win)
 		{
+			Leaderboard::Instance().Record(m_State, m_Stats, gameOver);
 			m_GameState = GameState::Finished;
 		}
 	}
 }
 
-bool GameEngine::LoadGame()
+template<typename Rules>
+bool BasicGameEngine<Rules>::LoadGame()
 {
+	m_DisplayManager.InvalidateFrame();
 	return m_SaveManager.LoadGame(m_State, m_Stats);
 }
 
-void GameEngine::ShowMainScreen()
+template<typename Rules>
+void BasicGameEngine<Rules>::ShowMainScreen()
 {
 	m_DisplayManager.ShowMainScreen();
 }
 
-void GameEngine::BeginRound()
+template<typename Rules>
+void BasicGameEngine<Rules>::SetAutoSaver(AutoSaver* autoSaver)
 {
-	m_DisplayManager.ShowRoundStart(m_State);
-	
-	m_State.DeadFromHunger = 0;
-	m_State.NewPeople = 0;
-	m_State.HasPlague = false;
-	m_State.WheatEatenByRats = 0;
+	m_AutoSaver = autoSaver;
+}
+
+template<typename Rules>
+void BasicGameEngine<Rules>::SetJournaling(bool enabled)
+{
+	m_Journaling = enabled;
+}
+
+template<typename Rules>
+bool BasicGameEngine<Rules>::StartJournal(const std::filesystem::path& filePath)
+{
+	return m_Journal.Open(filePath, m_State, MakeRuntimeRules(m_Rules));
+}
+
+template<typename Rules>
+void BasicGameEngine<Rules>::BeginRound()
+{
+	PROFILE_SCOPE(ProfilePhase::BeginRound);
 	
+	m_DisplayManager.ShowRoundStart(m_State);
+	StartRound();
+}
+
+template<typename Rules>
+void BasicGameEngine<Rules>::Seed(uint64_t seed)
+{
+	// Одинаковое зерно - одинаковая погода, цены и чума при любых решениях
+	m_RandomGenerator = SplitMix64(seed);
+}
+
+template<typename Rules>
+void BasicGameEngine<Rules>::SetScript(ScriptedInput* script)
+{
+	m_InputHandler.SetScript(script);
+}
+
+template<typename Rules>
+void BasicGameEngine<Rules>::SetPublisher(StatePublisher* publisher)
+{
+	m_Publisher = publisher;
+}
+
+template<typename Rules>
+void BasicGameEngine<Rules>::Detach()
+{
+	m_InputHandler.SetScript(nullptr);
+	m_Publisher = nullptr;
+	m_AutoSaver = nullptr;
+	m_Journaling = false;
+}
+
+template<typename Rules>
+void BasicGameEngine<Rules>::StartRound()
+{
+	ResetRoundCounters();
 	CalculateAcrePrice();
 }
 
-void GameEngine::ProcessPlayerInput()
+template<typename Rules>
+void BasicGameEngine<Rules>::PlayRound(const PlayerDecisions& decisions)
 {
-	PlayerDecisions decisions = m_InputHandler.GetPlayerDecisions(m_State);
-	ApplyPlayerDecisions(decisions);
+	m_Decisions = decisions;
+	ApplyPlayerDecisions(m_Decisions);
+	SimulateRound();
 }
 
-void GameEngine::ApplyPlayerDecisions(const PlayerDecisions& decisions)
+template<typename Rules>
+void BasicGameEngine<Rules>::AdvanceRound()
 {
-	if (decisions.BuyLand > 0)
-	{
-		uint32_t cost = decisions.BuyLand * m_State.AcrePrice;
-		m_State.Area = m_State.Area + decisions.BuyLand;
-		m_State.WheatReserves = m_State.WheatReserves - cost;
-	}
-	else if (decisions.SellLand > 0)
+	m_State.Round++;
+}
+
+template<typename Rules>
+const CityState& BasicGameEngine<Rules>::GetState() const
+{
+	return m_State;
+}
+
+template<typename Rules>
+const GameStatistics& BasicGameEngine<Rules>::GetStats() const
+{
+	return m_Stats;
+}
+
+template<typename Rules>
+const Rules& BasicGameEngine<Rules>::GetRules() const
+{
+	return m_Rules;
+}
+
+template<typename Rules>
+void BasicGameEngine<Rules>::ResetRoundCounters()
+{
+	ResetCityRound(m_State);
+}
+
+template<typename Rules>
+void BasicGameEngine<Rules>::ProcessPlayerInput()
+{
+	PROFILE_SCOPE(ProfilePhase::ProcessPlayerInput);
+	
+	m_DisplayManager.InvalidateFrame();
+	// Границы считаются один раз, повторные попытки только сравнивают с ними
+	DecisionBounds bounds(m_State, m_Rules);
+	while (true)
 	{
-		uint32_t income = decisions.SellLand * m_State.AcrePrice;
-		m_State.Area = m_State.Area - decisions.SellLand;
-		m_State.WheatReserves = m_State.WheatReserves + income;
+		m_Decisions = m_InputHandler.GetPlayerDecisions(bounds);
+		if (m_InputHandler.IsScripted())
+			break;
+		
+		// Прогноз по копиям города: m_State до утверждения не меняется
+		m_DisplayManager.ShowOutcomePreview(m_Advisor.Preview(m_State, m_Decisions));
+		if (m_InputHandler.RequestConfirm())
+			break;
 	}
-	
-	m_State.WheatConsumed = decisions.WheatForFood;
-	m_State.WheatReserves = m_State.WheatReserves - decisions.WheatForFood;
-	
-	float seeds = decisions.AcresToPlant * GameConfig::Game::SEEDS_PER_ACRE;
-	uint32_t seedsNeeded = (uint32_t)seeds;
-	m_State.WorkableArea = decisions.AcresToPlant;
-	m_State.WheatReserves = m_State.WheatReserves - seedsNeeded;
+	ApplyPlayerDecisions(m_Decisions);
+	PublishState(ProfilePhase::ProcessPlayerInput);
 }
 
-void GameEngine::EndRound()
+template<typename Rules>
+void BasicGameEngine<Rules>::ApplyPlayerDecisions(const PlayerDecisions& decisions)
 {
-	ProcessHarvest();
-	ProcessRats();
-	ProcessHunger();
-	ProcessNewPeople();
-	ProcessPlague();
+	ApplyCityDecisions(m_State, decisions, m_Rules);
+}
+
+template<typename Rules>
+void BasicGameEngine<Rules>::EndRound()
+{
+	PROFILE_SCOPE(ProfilePhase::EndRound);
+	
+	SimulateRound();
 	
 	if (CheckGameOver())
 	{
 		m_DisplayManager.ShowGameOver();
-		ProcessOneshotInput(false);
+		m_InputHandler.WaitForKey();
 		return;
 	}
 	
+	// Снимок уходит фоновому потоку, раунд не ждет записи на диск
+	if (m_AutoSaver)
+		m_AutoSaver->Submit(m_State, m_Stats);
+	
 	bool wantSave = m_InputHandler.RequestSave();
 	if (wantSave)
 	{
@@ -115,100 +251,145 @@ void GameEngine::EndRound()
 	}
 	
 	// Переход к следующему раунду
-	m_State.Round++;
+	AdvanceRound();
 }
 
-void GameEngine::CalculateAcrePrice()
+template<typename Rules>
+void BasicGameEngine<Rules>::SimulateRound()
 {
-	std::uniform_int_distribution<uint32_t> dist(
-		GameConfig::Game::MIN_ACRE_PRICE,
-		GameConfig::Game::MAX_ACRE_PRICE
-	);
-	m_State.AcrePrice = dist(m_RandomGenerator);
+	PROFILE_SCOPE(ProfilePhase::SimulateRound);
+	
+	DrawRoundRandom();
+	ProcessHarvest();
+	ProcessRats();
+	ProcessHunger();
+	ProcessNewPeople();
+	ProcessPlague();
+	
+	m_Journal.AppendRound(RoundRecord{m_State.Round, m_Draws, m_Decisions}, m_State);
 }
 
-void GameEngine::ProcessHarvest()
+template<typename Rules>
+void BasicGameEngine<Rules>::CalculateAcrePrice()
 {
-	std::uniform_int_distribution<uint32_t> dist(
-		GameConfig::Game::MIN_WHEAT_PER_ACRE,
-		GameConfig::Game::MAX_WHEAT_PER_ACRE
-	);
-	m_State.WheatPerAcre = dist(m_RandomGenerator);
-	uint32_t harvested = m_State.WorkableArea * m_State.WheatPerAcre;
-	m_State.WheatReserves = m_State.WheatReserves + harvested;
+	m_Draws.AcrePrice = DrawAcrePrice(m_RandomGenerator, m_Rules);
+	m_State.AcrePrice = m_Draws.AcrePrice;
 }
 
-void GameEngine::ProcessRats()
+template<typename Rules>
+void BasicGameEngine<Rules>::DrawRoundRandom()
 {
-	std::uniform_real_distribution<float> dist(0.0f, GameConfig::Game::RATS_EAT_MAX_PERCENT);
-	float coeff = dist(m_RandomGenerator);
-	float eaten = coeff * (float)m_State.WheatReserves;
-	m_State.WheatEatenByRats = (uint32_t)eaten;
-	m_State.WheatReserves = m_State.WheatReserves - m_State.WheatEatenByRats;
+	// Порядок розыгрыша совпадает с порядком шагов конца раунда
+	DrawCityRound(m_Draws, m_RandomGenerator, m_Rules);
 }
 
-void GameEngine::ProcessHunger()
+template<typename Rules>
+void BasicGameEngine<Rules>::ReplayRound(const RoundRecord& record)
 {
-	uint32_t oldPop = m_State.Population;
+	m_State.Round = record.Round;
+	ResetRoundCounters();
 	
-	uint32_t peopleFed = m_State.WheatConsumed / GameConfig::Game::WHEAT_PER_PERSON;
-	uint32_t minVal = m_State.Population;
-	if (peopleFed < minVal)
-		minVal = peopleFed;
-	m_State.DeadFromHunger = m_State.Population - minVal;
+	m_Draws = record.Draws;
+	m_State.AcrePrice = m_Draws.AcrePrice;
+	m_Decisions = record.Decisions;
+	ApplyPlayerDecisions(m_Decisions);
 	
-	float deadPercent = 0.0f;
-	if (oldPop > 0)
-	{
-		deadPercent = (float)m_State.DeadFromHunger / (float)oldPop;
-	}
-	m_Stats.SetRoundStatistics(m_State.Round, deadPercent);
+	ProcessHarvest();
+	ProcessRats();
+	ProcessHunger();
+	ProcessNewPeople();
+	ProcessPlague();
+}
+
+template<typename Rules>
+bool BasicGameEngine<Rules>::OpenJournal()
+{
+	auto now = std::chrono::system_clock::now().time_since_epoch();
+	auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
+	std::filesystem::path journalPath = GameConfig::Paths::JOURNALS_DIR / ("game_" + std::to_string(millis) + ".bin");
 	
-	m_State.Population = m_State.Population - m_State.DeadFromHunger;
+	// Место под новый журнал: старые партии удаляются
+	ReplayJournal::RemoveOldest(GameConfig::Paths::JOURNALS_DIR, GameConfig::Replay::KEEP_JOURNALS - 1);
+	return StartJournal(journalPath);
 }
 
-void GameEngine::ProcessNewPeople()
+template<typename Rules>
+void BasicGameEngine<Rules>::ProcessHarvest()
 {
-	uint32_t wheatBeforeRats = m_State.WheatReserves + m_State.WheatEatenByRats;
+	PROFILE_SCOPE(ProfilePhase::ProcessHarvest);
 	
-	int32_t part1 = (int32_t)m_State.DeadFromHunger / 2;
-	int32_t part2 = (5 - (int32_t)m_State.WheatPerAcre) * (int32_t)wheatBeforeRats / 600;
-	int32_t newPeople = part1 + part2 + 1;
+	ApplyCityHarvest(m_State, m_Draws);
+	PublishState(ProfilePhase::ProcessHarvest);
+}
+
+template<typename Rules>
+void BasicGameEngine<Rules>::ProcessRats()
+{
+	PROFILE_SCOPE(ProfilePhase::ProcessRats);
+	
+	ApplyCityRats(m_State, m_Draws);
+	PublishState(ProfilePhase::ProcessRats);
+}
+
+template<typename Rules>
+void BasicGameEngine<Rules>::ProcessHunger()
+{
+	PROFILE_SCOPE(ProfilePhase::ProcessHunger);
 	
-	if (newPeople < 0)
-		newPeople = 0;
-	if (newPeople > (int32_t)GameConfig::Game::MAX_NEW_PEOPLE)
-		newPeople = (int32_t)GameConfig::Game::MAX_NEW_PEOPLE;
+	EconomyFixed deadPercent = ApplyCityHunger(m_State, m_Rules);
+	m_Stats.SetRoundStatistics(m_State.Round, deadPercent);
+	PublishState(ProfilePhase::ProcessHunger);
+}
+
+template<typename Rules>
+void BasicGameEngine<Rules>::ProcessNewPeople()
+{
+	PROFILE_SCOPE(ProfilePhase::ProcessNewPeople);
 	
-	m_State.NewPeople = (uint32_t)newPeople;
-	m_State.Population = m_State.Population + m_State.NewPeople;
+	ApplyCityNewPeople(m_State, m_Rules);
+	PublishState(ProfilePhase::ProcessNewPeople);
 }
 
-void GameEngine::ProcessPlague()
+template<typename Rules>
+void BasicGameEngine<Rules>::ProcessPlague()
 {
-	std::uniform_int_distribution<uint32_t> dist(1, 100);
-	m_State.HasPlague = (dist(m_RandomGenerator) <= GameConfig::Game::PLAGUE_PROBABILITY);
+	PROFILE_SCOPE(ProfilePhase::ProcessPlague);
 	
-	if (m_State.HasPlague)
-	{
-		m_State.Population /= 2;
-	}
+	ApplyCityPlague(m_State, m_Draws, m_Rules);
+	PublishState(ProfilePhase::ProcessPlague);
 }
 
-bool GameEngine::CheckGameOver() const
+template<typename Rules>
+void BasicGameEngine<Rules>::PublishState(ProfilePhase phase)
+{
+	if (m_Publisher)
+		m_Publisher->Publish(m_State, m_Stats.GetRoundStatistics(m_State.Round), phase);
+}
+
+template<typename Rules>
+bool BasicGameEngine<Rules>::CheckGameOver() const
 {
 	RoundStatistics roundStats = m_Stats.GetRoundStatistics(m_State.Round);
-	return roundStats.DeadFromHungerPercent >= GameConfig::Game::MAX_DEAD_FROM_HUNGER;
+	return roundStats.DeadFromHungerPercent >= m_Rules.MaxDeadFromHunger;
+}
+
+template<typename Rules>
+bool BasicGameEngine<Rules>::IsCompleted() const
+{
+	return m_State.Round >= m_Rules.MaxRounds;
 }
 
-bool GameEngine::CheckWin()
+template<typename Rules>
+bool BasicGameEngine<Rules>::CheckWin()
 {
-	if (m_State.Round >= GameConfig::Game::MAX_ROUNDS)
+	if (IsCompleted())
 	{
 		m_DisplayManager.ShowFinalRating(m_State, m_Stats);
-		ProcessOneshotInput(false);
+		m_InputHandler.WaitForKey();
 		return true;
 	}
 	return false;
 }
 
+template class BasicGameEngine<DefaultRules>;
+template class BasicGameEngine<RuntimeRules>;
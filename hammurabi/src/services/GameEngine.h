@@ -1,46 +1,113 @@
 #pragma once
 
+#include "../config/GameRules.h"
 #include "../domain/GameState.h"
 #include "../domain/CityState.h"
+#include "../domain/CityRound.h"
 #include "../domain/Statistics.h"
+#include "../domain/PlayerDecisions.h"
+#include "../domain/RoundDraws.h"
 #include "SaveManager.h"
 #include "InputHandler.h"
 #include "DisplayManager.h"
+#include "AutoSaver.h"
+#include "ReplayJournal.h"
+#include "StatePublisher.h"
+#include "WhatIfAdvisor.h"
+#include "../utils/SplitMix64.h"
 #include <cstdint>
-#include <random>
+#include <filesystem>
 
-class GameEngine
+// Движок партии, параметризованный политикой правил (см. GameRules.h).
+// Определения методов лежат в GameEngine.cpp и явно инстанцированы
+// для DefaultRules и RuntimeRules.
+template<typename Rules>
+class BasicGameEngine
 {
+	template<typename> friend class BasicGameReplay;
+	// Замеры HammurabiBench вызывают шаги раунда напрямую
+	friend class BenchmarkAccess;
+
 public:
-	GameEngine();
+	explicit BasicGameEngine(const Rules& rules = Rules());
+	
+	BasicGameEngine(const BasicGameEngine&) = delete;
+	BasicGameEngine& operator=(const BasicGameEngine&) = delete;
+	
+	// Новая партия на том же объекте: члены (генератор, буферы отрисовки)
+	// переиспользуются, журнал прошлой партии закрывается
+	void Reset(uint64_t seed, const CityState& initialState = CityState());
+	void SetRules(const Rules& rules);
 	void Run();
 	bool LoadGame();
 	void ShowMainScreen();
+	
+	// Неинтерактивное управление партией (сетевые сессии, симуляции)
+	void Seed(uint64_t seed);
+	void SetScript(ScriptedInput* script);
+	// Состояние после каждой фазы раунда уходит наблюдателю; nullptr - не публиковать
+	void SetPublisher(StatePublisher* publisher);
+	// Снимок после каждого раунда уходит в автосохранение; nullptr - не сохранять
+	void SetAutoSaver(AutoSaver* autoSaver);
+	// Run ведет журнал каждой партии в JOURNALS_DIR (не больше KEEP_JOURNALS файлов); по умолчанию выключено
+	void SetJournaling(bool enabled);
+	// Журнал текущей партии в заданный файл, до следующего Reset
+	bool StartJournal(const std::filesystem::path& filePath);
+	// Снимает сценарий, наблюдателя, автосохранение и журналирование: указатели
+	// не владеют объектами и не должны пережить того, кто их выдал (пул, сессия)
+	void Detach();
+	void StartRound();
+	void PlayRound(const PlayerDecisions& decisions);
+	void AdvanceRound();
+	bool CheckGameOver() const;
+	bool IsCompleted() const;
+	const CityState& GetState() const;
+	const GameStatistics& GetStats() const;
+	const Rules& GetRules() const;
 
 private:
 	void BeginRound();
 	void ProcessPlayerInput();
 	void EndRound();
+	void SimulateRound();
 	
-	bool CheckGameOver() const;
 	bool CheckWin();
+	void ResetRoundCounters();
 	void CalculateAcrePrice();
+	void DrawRoundRandom();
+	void ReplayRound(const RoundRecord& record);
+	bool OpenJournal();
 	void ProcessHarvest();
 	void ProcessRats();
 	void ProcessHunger();
 	void ProcessNewPeople();
 	void ProcessPlague();
 	void ApplyPlayerDecisions(const PlayerDecisions& decisions);
+	void PublishState(ProfilePhase phase);
 
 private:
+	Rules m_Rules;
 	CityState m_State;
 	GameStatistics m_Stats;
 	GameState m_GameState;
+	RoundDraws m_Draws;
+	PlayerDecisions m_Decisions;
 	
 	SaveManager m_SaveManager;
 	InputHandler m_InputHandler;
 	DisplayManager m_DisplayManager;
+	ReplayJournal m_Journal;
+	BasicWhatIfAdvisor<Rules> m_Advisor;
+	StatePublisher* m_Publisher;
+	AutoSaver* m_AutoSaver;
+	bool m_Journaling;
 	
-	std::mt19937 m_RandomGenerator;
+	// 8 байт состояния вместо 2.5 КБ mt19937: новое зерно не требует пересчета таблицы
+	SplitMix64 m_RandomGenerator;
 };
 
+extern template class BasicGameEngine<DefaultRules>;
+extern template class BasicGameEngine<RuntimeRules>;
+
+// Игра по оригинальным правилам
+using GameEngine = BasicGameEngine<DefaultRules>;
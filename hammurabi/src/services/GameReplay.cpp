@@ -0,0 +1,147 @@
+#include "GameReplay.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <type_traits>
+
+template<typename Rules>
+BasicGameReplay<Rules>::BasicGameReplay()
+	: m_CheckpointInterval(1)
+{
+}
+
+template<typename Rules>
+bool BasicGameReplay<Rules>::Load(const std::filesystem::path& filePath)
+{
+	m_Records.clear();
+	m_Checkpoints.clear();
+
+	std::ifstream file(filePath, std::ios::in | std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	std::string content{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+	const char* cursor = content.data();
+	const char* end = content.data() + content.size();
+
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	CityState initialState;
+	if (end - cursor < (std::ptrdiff_t)(sizeof(uint32_t) * 3))
+		return false;
+	std::memcpy(&magic, cursor, sizeof(uint32_t));
+	std::memcpy(&version, cursor + sizeof(uint32_t), sizeof(uint32_t));
+	std::memcpy(&m_CheckpointInterval, cursor + sizeof(uint32_t) * 2, sizeof(uint32_t));
+	cursor += sizeof(uint32_t) * 3;
+
+	if (magic != ReplayFormat::MAGIC || version != ReplayFormat::VERSION || m_CheckpointInterval == 0)
+		return false;
+	if (!ReplayFormat::ReadRules(cursor, end, m_Rules) || !ReplayFormat::ReadState(cursor, end, initialState))
+		return false;
+
+	// Партия по чужим правилам разошлась бы с журналом без всякой ошибки
+	if constexpr (std::is_same_v<Rules, RuntimeRules>)
+	{
+		m_Engine.SetRules(m_Rules);
+	}
+	else
+	{
+		if (!(MakeRuntimeRules(m_Engine.GetRules()) == m_Rules))
+			return false;
+	}
+	m_Checkpoints.push_back(initialState);
+
+	// Оборванный последний кадр (партия не дописала журнал) просто отбрасываем
+	while (end - cursor >= (std::ptrdiff_t)sizeof(uint32_t))
+	{
+		uint32_t frameType = 0;
+		std::memcpy(&frameType, cursor, sizeof(uint32_t));
+		cursor += sizeof(uint32_t);
+
+		if (frameType == ReplayFormat::FRAME_ROUND)
+		{
+			RoundRecord record;
+			if (!ReplayFormat::ReadRecord(cursor, end, record))
+				break;
+			m_Records.push_back(record);
+		}
+		else if (frameType == ReplayFormat::FRAME_CHECKPOINT)
+		{
+			CityState checkpoint;
+			if (!ReplayFormat::ReadState(cursor, end, checkpoint))
+				break;
+			m_Checkpoints.push_back(checkpoint);
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template<typename Rules>
+const RuntimeRules& BasicGameReplay<Rules>::GetRules() const
+{
+	return m_Rules;
+}
+
+template<typename Rules>
+uint32_t BasicGameReplay<Rules>::GetFirstRound() const
+{
+	if (m_Records.empty())
+		return 0;
+	return m_Records.front().Round;
+}
+
+template<typename Rules>
+uint32_t BasicGameReplay<Rules>::GetLastRound() const
+{
+	if (m_Records.empty())
+		return 0;
+	return m_Records.back().Round;
+}
+
+template<typename Rules>
+size_t BasicGameReplay<Rules>::GetRoundCount() const
+{
+	return m_Records.size();
+}
+
+template<typename Rules>
+const RoundRecord* BasicGameReplay<Rules>::GetRecord(uint32_t round) const
+{
+	if (m_Records.empty() || round < GetFirstRound())
+		return nullptr;
+
+	size_t index = round - GetFirstRound();
+	if (index >= m_Records.size())
+		return nullptr;
+	return &m_Records[index];
+}
+
+template<typename Rules>
+bool BasicGameReplay<Rules>::GetStateAfterRound(uint32_t round, CityState& state)
+{
+	if (GetRecord(round) == nullptr)
+		return false;
+
+	size_t index = round - GetFirstRound();
+	size_t checkpoint = index / m_CheckpointInterval;
+	if (checkpoint >= m_Checkpoints.size())
+		checkpoint = m_Checkpoints.size() - 1;
+
+	m_Engine.m_State = m_Checkpoints[checkpoint];
+	for (size_t i = checkpoint * m_CheckpointInterval; i <= index; i++)
+	{
+		m_Engine.ReplayRound(m_Records[i]);
+	}
+
+	state = m_Engine.m_State;
+	return true;
+}
+
+template class BasicGameReplay<DefaultRules>;
+template class BasicGameReplay<RuntimeRules>;
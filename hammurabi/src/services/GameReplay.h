@@ -0,0 +1,41 @@
+#pragma once
+
+#include "../config/GameRules.h"
+#include "../domain/CityState.h"
+#include "GameEngine.h"
+#include "ReplayJournal.h"
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+// Восстановление состояния города по журналу партии.
+// Раунды пересчитываются шагами Process* движка с записанными случайными величинами,
+// а контрольные точки ограничивают пересчет CHECKPOINT_INTERVAL раундами.
+// Правила берутся из заголовка журнала: BasicGameReplay<RuntimeRules> повторяет
+// партию с любыми правилами, BasicGameReplay<DefaultRules> - только с исходными.
+template<typename Rules>
+class BasicGameReplay
+{
+public:
+	BasicGameReplay();
+
+	bool Load(const std::filesystem::path& filePath);
+	const RuntimeRules& GetRules() const;
+	uint32_t GetFirstRound() const;
+	uint32_t GetLastRound() const;
+	size_t GetRoundCount() const;
+	const RoundRecord* GetRecord(uint32_t round) const;
+	bool GetStateAfterRound(uint32_t round, CityState& state);
+
+private:
+	std::vector<RoundRecord> m_Records;
+	std::vector<CityState> m_Checkpoints;   // [0] - начальное состояние партии
+	uint32_t m_CheckpointInterval;
+	RuntimeRules m_Rules;                   // Правила из заголовка журнала
+	BasicGameEngine<Rules> m_Engine;
+};
+
+extern template class BasicGameReplay<DefaultRules>;
+extern template class BasicGameReplay<RuntimeRules>;
+
+using GameReplay = BasicGameReplay<DefaultRules>;
@@ -0,0 +1,354 @@
+#include "GameServer.h"
+#include "GameSession.h"
+#include <algorithm>
+#include <iostream>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <memory>
+#include <unordered_map>
+
+namespace
+{
+	constexpr int MAX_EVENTS = 256;
+	constexpr int WAIT_TIMEOUT_MS = 100;      // Как часто поток проверяет флаг остановки
+	constexpr size_t READ_CHUNK = 4096;
+	constexpr size_t MAX_LINE = 1024;         // Длиннее строки ввода не бывает - закрываем соединение
+
+	// Соединение с игроком, принадлежит одному потоку-обработчику
+	struct Connection
+	{
+		int Fd;
+		bool WantWrite;
+		std::string Input;
+		size_t OutputSent;
+		GameSession Session;
+	};
+
+	bool SetNonBlocking(int fd)
+	{
+		int flags = fcntl(fd, F_GETFL, 0);
+		return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+	}
+
+	// Отправка накопленного вывода; false - соединение надо закрыть
+	bool FlushOutput(int epollFd, Connection& connection)
+	{
+		std::string& output = connection.Session.GetOutput();
+		while (connection.OutputSent < output.size())
+		{
+			ssize_t written = send(connection.Fd, output.data() + connection.OutputSent,
+				output.size() - connection.OutputSent, MSG_NOSIGNAL);
+			if (written < 0)
+			{
+				if (errno == EAGAIN || errno == EWOULDBLOCK)
+					break;
+				if (errno == EINTR)
+					continue;
+				return false;
+			}
+			connection.OutputSent += (size_t)written;
+		}
+
+		bool pending = connection.OutputSent < output.size();
+		if (!pending)
+		{
+			output.clear();
+			connection.OutputSent = 0;
+		}
+
+		// Ждем EPOLLOUT только пока есть неотправленный хвост
+		if (pending != connection.WantWrite)
+		{
+			epoll_event event{};
+			event.events = pending ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+			event.data.ptr = &connection;
+			epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.Fd, &event);
+			connection.WantWrite = pending;
+		}
+		return true;
+	}
+
+	// Обработка всех полных строк ввода; в Input остается только хвост без '\n'
+	void HandleLines(Connection& connection)
+	{
+		size_t lineStart = 0;
+		size_t lineEnd = 0;
+		while ((lineEnd = connection.Input.find('\n', lineStart)) != std::string::npos)
+		{
+			std::string_view line(connection.Input.data() + lineStart, lineEnd - lineStart);
+			if (!line.empty() && line.back() == '\r')
+				line.remove_suffix(1);
+
+			connection.Session.HandleLine(line);
+			lineStart = lineEnd + 1;
+		}
+		connection.Input.erase(0, lineStart);
+	}
+
+	// Чтение и обработка ввода; false - соединение надо закрыть (после отправки вывода).
+	// Строки обрабатываются после каждого куска, поэтому Input не растет дальше
+	// MAX_LINE + READ_CHUNK, даже если клиент шлет данные быстрее, чем мы читаем.
+	bool HandleReadable(Connection& connection)
+	{
+		char chunk[READ_CHUNK];
+		while (true)
+		{
+			ssize_t received = recv(connection.Fd, chunk, sizeof(chunk), 0);
+			// Клиент закрыл запись: строки из прежних кусков уже обработаны
+			if (received == 0)
+				return false;
+			if (received < 0)
+			{
+				if (errno == EAGAIN || errno == EWOULDBLOCK)
+					return true;
+				if (errno == EINTR)
+					continue;
+				return false;
+			}
+
+			connection.Input.append(chunk, (size_t)received);
+			HandleLines(connection);
+			if (connection.Input.size() > MAX_LINE)
+				return false;
+		}
+	}
+
+	// SIGINT/SIGTERM: главный поток Run замечает флаг и останавливает сервер
+	volatile std::sig_atomic_t s_StopRequested = 0;
+
+	void RequestStop(int)
+	{
+		s_StopRequested = 1;
+	}
+}
+
+GameServer::GameServer(const ServerConfig& config)
+	: m_Config(config),
+	m_ListenFd(-1),
+	m_Running(false)
+{
+	if (m_Config.WorkerCount == 0)
+		m_Config.WorkerCount = std::max(1u, std::thread::hardware_concurrency());
+}
+
+GameServer::~GameServer()
+{
+	Stop();
+	if (m_ListenFd >= 0)
+		close(m_ListenFd);
+	if (!m_Config.UnixSocketPath.empty())
+		unlink(m_Config.UnixSocketPath.c_str());
+}
+
+bool GameServer::Run()
+{
+	if (!OpenListener())
+		return false;
+
+	// Остановка по сигналу, чтобы деструктор удалил сокет, а main записал таблицу рекордов
+	s_StopRequested = 0;
+	struct sigaction stopAction{};
+	stopAction.sa_handler = RequestStop;
+	sigemptyset(&stopAction.sa_mask);
+	struct sigaction oldInterrupt{};
+	struct sigaction oldTerminate{};
+	sigaction(SIGINT, &stopAction, &oldInterrupt);
+	sigaction(SIGTERM, &stopAction, &oldTerminate);
+
+	m_Running = true;
+	for (uint32_t i = 0; i < m_Config.WorkerCount; i++)
+	{
+		m_Workers.emplace_back(&GameServer::WorkerLoop, this);
+	}
+
+	std::cout << "Сервер запущен, потоков: " << m_Config.WorkerCount << std::endl;
+	while (m_Running)
+	{
+		if (s_StopRequested)
+			Stop();
+		else
+			std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_TIMEOUT_MS));
+	}
+
+	for (std::thread& worker : m_Workers)
+	{
+		worker.join();
+	}
+	m_Workers.clear();
+
+	sigaction(SIGINT, &oldInterrupt, nullptr);
+	sigaction(SIGTERM, &oldTerminate, nullptr);
+	std::cout << "Сервер остановлен" << std::endl;
+	return true;
+}
+
+void GameServer::Stop()
+{
+	m_Running = false;
+}
+
+bool GameServer::OpenListener()
+{
+	if (!m_Config.UnixSocketPath.empty())
+	{
+		sockaddr_un address{};
+		if (m_Config.UnixSocketPath.size() >= sizeof(address.sun_path))
+			return false;
+
+		m_ListenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (m_ListenFd < 0)
+			return false;
+
+		address.sun_family = AF_UNIX;
+		std::memcpy(address.sun_path, m_Config.UnixSocketPath.c_str(), m_Config.UnixSocketPath.size());
+		unlink(m_Config.UnixSocketPath.c_str());
+		if (bind(m_ListenFd, (sockaddr*)&address, sizeof(address)) != 0)
+			return false;
+	}
+	else
+	{
+		m_ListenFd = socket(AF_INET, SOCK_STREAM, 0);
+		if (m_ListenFd < 0)
+			return false;
+
+		int enable = 1;
+		setsockopt(m_ListenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+		sockaddr_in address{};
+		address.sin_family = AF_INET;
+		address.sin_addr.s_addr = htonl(INADDR_ANY);
+		address.sin_port = htons(m_Config.Port);
+		if (bind(m_ListenFd, (sockaddr*)&address, sizeof(address)) != 0)
+			return false;
+	}
+
+	return SetNonBlocking(m_ListenFd) && listen(m_ListenFd, SOMAXCONN) == 0;
+}
+
+void GameServer::WorkerLoop()
+{
+	int epollFd = epoll_create1(0);
+	if (epollFd < 0)
+		return;
+
+	// Слушающий сокет общий: EPOLLEXCLUSIVE будит только один из потоков
+	epoll_event listenEvent{};
+	listenEvent.events = EPOLLIN | EPOLLEXCLUSIVE;
+	listenEvent.data.ptr = nullptr;
+	epoll_ctl(epollFd, EPOLL_CTL_ADD, m_ListenFd, &listenEvent);
+
+	std::unordered_map<int, std::unique_ptr<Connection>> connections;
+	epoll_event events[MAX_EVENTS];
+
+	auto closeConnection = [&](Connection* connection)
+	{
+		epoll_ctl(epollFd, EPOLL_CTL_DEL, connection->Fd, nullptr);
+		close(connection->Fd);
+		connections.erase(connection->Fd);
+	};
+
+	while (m_Running)
+	{
+		int count = epoll_wait(epollFd, events, MAX_EVENTS, WAIT_TIMEOUT_MS);
+		for (int i = 0; i < count; i++)
+		{
+			if (events[i].data.ptr == nullptr)
+			{
+				int clientFd = -1;
+				while ((clientFd = accept4(m_ListenFd, nullptr, nullptr, SOCK_NONBLOCK)) >= 0)
+				{
+					if (m_Config.UnixSocketPath.empty())
+					{
+						int enable = 1;
+						setsockopt(clientFd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+					}
+
+					auto connection = std::make_unique<Connection>();
+					connection->Fd = clientFd;
+					connection->WantWrite = false;
+					connection->OutputSent = 0;
+
+					epoll_event event{};
+					event.events = EPOLLIN;
+					event.data.ptr = connection.get();
+					epoll_ctl(epollFd, EPOLL_CTL_ADD, clientFd, &event);
+
+					Connection& added = *connection;
+					connections.emplace(clientFd, std::move(connection));
+
+					added.Session.Start();
+					if (!FlushOutput(epollFd, added))
+						closeConnection(&added);
+				}
+				continue;
+			}
+
+			Connection* connection = (Connection*)events[i].data.ptr;
+			bool alive = (events[i].events & (EPOLLERR | EPOLLHUP)) == 0;
+
+			// Ответ на последние строки уходит и клиенту, который уже закрыл запись
+			bool reading = true;
+			if (alive && (events[i].events & EPOLLIN))
+				reading = HandleReadable(*connection);
+			if (alive)
+				alive = FlushOutput(epollFd, *connection);
+
+			if (!alive || !reading)
+				closeConnection(connection);
+		}
+	}
+
+	for (auto& entry : connections)
+	{
+		close(entry.first);
+	}
+	close(epollFd);
+}
+
+#else
+
+GameServer::GameServer(const ServerConfig& config)
+	: m_Config(config),
+	m_ListenFd(-1),
+	m_Running(false)
+{
+}
+
+GameServer::~GameServer()
+{
+}
+
+bool GameServer::Run()
+{
+	std::cout << "Серверный режим доступен только в Linux.\n";
+	return false;
+}
+
+void GameServer::Stop()
+{
+	m_Running = false;
+}
+
+bool GameServer::OpenListener()
+{
+	return false;
+}
+
+void GameServer::WorkerLoop()
+{
+}
+
+#endif
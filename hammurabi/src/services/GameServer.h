@@ -0,0 +1,39 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Параметры игрового сервера
+struct ServerConfig
+{
+	std::string UnixSocketPath;   // Если задан, слушаем Unix-сокет вместо TCP
+	uint16_t Port;                // TCP-порт
+	uint32_t WorkerCount;         // Потоков-обработчиков (0 - по числу ядер)
+};
+
+// Многопользовательский сервер: каждая сессия - неблокирующий GameSession.
+// Каждый поток-обработчик ведет свой epoll и свои сессии; принятое соединение
+// навсегда остается в потоке, который его принял, поэтому блокировок между потоками нет.
+// Доступен только в Linux.
+class GameServer
+{
+public:
+	explicit GameServer(const ServerConfig& config);
+	~GameServer();
+
+	bool Run();
+	void Stop();
+
+private:
+	bool OpenListener();
+	void WorkerLoop();
+
+private:
+	ServerConfig m_Config;
+	int m_ListenFd;
+	std::atomic<bool> m_Running;
+	std::vector<std::thread> m_Workers;
+};
@@ -0,0 +1,101 @@
+#include "GameSession.h"
+#include "Leaderboard.h"
+#include "../config/GameConfig.h"
+#include "../utils/SplitMix64.h"
+#include <atomic>
+#include <utility>
+
+namespace
+{
+	std::atomic<uint64_t> s_NextSessionId{ 0 };
+}
+
+GameSession::GameSession()
+	: m_InputHandler(m_Messages),
+	m_Decisions(),
+	m_SessionId(s_NextSessionId.fetch_add(1, std::memory_order_relaxed)),
+	m_GamesStarted(0)
+{
+}
+
+void GameSession::Start()
+{
+	// Старая задача ссылается на состояние прежнего движка
+	m_Task = DecisionTask();
+
+	// Свое зерно у каждой партии каждой сессии; следующие партии сессии играются на том же движке
+	uint64_t sessionSeed = SplitMix64::MakeSeed(SplitMix64::GetProcessSeed(), m_SessionId);
+	uint64_t seed = SplitMix64::MakeSeed(sessionSeed, m_GamesStarted++);
+	if (m_Engine)
+		m_Engine->Reset(seed);
+	else
+		m_Engine = GameEnginePool::Acquire(seed);
+	BeginRound();
+}
+
+void GameSession::HandleLine(std::string_view line)
+{
+	if (!m_Engine || !m_Input.IsWaiting())
+		return;
+
+	m_Input.Push(line);
+	FlushMessages();
+
+	if (m_Task.IsDone())
+		FinishRound();
+}
+
+std::string& GameSession::GetOutput()
+{
+	return m_Output;
+}
+
+void GameSession::BeginRound()
+{
+	m_DisplayManager.InvalidateFrame();
+	m_Output.append(m_DisplayManager.ComposeRoundStart(m_Engine->GetState()));
+	m_Engine->StartRound();
+
+	// Корутина сразу задает первый вопрос и засыпает до ответа
+	m_Task = m_InputHandler.AwaitPlayerDecisions(DecisionBounds(m_Engine->GetState(), m_Engine->GetRules()), m_Input, m_Decisions);
+	FlushMessages();
+}
+
+void GameSession::FinishRound()
+{
+	m_Engine->PlayRound(m_Decisions);
+
+	if (m_Engine->CheckGameOver())
+	{
+		Leaderboard::Instance().Record(m_Engine->GetState(), m_Engine->GetStats(), true);
+		m_Output.append(GameConfig::Messages::GAME_OVER_HUNGER);
+		Start();
+		return;
+	}
+
+	m_Engine->AdvanceRound();
+	if (m_Engine->IsCompleted())
+	{
+		Leaderboard::Instance().Record(m_Engine->GetState(), m_Engine->GetStats(), false);
+		m_Output.append(GameConfig::Messages::GAME_FINISHED);
+		m_Output.append(m_DisplayManager.GetRatingText(m_Engine->GetState(), m_Engine->GetStats()));
+		Start();
+		return;
+	}
+
+	BeginRound();
+}
+
+void GameSession::FlushMessages()
+{
+	// Отказы валидаторов и вопросы идут в порядке вывода
+	if (m_Messages.view().empty())
+		return;
+
+	m_Output.append(m_Messages.view());
+
+	// Буфер потока возвращается ему же пустым: емкость сохраняется между раундами
+	std::string buffer = std::move(m_Messages).str();
+	buffer.clear();
+	m_Messages.str(std::move(buffer));
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "../domain/PlayerDecisions.h"
+#include "EnginePool.h"
+#include "GameEngine.h"
+#include "InputHandler.h"
+#include "DisplayManager.h"
+#include "DecisionTask.h"
+#include "InputChannel.h"
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+// Партия сетевого игрока без выделенного потока.
+// Опрос раунда идет корутиной InputHandler::AwaitPlayerDecisions: каждая строка
+// ввода возобновляет ее до следующего вопроса, а весь вывод (кадр раунда,
+// отказы, вопросы) копится в буфере для отправки в сокет.
+class GameSession
+{
+public:
+	GameSession();
+
+	void Start();
+	void HandleLine(std::string_view line);
+	std::string& GetOutput();
+
+private:
+	void BeginRound();
+	void FinishRound();
+	void FlushMessages();
+
+private:
+	GameEnginePool::Handle m_Engine;    // Берется из пула потока при первой партии
+	std::ostringstream m_Messages;      // Вывод InputHandler (вопросы и отказы)
+	InputHandler m_InputHandler;
+	DisplayManager m_DisplayManager;
+	PlayerDecisions m_Decisions;
+	InputChannel m_Input;
+	DecisionTask m_Task;                // Ссылается на m_Engine, m_Input и m_Decisions
+	std::string m_Output;
+	uint64_t m_SessionId;               // Номер сессии в процессе, ключ зерна партий
+	uint64_t m_GamesStarted;
+};
@@ -0,0 +1,50 @@
+#include "InputChannel.h"
+#include <utility>
+
+InputChannel::LineAwaiter::LineAwaiter(InputChannel& channel)
+	: m_Channel(channel)
+{
+}
+
+bool InputChannel::LineAwaiter::await_ready() const noexcept
+{
+	return m_Channel.m_HasLine;
+}
+
+void InputChannel::LineAwaiter::await_suspend(std::coroutine_handle<> handle) noexcept
+{
+	m_Channel.m_Waiter = handle;
+}
+
+std::string InputChannel::LineAwaiter::await_resume()
+{
+	m_Channel.m_HasLine = false;
+	return std::move(m_Channel.m_Line);
+}
+
+InputChannel::InputChannel()
+	: m_HasLine(false)
+{
+}
+
+InputChannel::LineAwaiter InputChannel::NextLine()
+{
+	return LineAwaiter(*this);
+}
+
+void InputChannel::Push(std::string_view line)
+{
+	m_Line.assign(line);
+	m_HasLine = true;
+
+	// Возобновляем корутину в текущем потоке: она дойдет до следующего вопроса
+	std::coroutine_handle<> waiter = m_Waiter;
+	m_Waiter = nullptr;
+	if (waiter)
+		waiter.resume();
+}
+
+bool InputChannel::IsWaiting() const
+{
+	return (bool)m_Waiter;
+}
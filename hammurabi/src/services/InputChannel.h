@@ -0,0 +1,38 @@
+#pragma once
+
+#include <coroutine>
+#include <string>
+#include <string_view>
+
+// Канал строк ввода для корутины: co_await NextLine() приостанавливает
+// корутину, пока снаружи не будет передана строка через Push().
+// Хранит не больше одной строки - корутина забирает ее до следующего Push().
+class InputChannel
+{
+public:
+	class LineAwaiter
+	{
+	public:
+		explicit LineAwaiter(InputChannel& channel);
+
+		bool await_ready() const noexcept;
+		void await_suspend(std::coroutine_handle<> handle) noexcept;
+		std::string await_resume();
+
+	private:
+		InputChannel& m_Channel;
+	};
+
+	InputChannel();
+	InputChannel(const InputChannel&) = delete;
+	InputChannel& operator=(const InputChannel&) = delete;
+
+	LineAwaiter NextLine();
+	void Push(std::string_view line);
+	bool IsWaiting() const;
+
+private:
+	std::string m_Line;
+	std::coroutine_handle<> m_Waiter;   // Корутина, ждущая строку
+	bool m_HasLine;
+};
@@ -5,152 +5,177 @@
 #include <algorithm>
 
 InputHandler::InputHandler()
+	: m_Out(std::cout),
+	m_Script(nullptr)
 {
 }
 
-PlayerDecisions InputHandler::GetPlayerDecisions(const CityState& state) const
+InputHandler::InputHandler(std::ostream& out)
+	: m_Out(out),
+	m_Script(nullptr)
 {
-	PlayerDecisions decisions;
-	decisions.BuyLand = 0;
-	decisions.SellLand = 0;
-	decisions.WheatForFood = 0;
-	decisions.AcresToPlant = 0;
-	
-	bool boughtLand = false;
-	decisions.BuyLand = GetBuyLand(state);
-	if (decisions.BuyLand > 0)
-	{
-		boughtLand = true;
-	}
-	
-	if (!boughtLand)
+}
+
+PlayerDecisions InputHandler::GetPlayerDecisions(const DecisionBounds& bounds) const
+{
+	PlayerDecisions decisions{};
+	for (DecisionField field : DECISION_FIELDS)
 	{
-		decisions.SellLand = GetSellLand(state);
+		if (IsAsked(field, decisions))
+			AskDecision(field, bounds, decisions);
 	}
-	
-	decisions.WheatForFood = GetWheatForFood(state);
-	decisions.AcresToPlant = GetAcresToPlant(state);
-	
 	return decisions;
 }
 
-int32_t InputHandler::GetBuyLand(const CityState& state) const
+DecisionTask InputHandler::AwaitPlayerDecisions(DecisionBounds bounds, InputChannel& input, PlayerDecisions& decisions) const
 {
-	std::string input;
-	while (true)
+	decisions = PlayerDecisions{};
+	int32_t value = 0;
+	
+	for (DecisionField field : DECISION_FIELDS)
 	{
-		std::cout << "\nСколько акров земли повелеваешь купить? ";
-		int32_t buyAmount = ProcessIntegerInput(input, GameConfig::Messages::INTEGER_INPUT_ERROR);
-		
-		if (buyAmount <= 0)
-			return 0;
+		if (!IsAsked(field, decisions))
+			continue;
 		
-		if (ValidateBuyLand(buyAmount, state))
-			return buyAmount;
+		while (true)
+		{
+			m_Out << GetPrompt(field);
+			if (!TryParseInteger(co_await input.NextLine(), value))
+			{
+				m_Out << GameConfig::Messages::INTEGER_INPUT_ERROR;
+				continue;
+			}
+			if (AcceptAnswer(field, value, bounds, decisions))
+				break;
+		}
 	}
 }
 
-int32_t InputHandler::GetSellLand(const CityState& state) const
+const std::string& InputHandler::GetPrompt(DecisionField field)
 {
-	std::string input;
-	while (true)
+	switch (field)
 	{
-		std::cout << "Сколько акров земли повелеваешь продать? ";
-		int32_t sellAmount = ProcessIntegerInput(input, GameConfig::Messages::INTEGER_INPUT_ERROR);
-		
-		if (sellAmount <= 0)
-			return 0;
-		
-		if (ValidateSellLand(sellAmount, state))
-			return sellAmount;
+	case DecisionField::BuyLand:
+		return GameConfig::Messages::BUY_LAND_PROMPT;
+	case DecisionField::SellLand:
+		return GameConfig::Messages::SELL_LAND_PROMPT;
+	case DecisionField::WheatForFood:
+		return GameConfig::Messages::WHEAT_FOR_FOOD_PROMPT;
+	case DecisionField::AcresToPlant:
+		break;
 	}
+	return GameConfig::Messages::ACRES_TO_PLANT_PROMPT;
 }
 
-int32_t InputHandler::GetWheatForFood(const CityState& state) const
+bool InputHandler::IsAsked(DecisionField field, const PlayerDecisions& decisions)
 {
-	std::string input;
-	while (true)
+	// Купивший землю не продает ее в том же раунде
+	return field != DecisionField::SellLand || decisions.BuyLand == 0;
+}
+
+bool InputHandler::AcceptAnswer(DecisionField field, int32_t value, const DecisionBounds& bounds, PlayerDecisions& decisions) const
+{
+	// Ноль, отрицательное число и конец ввода - отказ от этого решения
+	if (value <= 0)
+		return true;
+	
+	switch (field)
 	{
-		std::cout << "Сколько бушелей пшеницы повелеваешь съесть? ";
-		int32_t wheatAmount = ProcessIntegerInput(input, GameConfig::Messages::INTEGER_INPUT_ERROR);
-		
-		if (ValidateWheatForFood(wheatAmount, state))
-			return wheatAmount;
+	case DecisionField::BuyLand:
+		if (!ValidateBuyLand(value, bounds))
+			return false;
+		decisions.BuyLand = value;
+		return true;
+	case DecisionField::SellLand:
+		if (!ValidateSellLand(value, bounds))
+			return false;
+		decisions.SellLand = value;
+		return true;
+	case DecisionField::WheatForFood:
+		if (!ValidateWheatForFood(value, bounds, decisions))
+			return false;
+		decisions.WheatForFood = value;
+		return true;
+	case DecisionField::AcresToPlant:
+		if (!ValidateAcresToPlant(value, bounds, decisions))
+			return false;
+		decisions.AcresToPlant = value;
+		return true;
 	}
+	return true;
 }
 
-int32_t InputHandler::GetAcresToPlant(const CityState& state) const
+void InputHandler::AskDecision(DecisionField field, const DecisionBounds& bounds, PlayerDecisions& decisions) const
 {
 	std::string input;
-	while (true)
+	do
 	{
-		std::cout << "Сколько акров земли повелеваешь засеять? ";
-		int32_t acres = ProcessIntegerInput(input, GameConfig::Messages::INTEGER_INPUT_ERROR);
-		
-		if (ValidateAcresToPlant(acres, state))
-			return acres;
+		m_Out << GetPrompt(field);
 	}
+	while (!AcceptAnswer(field, ReadInteger(input), bounds, decisions));
 }
 
-bool InputHandler::ValidateBuyLand(int32_t buyAmount, const CityState& state) const
+bool InputHandler::ValidateBuyLand(int32_t buyAmount, const DecisionBounds& bounds) const
 {
-	uint32_t cost = buyAmount * state.AcrePrice;
-	if (cost > state.WheatReserves)
+	if (buyAmount > bounds.GetMaxBuy())
 	{
-		std::cout << "Правитель, у нас нет столько пшена. У нас "
-			<< state.WheatReserves << ", а вы хотите потратить " << cost << ".\n";
+		m_Out << "Правитель, у нас нет столько пшена. У нас "
+			<< bounds.GetWheatAfterTrade(PlayerDecisions{}) << ", а вы хотите потратить "
+			<< (int64_t)buyAmount * bounds.GetAcrePrice() << ".\n";
 		return false;
 	}
 	return true;
 }
 
-bool InputHandler::ValidateSellLand(int32_t sellAmount, const CityState& state) const
+bool InputHandler::ValidateSellLand(int32_t sellAmount, const DecisionBounds& bounds) const
 {
-	if (sellAmount > state.Area)
+	if (sellAmount > bounds.GetMaxSell())
 	{
-		std::cout << "Правитель, у нас нет столько земель. У нас всего "
-			<< state.Area << " акров.\n";
+		m_Out << "Правитель, у нас нет столько земель. У нас всего "
+			<< bounds.GetMaxSell() << " акров.\n";
 		return false;
 	}
 	return true;
 }
 
-bool InputHandler::ValidateWheatForFood(int32_t wheatAmount, const CityState& state) const
+bool InputHandler::ValidateWheatForFood(int32_t wheatAmount, const DecisionBounds& bounds, const PlayerDecisions& decisions) const
 {
-	if (wheatAmount > state.WheatReserves)
+	// Пшеница считается уже после покупки или продажи земли
+	int32_t maxFood = bounds.GetMaxFood(decisions);
+	if (wheatAmount > maxFood)
 	{
-		std::cout << "Правитель, у нас нет столько пшена. У нас всего "
-			<< state.WheatReserves << " бушелей.\n";
+		m_Out << "Правитель, у нас нет столько пшена. У нас всего "
+			<< maxFood << " бушелей.\n";
 		return false;
 	}
 	return true;
 }
 
-bool InputHandler::ValidateAcresToPlant(int32_t acres, const CityState& state) const
+bool InputHandler::ValidateAcresToPlant(int32_t acres, const DecisionBounds& bounds, const PlayerDecisions& decisions) const
 {
-	float seedsFloat = acres * GameConfig::Game::SEEDS_PER_ACRE;
-	uint32_t seedsNeeded = (uint32_t)seedsFloat;
-	uint32_t maxAcresByPeople = state.Population * GameConfig::Game::ACRES_PER_PERSON;
+	int64_t seedBudget = bounds.GetSeedBudget(decisions);
+	int64_t maxAcresByPeople = bounds.GetMaxAcresByPeople();
+	int64_t area = bounds.GetAreaAfterTrade(decisions);
 	
-	if (seedsNeeded > state.WheatReserves)
+	if (bounds.SeedsFor(acres) > seedBudget)
 	{
-		std::cout << "Правитель, помилуй, у нас нет столько пшена для семян. У нас всего "
-			<< state.WheatReserves << " бушелей.\n";
+		m_Out << "Правитель, помилуй, у нас нет столько пшена для семян. У нас всего "
+			<< seedBudget << " бушелей.\n";
 		return false;
 	}
 	
-	if (acres > (int32_t)maxAcresByPeople)
+	if (acres > maxAcresByPeople)
 	{
-		std::cout << "Правитель, помилуй, у нас нет столько людей. У нас всего "
-			<< state.Population << " человек, которые могут обработать "
+		m_Out << "Правитель, помилуй, у нас нет столько людей. У нас всего "
+			<< bounds.GetPopulation() << " человек, которые могут обработать "
 			<< maxAcresByPeople << " акров.\n";
 		return false;
 	}
 	
-	if (acres > (int32_t)state.Area)
+	if (acres > area)
 	{
-		std::cout << "Правитель, помилуй, у нас нет столько земли. У нас всего "
-			<< state.Area << " акров.\n";
+		m_Out << "Правитель, помилуй, у нас нет столько земли. У нас всего "
+			<< area << " акров.\n";
 		return false;
 	}
 	
@@ -159,7 +184,53 @@ bool InputHandler::ValidateAcresToPlant(int32_t acres, const CityState& state) c
 
 bool InputHandler::RequestSave() const
 {
-	std::cout << GameConfig::Messages::SAVE_ROUND_PROMPT;
+	// Партия по сценарию не прерывается на сохранение
+	if (m_Script != nullptr)
+		return false;
+	
+	m_Out << GameConfig::Messages::SAVE_ROUND_PROMPT;
 	return ProcessOneshotInput();
 }
 
+bool InputHandler::RequestConfirm() const
+{
+	if (m_Script != nullptr)
+		return true;
+	
+	m_Out << GameConfig::Messages::CONFIRM_DECISIONS_PROMPT;
+	return ProcessOneshotInput();
+}
+
+void InputHandler::WaitForKey() const
+{
+	if (m_Script == nullptr)
+		ProcessOneshotInput(false);
+}
+
+void InputHandler::SetScript(ScriptedInput* script)
+{
+	m_Script = script;
+}
+
+bool InputHandler::IsScripted() const
+{
+	return m_Script != nullptr;
+}
+
+int32_t InputHandler::ReadInteger(std::string& input) const
+{
+	if (m_Script == nullptr)
+		return ProcessIntegerInput(input, GameConfig::Messages::INTEGER_INPUT_ERROR);
+	
+	// Как и с консоли: нечисловой ответ - отказ и следующий, конец ввода - -1
+	std::string_view token;
+	while (m_Script->NextToken(token))
+	{
+		int32_t value = 0;
+		if (TryParseInteger(token, value))
+			return value;
+		m_Out << GameConfig::Messages::INTEGER_INPUT_ERROR;
+	}
+	return -1;
+}
+
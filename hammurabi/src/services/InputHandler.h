@@ -1,32 +1,63 @@
 #pragma once
 
 #include "../domain/CityState.h"
+#include "../domain/DecisionBounds.h"
+#include "../domain/PlayerDecisions.h"
+#include "DecisionTask.h"
+#include "InputChannel.h"
+#include "ScriptedInput.h"
 #include <cstdint>
+#include <iostream>
 #include <string>
 
-struct PlayerDecisions
-{
-	int32_t BuyLand;
-	int32_t SellLand;
-	int32_t WheatForFood;
-	int32_t AcresToPlant;
-};
-
 class InputHandler
 {
 public:
 	InputHandler();
-	PlayerDecisions GetPlayerDecisions(const CityState& state) const;
+	explicit InputHandler(std::ostream& out);
+	PlayerDecisions GetPlayerDecisions(const DecisionBounds& bounds) const;
+	// Неблокирующий вариант: вопросы задаются по мере поступления строк в input,
+	// решения пишутся в decisions, по последнему ответу задача завершается.
+	// Границы берутся по значению: задача переживает вызов и держит их в своем кадре
+	DecisionTask AwaitPlayerDecisions(DecisionBounds bounds, InputChannel& input, PlayerDecisions& decisions) const;
 	bool RequestSave() const;
+	// Подтверждение решений после прогноза советника; сценарий подтверждает всегда
+	bool RequestConfirm() const;
+	// Пауза "нажмите любую клавишу"; в режиме сценария пропускается
+	void WaitForKey() const;
+	
+	// Ответы берутся из сценария вместо консоли; nullptr - снова консоль
+	void SetScript(ScriptedInput* script);
+	bool IsScripted() const;
+	
+	// Проверки учитывают уже принятые в раунде решения (decisions)
+	bool ValidateBuyLand(int32_t buyAmount, const DecisionBounds& bounds) const;
+	bool ValidateSellLand(int32_t sellAmount, const DecisionBounds& bounds) const;
+	bool ValidateWheatForFood(int32_t wheatAmount, const DecisionBounds& bounds, const PlayerDecisions& decisions) const;
+	bool ValidateAcresToPlant(int32_t acres, const DecisionBounds& bounds, const PlayerDecisions& decisions) const;
+
+private:
+	// Вопросы раунда в порядке опроса
+	enum class DecisionField
+	{
+		BuyLand,
+		SellLand,
+		WheatForFood,
+		AcresToPlant
+	};
+	static constexpr DecisionField DECISION_FIELDS[] = {
+		DecisionField::BuyLand, DecisionField::SellLand, DecisionField::WheatForFood, DecisionField::AcresToPlant };
+	
+	// Общие шаги обоих вариантов опроса: вопрос, нужен ли он, разбор ответа.
+	// AcceptAnswer возвращает false, если ответ отвергнут и вопрос надо повторить
+	static const std::string& GetPrompt(DecisionField field);
+	static bool IsAsked(DecisionField field, const PlayerDecisions& decisions);
+	bool AcceptAnswer(DecisionField field, int32_t value, const DecisionBounds& bounds, PlayerDecisions& decisions) const;
+	void AskDecision(DecisionField field, const DecisionBounds& bounds, PlayerDecisions& decisions) const;
+	int32_t ReadInteger(std::string& input) const;
 
 private:
-	int32_t GetBuyLand(const CityState& state) const;
-	int32_t GetSellLand(const CityState& state) const;
-	int32_t GetWheatForFood(const CityState& state) const;
-	int32_t GetAcresToPlant(const CityState& state) const;
-	bool ValidateBuyLand(int32_t buyAmount, const CityState& state) const;
-	bool ValidateSellLand(int32_t sellAmount, const CityState& state) const;
-	bool ValidateWheatForFood(int32_t wheatAmount, const CityState& state) const;
-	bool ValidateAcresToPlant(int32_t acres, const CityState& state) const;
+	std::ostream& m_Out;    // Куда пишутся вопросы и отказы (консоль или сетевая сессия)
+	ScriptedInput* m_Script;
 };
 
@@ -0,0 +1,305 @@
+#include "Leaderboard.h"
+#include <algorithm>
+#include <fstream>
+#include <system_error>
+
+namespace
+{
+	constexpr uint32_t SNAPSHOT_MAGIC = 0x424C4D48;     // "HMLB"
+	constexpr uint32_t SNAPSHOT_VERSION = 1;
+	constexpr uint32_t HISTOGRAM_ACRES = GameConfig::Leaderboard::HISTOGRAM_ACRES;
+	constexpr uint32_t DEAD_PERCENTS = 101;             // Средняя доля умерших 0..100%
+	constexpr size_t BUCKETS = (size_t)OutcomeClass::Count * HISTOGRAM_ACRES * DEAD_PERCENTS;
+	constexpr uint64_t ACRES_MASK = 0xFFFFFF;
+	constexpr uint64_t DEAD_MASK = 0xFFFFFFFF;
+
+	std::atomic<size_t> s_NextShard{0};
+
+	bool IsBetter(const LeaderboardEntry& a, const LeaderboardEntry& b)
+	{
+		// При равном итоге выше та партия, что сыграна раньше
+		return a.Score != b.Score ? a.Score > b.Score : a.GameId < b.GameId;
+	}
+}
+
+Leaderboard& Leaderboard::Instance()
+{
+	static Leaderboard instance;
+	return instance;
+}
+
+Leaderboard::Leaderboard()
+	: m_Histogram(BUCKETS + 1),
+	m_GameCount(0),
+	m_SnapshotPeriod(GameConfig::Leaderboard::SNAPSHOT_SECONDS),
+	m_SnapshotStopping(false)
+{
+	for (Shard& shard : m_Shards)
+	{
+		shard.Top.reserve(TOP_CAPACITY + 1);
+		shard.Threshold.store(0, std::memory_order_relaxed);
+	}
+}
+
+Leaderboard::~Leaderboard()
+{
+	StopSnapshots();
+}
+
+uint64_t Leaderboard::MakeScore(OutcomeClass outcome, int32_t acresPerPerson, EconomyFixed averageDead)
+{
+	// Класс итога в старших битах, затем акры на жителя, затем доля умерших наоборот
+	uint64_t acres = (uint64_t)std::clamp<int64_t>(acresPerPerson, 0, (int64_t)ACRES_MASK);
+	uint64_t dead = (uint64_t)std::clamp<int64_t>(averageDead.GetRaw(), 0, (int64_t)DEAD_MASK);
+	return (uint64_t)outcome << 56 | acres << 32 | (DEAD_MASK - dead);
+}
+
+OutcomeClass Leaderboard::GetOutcomeClass(uint64_t score)
+{
+	return (OutcomeClass)(score >> 56);
+}
+
+void Leaderboard::Record(const CityState& state, const GameStatistics& stats, bool overthrown)
+{
+	OutcomeClass outcome = OutcomeClass::Overthrown;
+	if (!overthrown)
+		outcome = (OutcomeClass)((uint32_t)stats.GetRating(state.Area, state.Population) + 1);
+
+	EconomyFixed averageDead = stats.CalculateAverageDeadFromHunger();
+	uint64_t score = MakeScore(outcome, stats.CalculateAcresPerPerson(state.Area, state.Population), averageDead);
+	Insert(score, state.Population, state.Area, averageDead);
+}
+
+void Leaderboard::Insert(uint64_t score, Quantity population, Quantity area, EconomyFixed averageDead)
+{
+	uint64_t gameId = m_GameCount.fetch_add(1, std::memory_order_relaxed) + 1;
+	AddToHistogram(GetBucket(score), 1);
+
+	// Поток пишет всегда в одну и ту же часть, разные потоки - в разные
+	thread_local size_t shardIndex = s_NextShard.fetch_add(1, std::memory_order_relaxed) % SHARDS;
+	Shard& shard = m_Shards[shardIndex];
+	if (score <= shard.Threshold.load(std::memory_order_relaxed))
+		return;
+
+	InsertEntry(shard, LeaderboardEntry{ score, gameId, population, area, averageDead });
+}
+
+void Leaderboard::GetTop(size_t k, std::vector<LeaderboardEntry>& top) const
+{
+	k = std::min(k, TOP_CAPACITY);
+	top.clear();
+	for (const Shard& shard : m_Shards)
+	{
+		std::lock_guard<std::mutex> lock(shard.Mutex);
+		size_t count = std::min(k, shard.Top.size());
+		top.insert(top.end(), shard.Top.begin(), shard.Top.begin() + count);
+	}
+
+	k = std::min(k, top.size());
+	std::partial_sort(top.begin(), top.begin() + k, top.end(), IsBetter);
+	top.resize(k);
+}
+
+double Leaderboard::GetPercentileRank(uint64_t score) const
+{
+	uint64_t games = m_GameCount.load(std::memory_order_relaxed);
+	if (games == 0)
+		return 0.0;
+	return std::min(1.0, (double)GetCountBelow(GetBucket(score)) / (double)games);
+}
+
+uint64_t Leaderboard::GetGameCount() const
+{
+	return m_GameCount.load(std::memory_order_relaxed);
+}
+
+bool Leaderboard::SaveSnapshot(const std::filesystem::path& filePath) const
+{
+	std::vector<LeaderboardEntry> top;
+	top.reserve(SHARDS * TOP_CAPACITY);
+	for (const Shard& shard : m_Shards)
+	{
+		std::lock_guard<std::mutex> lock(shard.Mutex);
+		top.insert(top.end(), shard.Top.begin(), shard.Top.end());
+	}
+	std::sort(top.begin(), top.end(), IsBetter);
+
+	// Снимок пишется рядом и подменяет старый целиком: прерванная запись его не портит
+	std::filesystem::path tempPath = filePath;
+	tempPath += ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::out | std::ios::trunc);
+		if (!file.is_open())
+			return false;
+
+		file << SNAPSHOT_MAGIC << ' ' << SNAPSHOT_VERSION << ' ' << BUCKETS << ' '
+			<< m_GameCount.load(std::memory_order_relaxed) << '\n';
+
+		// Дерево Фенвика линейно, поэтому хранится как есть - ненулевыми узлами
+		size_t nodes = 0;
+		for (size_t i = 1; i <= BUCKETS; i++)
+		{
+			nodes += m_Histogram[i].load(std::memory_order_relaxed) != 0 ? 1 : 0;
+		}
+		file << nodes << '\n';
+		for (size_t i = 1; i <= BUCKETS; i++)
+		{
+			uint64_t value = m_Histogram[i].load(std::memory_order_relaxed);
+			if (value != 0)
+				file << i << ' ' << value << '\n';
+		}
+
+		file << top.size() << '\n';
+		for (const LeaderboardEntry& entry : top)
+		{
+			file << entry.Score << ' ' << entry.GameId << ' ' << entry.Population << ' '
+				<< entry.Area << ' ' << entry.AverageDead.GetRaw() << '\n';
+		}
+		if (!file)
+			return false;
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(tempPath, filePath, ec);
+	return !ec;
+}
+
+bool Leaderboard::LoadSnapshot(const std::filesystem::path& filePath)
+{
+	std::ifstream file(filePath);
+	if (!file.is_open())
+		return false;
+
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	size_t buckets = 0;
+	uint64_t games = 0;
+	if (!(file >> magic >> version >> buckets >> games) || magic != SNAPSHOT_MAGIC
+		|| version != SNAPSHOT_VERSION || buckets != BUCKETS)
+		return false;
+
+	// Сначала весь файл читается во временные буферы: битый снимок таблицу не меняет
+	size_t nodeCount = 0;
+	if (!(file >> nodeCount) || nodeCount > BUCKETS)
+		return false;
+	std::vector<std::pair<size_t, uint64_t>> nodes(nodeCount);
+	for (auto& node : nodes)
+	{
+		if (!(file >> node.first >> node.second) || node.first == 0 || node.first > BUCKETS)
+			return false;
+	}
+
+	size_t entryCount = 0;
+	if (!(file >> entryCount) || entryCount > SHARDS * TOP_CAPACITY)
+		return false;
+	std::vector<LeaderboardEntry> entries(entryCount);
+	for (LeaderboardEntry& entry : entries)
+	{
+		int64_t deadRaw = 0;
+		if (!(file >> entry.Score >> entry.GameId >> entry.Population >> entry.Area >> deadRaw))
+			return false;
+		entry.AverageDead = EconomyFixed::FromRaw(deadRaw);
+	}
+
+	for (const auto& node : nodes)
+	{
+		m_Histogram[node.first].fetch_add(node.second, std::memory_order_relaxed);
+	}
+	for (size_t i = 0; i < entries.size(); i++)
+	{
+		InsertEntry(m_Shards[i % SHARDS], entries[i]);
+	}
+	m_GameCount.fetch_add(games, std::memory_order_relaxed);
+	return true;
+}
+
+void Leaderboard::StartSnapshots(const std::filesystem::path& filePath, std::chrono::seconds period)
+{
+	std::lock_guard<std::mutex> lock(m_SnapshotMutex);
+	if (m_SnapshotWriter.joinable())
+		return;
+
+	m_SnapshotPath = filePath;
+	m_SnapshotPeriod = period;
+	m_SnapshotStopping = false;
+	m_SnapshotWriter = std::thread(&Leaderboard::SnapshotLoop, this);
+}
+
+void Leaderboard::StopSnapshots()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_SnapshotMutex);
+		m_SnapshotStopping = true;
+	}
+	m_SnapshotWakeup.notify_one();
+
+	if (m_SnapshotWriter.joinable())
+		m_SnapshotWriter.join();
+}
+
+size_t Leaderboard::GetBucket(uint64_t score)
+{
+	// Ячейки идут в том же порядке, что и Score, только грубее
+	uint64_t outcome = std::min<uint64_t>(score >> 56, (uint64_t)OutcomeClass::Count - 1);
+	uint64_t acres = std::min<uint64_t>((score >> 32) & ACRES_MASK, HISTOGRAM_ACRES - 1);
+	uint64_t deadRaw = DEAD_MASK - (score & DEAD_MASK);
+	uint64_t deadPercent = std::min<uint64_t>(deadRaw * 100 / EconomyFixed::ONE_RAW, DEAD_PERCENTS - 1);
+	return (size_t)((outcome * HISTOGRAM_ACRES + acres) * DEAD_PERCENTS + (DEAD_PERCENTS - 1 - deadPercent));
+}
+
+void Leaderboard::InsertEntry(Shard& shard, const LeaderboardEntry& entry)
+{
+	std::lock_guard<std::mutex> lock(shard.Mutex);
+	if (shard.Top.size() >= TOP_CAPACITY && !IsBetter(entry, shard.Top.back()))
+		return;
+
+	auto position = std::upper_bound(shard.Top.begin(), shard.Top.end(), entry, IsBetter);
+	shard.Top.insert(position, entry);
+	if (shard.Top.size() > TOP_CAPACITY)
+		shard.Top.pop_back();
+
+	if (shard.Top.size() >= TOP_CAPACITY)
+		shard.Threshold.store(shard.Top.back().Score, std::memory_order_relaxed);
+}
+
+void Leaderboard::AddToHistogram(size_t bucket, uint64_t count)
+{
+	for (size_t i = bucket + 1; i <= BUCKETS; i += i & (~i + 1))
+	{
+		m_Histogram[i].fetch_add(count, std::memory_order_relaxed);
+	}
+}
+
+uint64_t Leaderboard::GetCountBelow(size_t bucket) const
+{
+	uint64_t count = 0;
+	for (size_t i = bucket; i > 0; i -= i & (~i + 1))
+	{
+		count += m_Histogram[i].load(std::memory_order_relaxed);
+	}
+	return count;
+}
+
+void Leaderboard::SnapshotLoop()
+{
+	uint64_t savedGames = 0;
+	std::unique_lock<std::mutex> lock(m_SnapshotMutex);
+	while (true)
+	{
+		bool stopping = m_SnapshotWakeup.wait_for(lock, m_SnapshotPeriod, [this] { return m_SnapshotStopping; });
+
+		// Снимок пишется без блокировки: остановка в это время только ставит флаг
+		uint64_t games = GetGameCount();
+		if (games != savedGames)
+		{
+			std::filesystem::path filePath = m_SnapshotPath;
+			lock.unlock();
+			if (SaveSnapshot(filePath))
+				savedGames = games;
+			lock.lock();
+		}
+
+		if (stopping)
+			return;
+	}
+}
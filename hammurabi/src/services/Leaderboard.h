@@ -0,0 +1,109 @@
+#pragma once
+
+#include "../config/GameConfig.h"
+#include "../domain/CityState.h"
+#include "../domain/Statistics.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Партия в таблице лучших
+struct LeaderboardEntry
+{
+	uint64_t Score;             // Ключ упорядочивания, больше - лучше (см. Leaderboard::MakeScore)
+	uint64_t GameId;            // Номер партии в порядке записи
+	Quantity Population;
+	Quantity Area;
+	EconomyFixed AverageDead;   // Средняя доля умерших от голода
+};
+
+// Итог партии для ранжирования: свергнутые ниже любой оценки,
+// дальше оценка правления, акры на жителя и (по убыванию) средняя доля умерших
+enum class OutcomeClass : uint8_t
+{
+	Overthrown,
+	Poor,
+	Fair,
+	Good,
+	Excellent,
+	Count
+};
+
+// Таблица лучших партий всего процесса: сервер и партии по сценарию
+// пишут в нее из многих потоков. Партии прогона правил сюда не попадают: они
+// играются по другим правилам, и их итоги несравнимы с обычными.
+// Запись идет в часть (shard) своего потока под ее мьютексом; у каждой части есть
+// атомарный порог входа, поэтому партия хуже ее худшей записи отсекается без
+// блокировки - а таких после разгона почти все.
+// Процентильный ранг считается по гистограмме классов итога (дерево Фенвика на
+// атомарных счетчиках): запись и запрос - O(log ячеек) без блокировок.
+// Снимок (лучшие партии и гистограмма) пишется на диск по запросу или фоновым
+// потоком раз в GameConfig::Leaderboard::SNAPSHOT_SECONDS.
+class Leaderboard
+{
+public:
+	static constexpr size_t SHARDS = GameConfig::Leaderboard::SHARDS;
+	static constexpr size_t TOP_CAPACITY = GameConfig::Leaderboard::TOP_PER_SHARD;
+
+	static Leaderboard& Instance();
+
+	Leaderboard();
+	~Leaderboard();
+
+	Leaderboard(const Leaderboard&) = delete;
+	Leaderboard& operator=(const Leaderboard&) = delete;
+
+	static uint64_t MakeScore(OutcomeClass outcome, int32_t acresPerPerson, EconomyFixed averageDead);
+	static OutcomeClass GetOutcomeClass(uint64_t score);
+
+	// Итог партии по ее последнему состоянию
+	void Record(const CityState& state, const GameStatistics& stats, bool overthrown);
+	void Insert(uint64_t score, Quantity population, Quantity area, EconomyFixed averageDead);
+
+	// Лучшие k партий по убыванию (k не больше TOP_CAPACITY); буфер вызывающего переиспользуется
+	void GetTop(size_t k, std::vector<LeaderboardEntry>& top) const;
+	// Доля записанных партий, которые хуже итога score (с точностью до ячейки гистограммы)
+	double GetPercentileRank(uint64_t score) const;
+	uint64_t GetGameCount() const;
+
+	bool SaveSnapshot(const std::filesystem::path& filePath) const;
+	bool LoadSnapshot(const std::filesystem::path& filePath);
+	// Фоновая запись снимка; последний снимок пишется при остановке
+	void StartSnapshots(const std::filesystem::path& filePath, std::chrono::seconds period);
+	void StopSnapshots();
+
+private:
+	// Часть таблицы со своей блокировкой; выровнена, чтобы части не делили строки кэша
+	struct alignas(64) Shard
+	{
+		mutable std::mutex Mutex;
+		std::vector<LeaderboardEntry> Top;      // По убыванию Score, не больше TOP_CAPACITY
+		std::atomic<uint64_t> Threshold;        // Партия со Score не выше него не войдет
+	};
+
+	static size_t GetBucket(uint64_t score);
+	void InsertEntry(Shard& shard, const LeaderboardEntry& entry);
+	void AddToHistogram(size_t bucket, uint64_t count);
+	uint64_t GetCountBelow(size_t bucket) const;
+	void SnapshotLoop();
+
+private:
+	std::array<Shard, SHARDS> m_Shards;
+	std::vector<std::atomic<uint64_t>> m_Histogram;     // Дерево Фенвика по ячейкам, индексы с 1
+	std::atomic<uint64_t> m_GameCount;
+
+	// Фоновые снимки
+	std::mutex m_SnapshotMutex;
+	std::condition_variable m_SnapshotWakeup;
+	std::filesystem::path m_SnapshotPath;
+	std::chrono::seconds m_SnapshotPeriod;
+	bool m_SnapshotStopping;
+	std::thread m_SnapshotWriter;
+};
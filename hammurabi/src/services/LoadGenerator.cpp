@@ -0,0 +1,274 @@
+#include "LoadGenerator.h"
+#include "GameSession.h"
+#include "../config/GameConfig.h"
+#include <iostream>
+
+#ifdef __linux__
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string_view>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr int MAX_EVENTS = 256;
+	constexpr size_t READ_CHUNK = 8192;
+	constexpr size_t KEEP_TAIL = 256;   // Хвоста вывода достаточно, чтобы узнать вопрос
+
+	enum class Question : uint8_t
+	{
+		None,
+		BuyLand,
+		SellLand,
+		WheatForFood,
+		AcresToPlant,
+	};
+
+	struct Client
+	{
+		int Fd;
+		std::string Tail;
+		Question LastAnswered;
+		Clock::time_point SentAt;
+		bool AwaitingReply;
+	};
+
+	bool EndsWith(const std::string& text, const std::string& suffix)
+	{
+		return text.size() >= suffix.size()
+			&& text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+	}
+
+	Question DetectQuestion(const std::string& tail)
+	{
+		if (EndsWith(tail, GameConfig::Messages::BUY_LAND_PROMPT))
+			return Question::BuyLand;
+		if (EndsWith(tail, GameConfig::Messages::SELL_LAND_PROMPT))
+			return Question::SellLand;
+		if (EndsWith(tail, GameConfig::Messages::WHEAT_FOR_FOOD_PROMPT))
+			return Question::WheatForFood;
+		if (EndsWith(tail, GameConfig::Messages::ACRES_TO_PLANT_PROMPT))
+			return Question::AcresToPlant;
+		return Question::None;
+	}
+
+	// Сценарий игрока: землей не торгуем, кормим и сеем умеренно.
+	// Повтор того же вопроса значит отказ валидатора - тогда отвечаем нулем.
+	std::string_view ChooseAnswer(Question question, Question lastAnswered)
+	{
+		if (question == lastAnswered)
+			return "0\n";
+
+		switch (question)
+		{
+		case Question::WheatForFood:
+			return "1500\n";
+		case Question::AcresToPlant:
+			return "300\n";
+		default:
+			return "0\n";
+		}
+	}
+
+	int ConnectClient(const LoadGeneratorConfig& config)
+	{
+		int fd = -1;
+		if (!config.UnixSocketPath.empty())
+		{
+			sockaddr_un address{};
+			if (config.UnixSocketPath.size() >= sizeof(address.sun_path))
+				return -1;
+			address.sun_family = AF_UNIX;
+			std::memcpy(address.sun_path, config.UnixSocketPath.c_str(), config.UnixSocketPath.size());
+
+			fd = socket(AF_UNIX, SOCK_STREAM, 0);
+			if (fd < 0 || connect(fd, (sockaddr*)&address, sizeof(address)) != 0)
+			{
+				if (fd >= 0)
+					close(fd);
+				return -1;
+			}
+		}
+		else
+		{
+			sockaddr_in address{};
+			address.sin_family = AF_INET;
+			address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+			address.sin_port = htons(config.Port);
+
+			fd = socket(AF_INET, SOCK_STREAM, 0);
+			if (fd < 0 || connect(fd, (sockaddr*)&address, sizeof(address)) != 0)
+			{
+				if (fd >= 0)
+					close(fd);
+				return -1;
+			}
+			int enable = 1;
+			setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+		}
+
+		int flags = fcntl(fd, F_GETFL, 0);
+		fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+		return fd;
+	}
+}
+
+LoadGenerator::LoadGenerator(const LoadGeneratorConfig& config)
+	: m_Config(config)
+{
+}
+
+bool LoadGenerator::Run()
+{
+	int epollFd = epoll_create1(0);
+	if (epollFd < 0)
+		return false;
+
+	std::vector<Client> clients(m_Config.Sessions);
+	for (uint32_t i = 0; i < m_Config.Sessions; i++)
+	{
+		Client& client = clients[i];
+		client.Fd = ConnectClient(m_Config);
+		client.LastAnswered = Question::None;
+		client.AwaitingReply = false;
+		if (client.Fd < 0)
+		{
+			std::cout << "Не удалось подключить сессию " << i << std::endl;
+			close(epollFd);
+			return false;
+		}
+
+		epoll_event event{};
+		event.events = EPOLLIN;
+		event.data.ptr = &client;
+		epoll_ctl(epollFd, EPOLL_CTL_ADD, client.Fd, &event);
+	}
+
+	std::vector<uint32_t> latenciesUs;
+	latenciesUs.reserve(1 << 20);
+	uint64_t turns = 0;
+	uint32_t dropped = 0;
+
+	epoll_event events[MAX_EVENTS];
+	char chunk[READ_CHUNK];
+	Clock::time_point start = Clock::now();
+	Clock::time_point deadline = start + std::chrono::seconds(m_Config.DurationSeconds);
+
+	while (Clock::now() < deadline)
+	{
+		int count = epoll_wait(epollFd, events, MAX_EVENTS, 100);
+		for (int i = 0; i < count; i++)
+		{
+			Client& client = *(Client*)events[i].data.ptr;
+			if (client.Fd < 0)
+				continue;
+
+			bool alive = true;
+			while (true)
+			{
+				ssize_t received = recv(client.Fd, chunk, sizeof(chunk), 0);
+				if (received > 0)
+				{
+					client.Tail.append(chunk, (size_t)received);
+					if (client.Tail.size() > KEEP_TAIL * 2)
+						client.Tail.erase(0, client.Tail.size() - KEEP_TAIL);
+					continue;
+				}
+				if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+					break;
+				if (received < 0 && errno == EINTR)
+					continue;
+				alive = false;
+				break;
+			}
+
+			if (!alive)
+			{
+				epoll_ctl(epollFd, EPOLL_CTL_DEL, client.Fd, nullptr);
+				close(client.Fd);
+				client.Fd = -1;
+				dropped++;
+				continue;
+			}
+
+			Question question = DetectQuestion(client.Tail);
+			if (question == Question::None)
+				continue;
+
+			Clock::time_point now = Clock::now();
+			if (client.AwaitingReply)
+			{
+				auto latency = std::chrono::duration_cast<std::chrono::microseconds>(now - client.SentAt);
+				latenciesUs.push_back((uint32_t)latency.count());
+				turns++;
+			}
+
+			std::string_view answer = ChooseAnswer(question, client.LastAnswered);
+			client.LastAnswered = question;
+			client.Tail.clear();
+			client.SentAt = now;
+			client.AwaitingReply = true;
+			send(client.Fd, answer.data(), answer.size(), MSG_NOSIGNAL);
+		}
+	}
+
+	double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+	for (Client& client : clients)
+	{
+		if (client.Fd >= 0)
+			close(client.Fd);
+	}
+	close(epollFd);
+
+	uint32_t p50 = 0;
+	uint32_t p99 = 0;
+	if (!latenciesUs.empty())
+	{
+		size_t p50Index = latenciesUs.size() / 2;
+		size_t p99Index = latenciesUs.size() * 99 / 100;
+		std::nth_element(latenciesUs.begin(), latenciesUs.begin() + p50Index, latenciesUs.end());
+		p50 = latenciesUs[p50Index];
+		std::nth_element(latenciesUs.begin(), latenciesUs.begin() + p99Index, latenciesUs.end());
+		p99 = latenciesUs[p99Index];
+	}
+
+	uint32_t serverCores = std::max(1u, m_Config.ServerCores);
+	std::cout << "Сессий: " << m_Config.Sessions << " (потеряно " << dropped << ")\n"
+		<< "Сессий на ядро сервера: " << (double)m_Config.Sessions / serverCores << "\n"
+		<< "Ходов: " << turns << ", ходов в секунду: " << (uint64_t)(turns / elapsed) << "\n"
+		<< "Задержка хода p50: " << p50 << " мкс, p99: " << p99 << " мкс" << std::endl;
+
+	// Пробная партия в этом процессе: сколько памяти сервер держит на игрока, ждущего ответа
+	GameSession probe;
+	probe.Start();
+	std::cout << "Кадр корутины опроса: " << DecisionTask::GetFrameSize()
+		<< " байт, сессия: " << sizeof(GameSession) << " байт" << std::endl;
+	return true;
+}
+
+#else
+
+LoadGenerator::LoadGenerator(const LoadGeneratorConfig& config)
+	: m_Config(config)
+{
+}
+
+bool LoadGenerator::Run()
+{
+	std::cout << "Нагрузочный клиент доступен только в Linux.\n";
+	return false;
+}
+
+#endif
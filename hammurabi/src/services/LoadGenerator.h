@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Параметры нагрузочного клиента
+struct LoadGeneratorConfig
+{
+	std::string UnixSocketPath;   // Если задан, подключаемся к Unix-сокету
+	uint16_t Port;                // Иначе - к 127.0.0.1:Port
+	uint32_t Sessions;            // Одновременных игроков
+	uint32_t DurationSeconds;     // Длительность прогона
+	uint32_t ServerCores;         // Ядер у сервера - для пересчета сессий на ядро
+};
+
+// Локальный нагрузочный клиент игрового сервера.
+// Держит много соединений в одном epoll, отвечает на вопросы по простому сценарию
+// и измеряет задержку хода: от отправки ответа до получения следующего вопроса.
+// Доступен только в Linux.
+class LoadGenerator
+{
+public:
+	explicit LoadGenerator(const LoadGeneratorConfig& config);
+	bool Run();
+
+private:
+	LoadGeneratorConfig m_Config;
+};
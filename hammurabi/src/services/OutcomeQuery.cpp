@@ -0,0 +1,359 @@
+#include "OutcomeQuery.h"
+#include "../config/GameConfig.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <unordered_map>
+
+namespace
+{
+	constexpr size_t BATCH = GameConfig::Store::BATCH_ROWS;
+
+	bool ParseAggregate(const std::string& word, QueryAggregate& aggregate)
+	{
+		static const std::pair<const char*, QueryAggregate> NAMES[] = {
+			{ "count", QueryAggregate::Count },
+			{ "sum", QueryAggregate::Sum },
+			{ "mean", QueryAggregate::Mean },
+			{ "min", QueryAggregate::Min },
+			{ "max", QueryAggregate::Max }
+		};
+
+		for (const auto& [name, value] : NAMES)
+		{
+			if (word == name)
+			{
+				aggregate = value;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool IsOperator(const std::string& word)
+	{
+		return word == "=" || word == "==" || word == "!=" || word == "<" || word == "<=" || word == ">" || word == ">=";
+	}
+
+	// Сравнение с дробным числом переводится в диапазон целых значений столбца
+	bool MakePredicateRange(OutcomeColumn column, const std::string& op, double value, QueryPredicate& predicate)
+	{
+		if (column == OutcomeColumn::DeadFromHungerPercent)
+			value *= (double)EconomyFixed::ONE_RAW;
+
+		const double limit = 18446744073709551615.0;
+		auto toValue = [limit](double bound) { return bound >= limit ? UINT64_MAX : (uint64_t)bound; };
+
+		predicate = QueryPredicate{ column, 1, 0, false };     // Пустой диапазон
+		if (op == "=" || op == "==" || op == "!=")
+		{
+			predicate.Negate = op == "!=";
+			if (value >= 0.0 && value < limit && std::floor(value) == value)
+				predicate.Low = predicate.High = (uint64_t)value;
+			return true;
+		}
+
+		if (op == "<" || op == "<=")
+		{
+			double high = op == "<" ? std::ceil(value) - 1.0 : std::floor(value);
+			if (high >= 0.0)
+			{
+				predicate.Low = 0;
+				predicate.High = toValue(high);
+			}
+			return true;
+		}
+
+		if (op == ">" || op == ">=")
+		{
+			double low = op == ">" ? std::floor(value) + 1.0 : std::ceil(value);
+			if (low < limit)
+			{
+				predicate.Low = low > 0.0 ? (uint64_t)low : 0;
+				predicate.High = UINT64_MAX;
+			}
+			return true;
+		}
+		return false;
+	}
+
+	bool MakePredicate(OutcomeColumn column, const std::string& op, double value, QueryPredicate& predicate)
+	{
+		if (!MakePredicateRange(column, op, value, predicate))
+			return false;
+
+		// Пустой диапазон - это весь диапазон с обратным знаком: цикл фильтра остается одним
+		if (predicate.Low > predicate.High)
+			predicate = QueryPredicate{ column, 0, UINT64_MAX, !predicate.Negate };
+		return true;
+	}
+
+	// Накопитель группы
+	inline void Accumulate(QueryGroup& group, uint64_t value)
+	{
+		group.Count++;
+		group.Sum += value;
+		group.Min = std::min(group.Min, value);
+		group.Max = std::max(group.Max, value);
+	}
+
+	QueryGroup MakeGroup(uint64_t key)
+	{
+		return QueryGroup{ key, 0, 0, UINT64_MAX, 0 };
+	}
+}
+
+OutcomeQuery::OutcomeQuery()
+	: Aggregate(QueryAggregate::Count),
+	Column(OutcomeColumn::Round),
+	Grouped(false),
+	GroupBy(OutcomeColumn::Round),
+	Predicates()
+{
+}
+
+bool OutcomeQuery::Parse(const std::vector<std::string>& words)
+{
+	*this = OutcomeQuery();
+	size_t position = 0;
+	if (words.empty() || !ParseAggregate(words[position++], Aggregate))
+		return false;
+
+	if (position < words.size() && words[position] != "by" && words[position] != "where")
+	{
+		if (!ParseOutcomeColumn(words[position++], Column))
+			return false;
+	}
+	else if (Aggregate != QueryAggregate::Count)
+		return false;
+
+	if (position < words.size() && words[position] == "by")
+	{
+		if (++position >= words.size() || !ParseOutcomeColumn(words[position++], GroupBy))
+			return false;
+		Grouped = true;
+	}
+
+	if (position < words.size() && words[position] == "where")
+	{
+		do
+		{
+			OutcomeColumn column = OutcomeColumn::Round;
+			if (++position >= words.size() || !ParseOutcomeColumn(words[position++], column))
+				return false;
+
+			QueryPredicate predicate{ column, 0, 0, true };    // Без сравнения - "не ноль"
+			if (position < words.size() && IsOperator(words[position]))
+			{
+				const std::string& op = words[position++];
+				std::istringstream number(position < words.size() ? words[position++] : "");
+				double value = 0.0;
+				if (!(number >> value) || !number.eof() || !MakePredicate(column, op, value, predicate))
+					return false;
+			}
+			Predicates.push_back(predicate);
+		}
+		while (position < words.size() && words[position] == "and");
+	}
+
+	return position == words.size();
+}
+
+OutcomeQueryEngine::OutcomeQueryEngine(const OutcomeStore& store)
+	: m_Store(store),
+	m_Values(OUTCOME_COLUMNS * BATCH),
+	m_Decoded(OUTCOME_COLUMNS),
+	m_Mask(BATCH),
+	m_BytesScanned(0)
+{
+}
+
+void OutcomeQueryEngine::Run(const OutcomeQuery& query, QueryResult& result)
+{
+	auto started = std::chrono::steady_clock::now();
+	result = QueryResult{};
+	m_BytesScanned = 0;
+
+	// Ключи группировки, которые заведомо малы, адресуют плоский массив
+	uint64_t maxKey = 0;
+	for (const auto& segment : m_Store.GetSegments())
+	{
+		maxKey = std::max(maxKey, segment->GetColumn(query.GroupBy).Max);
+	}
+	bool dense = !query.Grouped || maxKey < GameConfig::Store::DENSE_GROUPS;
+	std::vector<QueryGroup> denseGroups;
+	std::unordered_map<uint64_t, QueryGroup> sparseGroups;
+	if (dense)
+	{
+		denseGroups.resize(query.Grouped ? (size_t)maxKey + 1 : 1);
+		for (size_t key = 0; key < denseGroups.size(); key++)
+		{
+			denseGroups[key] = MakeGroup(key);
+		}
+	}
+
+	bool needsValues = query.Aggregate != QueryAggregate::Count;
+	for (const auto& segmentPointer : m_Store.GetSegments())
+	{
+		const OutcomeSegment& segment = *segmentPointer;
+		if (CanSkip(segment, query))
+		{
+			result.SegmentsSkipped++;
+			continue;
+		}
+
+		size_t rows = segment.GetRowCount();
+		for (size_t first = 0; first < rows; first += BATCH)
+		{
+			size_t count = std::min(BATCH, rows - first);
+			std::fill(m_Decoded.begin(), m_Decoded.end(), 0);
+			result.RowsScanned += count;
+
+			// Маска: по байту на строку, условия сужают ее по очереди
+			uint8_t* mask = m_Mask.data();
+			std::fill(mask, mask + count, 1);
+			for (const QueryPredicate& predicate : query.Predicates)
+			{
+				const uint64_t* values = DecodeColumn(segment, predicate.Column, first, count);
+				uint64_t low = predicate.Low;
+				uint64_t span = predicate.High - predicate.Low;
+				uint8_t negate = predicate.Negate ? 1 : 0;
+				for (size_t i = 0; i < count; i++)
+				{
+					mask[i] &= (uint8_t)((values[i] - low <= span) ^ negate);
+				}
+			}
+
+			size_t matched = 0;
+			for (size_t i = 0; i < count; i++)
+			{
+				matched += mask[i];
+			}
+			if (matched == 0)
+				continue;
+			result.RowsMatched += matched;
+
+			const uint64_t* values = needsValues ? DecodeColumn(segment, query.Column, first, count) : nullptr;
+			const uint64_t* keys = query.Grouped ? DecodeColumn(segment, query.GroupBy, first, count) : nullptr;
+
+			if (!query.Grouped)
+			{
+				// Без группировки - сплошные проходы по маске
+				QueryGroup& group = denseGroups[0];
+				group.Count += matched;
+				if (!needsValues)
+					continue;
+
+				uint64_t sum = 0;
+				uint64_t minimum = UINT64_MAX;
+				uint64_t maximum = 0;
+				for (size_t i = 0; i < count; i++)
+				{
+					uint64_t keep = 0 - (uint64_t)mask[i];
+					sum += values[i] & keep;
+					minimum = std::min(minimum, values[i] | ~keep);
+					maximum = std::max(maximum, values[i] & keep);
+				}
+				group.Sum += sum;
+				group.Min = std::min(group.Min, minimum);
+				group.Max = std::max(group.Max, maximum);
+				continue;
+			}
+
+			if (dense)
+			{
+				// Ключи всех строк пачки лежат в массиве, поэтому и здесь обходимся без ветвлений
+				for (size_t i = 0; i < count; i++)
+				{
+					QueryGroup& group = denseGroups[keys[i]];
+					uint64_t keep = 0 - (uint64_t)mask[i];
+					uint64_t value = needsValues ? values[i] : 0;
+					group.Count += mask[i];
+					group.Sum += value & keep;
+					group.Min = std::min(group.Min, value | ~keep);
+					group.Max = std::max(group.Max, value & keep);
+				}
+				continue;
+			}
+
+			for (size_t i = 0; i < count; i++)
+			{
+				if (mask[i])
+					Accumulate(sparseGroups.try_emplace(keys[i], MakeGroup(keys[i])).first->second, needsValues ? values[i] : 0);
+			}
+		}
+	}
+
+	if (dense)
+	{
+		for (const QueryGroup& group : denseGroups)
+		{
+			if (group.Count > 0)
+				result.Groups.push_back(group);
+		}
+	}
+	else
+	{
+		for (const auto& [key, group] : sparseGroups)
+		{
+			result.Groups.push_back(group);
+		}
+		std::sort(result.Groups.begin(), result.Groups.end(),
+			[](const QueryGroup& a, const QueryGroup& b) { return a.Key < b.Key; });
+	}
+
+	result.BytesScanned = m_BytesScanned;
+	result.Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+}
+
+double OutcomeQueryEngine::GetValue(const OutcomeQuery& query, const QueryGroup& group)
+{
+	switch (query.Aggregate)
+	{
+	case QueryAggregate::Count:
+		return (double)group.Count;
+	case QueryAggregate::Sum:
+		return ToColumnUnits(query.Column, group.Sum);
+	case QueryAggregate::Mean:
+		return group.Count > 0 ? ToColumnUnits(query.Column, group.Sum) / (double)group.Count : 0.0;
+	case QueryAggregate::Min:
+		return ToColumnUnits(query.Column, group.Min);
+	case QueryAggregate::Max:
+	default:
+		return ToColumnUnits(query.Column, group.Max);
+	}
+}
+
+double OutcomeQueryEngine::ToColumnUnits(OutcomeColumn column, uint64_t value)
+{
+	if (column == OutcomeColumn::DeadFromHungerPercent)
+		return (double)value / (double)EconomyFixed::ONE_RAW;
+	return (double)value;
+}
+
+bool OutcomeQueryEngine::CanSkip(const OutcomeSegment& segment, const OutcomeQuery& query) const
+{
+	// Сегмент не нужен, если по зональной карте хоть одно условие в нем не выполнится ни разу
+	for (const QueryPredicate& predicate : query.Predicates)
+	{
+		const OutcomeFormat::ColumnHeader& column = segment.GetColumn(predicate.Column);
+		bool inside = column.Min >= predicate.Low && column.Max <= predicate.High;
+		bool outside = column.Max < predicate.Low || column.Min > predicate.High;
+		if (predicate.Negate ? inside : outside)
+			return true;
+	}
+	return false;
+}
+
+const uint64_t* OutcomeQueryEngine::DecodeColumn(const OutcomeSegment& segment, OutcomeColumn column, size_t first, size_t count)
+{
+	uint64_t* values = m_Values.data() + (size_t)column * BATCH;
+	if (!m_Decoded[(size_t)column])
+	{
+		segment.Decode(column, first, count, values);
+		m_Decoded[(size_t)column] = 1;
+		m_BytesScanned += count * sizeof(uint64_t);
+	}
+	return values;
+}
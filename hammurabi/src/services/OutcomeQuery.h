@@ -0,0 +1,91 @@
+#pragma once
+
+#include "OutcomeStore.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class QueryAggregate : uint8_t
+{
+	Count,
+	Sum,
+	Mean,
+	Min,
+	Max
+};
+
+// Условие отбора как диапазон [Low, High] значений столбца (Negate - вне диапазона):
+// так любое сравнение проверяется одним беззнаковым вычитанием без ветвлений
+struct QueryPredicate
+{
+	OutcomeColumn Column;
+	uint64_t Low;
+	uint64_t High;
+	bool Negate;
+};
+
+// Запрос к хранилищу исходов:
+//   <count|sum|mean|min|max> [столбец] [by столбец] [where условие {and условие}]
+// Условие - "столбец op число" (op: = != < <= > >=) или просто "столбец" (не ноль).
+// DeadFromHungerPercent сравнивается и выводится долей, как в RoundStatistics.
+// Пример: mean DeadFromHunger by Round where HasPlague and Population > 100
+struct OutcomeQuery
+{
+	QueryAggregate Aggregate;
+	OutcomeColumn Column;
+	bool Grouped;
+	OutcomeColumn GroupBy;
+	std::vector<QueryPredicate> Predicates;
+
+	OutcomeQuery();
+
+	bool Parse(const std::vector<std::string>& words);
+};
+
+// Итог одной группы (или всего запроса без группировки)
+struct QueryGroup
+{
+	uint64_t Key;
+	uint64_t Count;
+	uint64_t Sum;
+	uint64_t Min;
+	uint64_t Max;
+};
+
+struct QueryResult
+{
+	std::vector<QueryGroup> Groups;     // По возрастанию ключа; пустые группы не попадают
+	uint64_t RowsScanned;
+	uint64_t RowsMatched;
+	uint64_t BytesScanned;              // Разжатые значения прочитанных столбцов, по 8 байт
+	uint32_t SegmentsSkipped;           // Отброшены по зональной карте без чтения
+	double Seconds;
+};
+
+// Исполнитель запросов: сегменты читаются пачками по GameConfig::Store::BATCH_ROWS строк.
+// Пачка каждого нужного столбца разжимается в плоский массив, условия складываются
+// в маску отбора простыми циклами без ветвлений (их векторизует компилятор),
+// затем по маске считаются агрегаты. Группы с малыми ключами лежат в плоском массиве,
+// остальные - в хеш-таблице.
+class OutcomeQueryEngine
+{
+public:
+	explicit OutcomeQueryEngine(const OutcomeStore& store);
+
+	void Run(const OutcomeQuery& query, QueryResult& result);
+
+	// Значение агрегата группы в единицах столбца
+	static double GetValue(const OutcomeQuery& query, const QueryGroup& group);
+	static double ToColumnUnits(OutcomeColumn column, uint64_t value);
+
+private:
+	bool CanSkip(const OutcomeSegment& segment, const OutcomeQuery& query) const;
+	const uint64_t* DecodeColumn(const OutcomeSegment& segment, OutcomeColumn column, size_t first, size_t count);
+
+private:
+	const OutcomeStore& m_Store;
+	std::vector<uint64_t> m_Values;     // Пачка на каждый столбец: OUTCOME_COLUMNS x BATCH_ROWS
+	std::vector<uint8_t> m_Decoded;     // Столбец уже разжат для текущей пачки
+	std::vector<uint8_t> m_Mask;
+	uint64_t m_BytesScanned;
+};
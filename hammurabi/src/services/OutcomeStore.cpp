@@ -0,0 +1,507 @@
+#include "OutcomeStore.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+namespace
+{
+	using OutcomeFormat::ColumnHeader;
+	using OutcomeFormat::SegmentHeader;
+
+	constexpr size_t BATCH = GameConfig::Store::BATCH_ROWS;
+
+	constexpr const char* COLUMN_NAMES[OUTCOME_COLUMNS] = {
+		"Point",
+		"Game",
+		"Round",
+		"Population",
+		"Area",
+		"WheatReserves",
+		"AcrePrice",
+		"WorkableArea",
+		"WheatPerAcre",
+		"WheatConsumed",
+		"DeadFromHunger",
+		"NewPeople",
+		"WheatEatenByRats",
+		"HasPlague",
+		"DeadFromHungerPercent"
+	};
+
+	uint32_t GetBitWidth(uint64_t value)
+	{
+		uint32_t width = 0;
+		while (value != 0)
+		{
+			width++;
+			value >>= 1;
+		}
+		return width;
+	}
+
+	size_t GetPackedWords(size_t count, uint32_t width)
+	{
+		return (count * width + 63) / 64;
+	}
+
+	uint64_t ZigZag(int64_t value)
+	{
+		return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+	}
+
+	int64_t UnZigZag(uint64_t value)
+	{
+		return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+	}
+
+	// Значение index из плотно упакованных по width бит слов (младшие биты - первыми)
+	inline uint64_t Unpack(const uint64_t* words, uint32_t width, size_t index)
+	{
+		if (width == 0)
+			return 0;
+
+		size_t bit = index * width;
+		size_t word = bit >> 6;
+		uint32_t shift = (uint32_t)(bit & 63);
+		uint64_t value = words[word] >> shift;
+		if (shift + width > 64)
+			value |= words[word + 1] << (64 - shift);
+		return width == 64 ? value : value & (((uint64_t)1 << width) - 1);
+	}
+
+	void Pack(std::vector<uint64_t>& words, uint32_t width, size_t index, uint64_t value)
+	{
+		if (width == 0)
+			return;
+
+		size_t bit = index * width;
+		size_t word = bit >> 6;
+		uint32_t shift = (uint32_t)(bit & 63);
+		words[word] |= value << shift;
+		if (shift + width > 64)
+			words[word + 1] |= value >> (64 - shift);
+	}
+
+	template<typename T>
+	void AppendValue(std::vector<char>& buffer, const T& value)
+	{
+		const char* bytes = reinterpret_cast<const char*>(&value);
+		buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+	}
+
+	void AppendWords(std::vector<char>& buffer, const std::vector<uint64_t>& words)
+	{
+		const char* bytes = reinterpret_cast<const char*>(words.data());
+		buffer.insert(buffer.end(), bytes, bytes + words.size() * sizeof(uint64_t));
+	}
+
+	void AlignTo8(std::vector<char>& buffer)
+	{
+		buffer.resize((buffer.size() + 7) & ~(size_t)7, 0);
+	}
+
+	// Кодирует столбец в конец buffer и заполняет его заголовок
+	void EncodeColumn(const std::vector<uint64_t>& values, std::vector<char>& buffer, ColumnHeader& header)
+	{
+		size_t count = values.size();
+		auto [minIt, maxIt] = std::minmax_element(values.begin(), values.end());
+		header = ColumnHeader{};
+		header.Min = *minIt;
+		header.Max = *maxIt;
+		header.Offset = buffer.size();
+		if (header.Min == header.Max)
+		{
+			header.Encoding = ColumnEncoding::Constant;
+			return;
+		}
+
+		// Размеры трех вариантов считаются заранее, кодируется только лучший
+		uint32_t width = GetBitWidth(header.Max - header.Min);
+		size_t packedSize = GetPackedWords(count, width) * 8;
+
+		uint64_t minDelta = UINT64_MAX;
+		uint64_t maxDelta = 0;
+		size_t runs = 1;
+		for (size_t i = 1; i < count; i++)
+		{
+			runs += values[i] != values[i - 1] ? 1 : 0;
+			if (i % BATCH == 0)
+				continue;
+			uint64_t delta = ZigZag((int64_t)(values[i] - values[i - 1]));
+			minDelta = std::min(minDelta, delta);
+			maxDelta = std::max(maxDelta, delta);
+		}
+		if (minDelta > maxDelta)
+			minDelta = maxDelta = 0;
+		uint32_t deltaWidth = GetBitWidth(maxDelta - minDelta);
+		size_t batches = (count + BATCH - 1) / BATCH;
+		size_t deltaSize = batches * 8 + GetPackedWords(count, deltaWidth) * 8;
+		size_t runSize = GetPackedWords(runs, width) * 8 + ((runs * sizeof(uint32_t) + 7) & ~(size_t)7);
+
+		if (runSize < packedSize && runSize <= deltaSize)
+		{
+			header.Encoding = ColumnEncoding::RunLength;
+			header.Width = width;
+			header.Base = header.Min;
+			header.Runs = runs;
+
+			std::vector<uint64_t> words(GetPackedWords(runs, width), 0);
+			std::vector<uint32_t> ends;
+			ends.reserve(runs);
+			size_t run = 0;
+			for (size_t i = 1; i <= count; i++)
+			{
+				if (i < count && values[i] == values[i - 1])
+					continue;
+				Pack(words, width, run++, values[i - 1] - header.Min);
+				ends.push_back((uint32_t)i);
+			}
+			AppendWords(buffer, words);
+			const char* bytes = reinterpret_cast<const char*>(ends.data());
+			buffer.insert(buffer.end(), bytes, bytes + ends.size() * sizeof(uint32_t));
+		}
+		else if (deltaSize < packedSize)
+		{
+			header.Encoding = ColumnEncoding::Delta;
+			header.Width = deltaWidth;
+			header.Base = minDelta;
+
+			std::vector<uint64_t> restarts(batches);
+			std::vector<uint64_t> words(GetPackedWords(count, deltaWidth), 0);
+			for (size_t i = 0; i < count; i++)
+			{
+				if (i % BATCH == 0)
+				{
+					restarts[i / BATCH] = values[i];
+					continue;
+				}
+				Pack(words, deltaWidth, i, ZigZag((int64_t)(values[i] - values[i - 1])) - minDelta);
+			}
+			AppendWords(buffer, restarts);
+			AppendWords(buffer, words);
+		}
+		else
+		{
+			header.Encoding = ColumnEncoding::BitPacked;
+			header.Width = width;
+			header.Base = header.Min;
+
+			std::vector<uint64_t> words(GetPackedWords(count, width), 0);
+			for (size_t i = 0; i < count; i++)
+			{
+				Pack(words, width, i, values[i] - header.Min);
+			}
+			AppendWords(buffer, words);
+		}
+
+		AlignTo8(buffer);
+		header.Size = buffer.size() - header.Offset;
+	}
+
+	// Сколько байт данных нужно столбцу по его заголовку
+	size_t GetExpectedSize(const ColumnHeader& header, size_t rows)
+	{
+		switch (header.Encoding)
+		{
+		case ColumnEncoding::Constant:
+			return 0;
+		case ColumnEncoding::BitPacked:
+			return GetPackedWords(rows, header.Width) * 8;
+		case ColumnEncoding::Delta:
+			return (rows + BATCH - 1) / BATCH * 8 + GetPackedWords(rows, header.Width) * 8;
+		case ColumnEncoding::RunLength:
+			return GetPackedWords(header.Runs, header.Width) * 8 + header.Runs * sizeof(uint32_t);
+		}
+		return SIZE_MAX;
+	}
+}
+
+bool ParseOutcomeColumn(std::string_view name, OutcomeColumn& column)
+{
+	for (size_t i = 0; i < OUTCOME_COLUMNS; i++)
+	{
+		if (name == COLUMN_NAMES[i])
+		{
+			column = (OutcomeColumn)i;
+			return true;
+		}
+	}
+	return false;
+}
+
+const char* GetOutcomeColumnName(OutcomeColumn column)
+{
+	size_t index = (size_t)column;
+	return index < OUTCOME_COLUMNS ? COLUMN_NAMES[index] : "?";
+}
+
+OutcomeStoreWriter::OutcomeStoreWriter(const std::filesystem::path& directory, uint32_t writerId)
+	: m_Directory(directory),
+	m_Segment(0),
+	m_RowCount(0),
+	m_BytesWritten(0),
+	m_Failed(false)
+{
+	auto now = std::chrono::system_clock::now().time_since_epoch();
+	auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
+	m_FilePrefix = "segment_" + std::to_string(millis) + "_" + std::to_string(writerId) + "_";
+
+	for (std::vector<uint64_t>& column : m_Columns)
+	{
+		column.reserve(GameConfig::Store::SEGMENT_ROWS);
+	}
+}
+
+OutcomeStoreWriter::~OutcomeStoreWriter()
+{
+	Flush();
+}
+
+void OutcomeStoreWriter::Append(uint32_t point, uint64_t game, const CityState& state, EconomyFixed deadFromHungerPercent)
+{
+	if (m_Failed)
+		return;
+
+	m_Columns[(size_t)OutcomeColumn::Point].push_back(point);
+	m_Columns[(size_t)OutcomeColumn::Game].push_back(game);
+	m_Columns[(size_t)OutcomeColumn::Round].push_back(state.Round);
+	m_Columns[(size_t)OutcomeColumn::Population].push_back(state.Population);
+	m_Columns[(size_t)OutcomeColumn::Area].push_back(state.Area);
+	m_Columns[(size_t)OutcomeColumn::WheatReserves].push_back(state.WheatReserves);
+	m_Columns[(size_t)OutcomeColumn::AcrePrice].push_back(state.AcrePrice);
+	m_Columns[(size_t)OutcomeColumn::WorkableArea].push_back(state.WorkableArea);
+	m_Columns[(size_t)OutcomeColumn::WheatPerAcre].push_back(state.WheatPerAcre);
+	m_Columns[(size_t)OutcomeColumn::WheatConsumed].push_back(state.WheatConsumed);
+	m_Columns[(size_t)OutcomeColumn::DeadFromHunger].push_back(state.DeadFromHunger);
+	m_Columns[(size_t)OutcomeColumn::NewPeople].push_back(state.NewPeople);
+	m_Columns[(size_t)OutcomeColumn::WheatEatenByRats].push_back(state.WheatEatenByRats);
+	m_Columns[(size_t)OutcomeColumn::HasPlague].push_back(state.HasPlague ? 1 : 0);
+	m_Columns[(size_t)OutcomeColumn::DeadFromHungerPercent].push_back((uint64_t)std::max<int64_t>(deadFromHungerPercent.GetRaw(), 0));
+	m_RowCount++;
+
+	if (m_Columns[0].size() >= GameConfig::Store::SEGMENT_ROWS)
+		Flush();
+}
+
+bool OutcomeStoreWriter::Flush()
+{
+	size_t rows = m_Columns[0].size();
+	if (rows == 0 || m_Failed)
+		return !m_Failed;
+
+	std::vector<char> buffer;
+	AppendValue(buffer, SegmentHeader{ OutcomeFormat::MAGIC, OutcomeFormat::VERSION, (uint32_t)rows, (uint32_t)OUTCOME_COLUMNS });
+	size_t directory = buffer.size();
+	buffer.resize(directory + OUTCOME_COLUMNS * sizeof(ColumnHeader));
+
+	for (size_t i = 0; i < OUTCOME_COLUMNS; i++)
+	{
+		ColumnHeader header{};
+		EncodeColumn(m_Columns[i], buffer, header);
+		std::memcpy(buffer.data() + directory + i * sizeof(ColumnHeader), &header, sizeof(header));
+		m_Columns[i].clear();
+	}
+
+	std::error_code ec;
+	std::filesystem::create_directories(m_Directory, ec);
+
+	char number[16];
+	std::snprintf(number, sizeof(number), "%06u", m_Segment++);
+	std::filesystem::path filePath = m_Directory / (m_FilePrefix + number + OutcomeFormat::EXTENSION);
+	std::filesystem::path tempPath = filePath;
+	tempPath += ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+		m_Failed = !file.write(buffer.data(), (std::streamsize)buffer.size()) || !file.flush();
+	}
+
+	if (!m_Failed)
+	{
+		std::filesystem::rename(tempPath, filePath, ec);
+		m_Failed = (bool)ec;
+	}
+
+	if (m_Failed)
+	{
+		std::filesystem::remove(tempPath, ec);
+		return false;
+	}
+
+	m_BytesWritten += buffer.size();
+	return true;
+}
+
+uint64_t OutcomeStoreWriter::GetRowCount() const
+{
+	return m_RowCount;
+}
+
+uint64_t OutcomeStoreWriter::GetBytesWritten() const
+{
+	return m_BytesWritten;
+}
+
+bool OutcomeStoreWriter::IsFailed() const
+{
+	return m_Failed;
+}
+
+OutcomeSegment::OutcomeSegment()
+	: m_Rows(0),
+	m_Columns(nullptr)
+{
+}
+
+bool OutcomeSegment::Open(const std::filesystem::path& filePath)
+{
+	if (!m_File.Open(filePath))
+		return false;
+
+	size_t headersSize = sizeof(SegmentHeader) + OUTCOME_COLUMNS * sizeof(ColumnHeader);
+	if (m_File.GetSize() < headersSize)
+		return false;
+
+	const SegmentHeader* header = reinterpret_cast<const SegmentHeader*>(m_File.GetData());
+	if (header->Magic != OutcomeFormat::MAGIC || header->Version != OutcomeFormat::VERSION
+		|| header->Columns != OUTCOME_COLUMNS || header->Rows == 0 || header->Rows > GameConfig::Store::SEGMENT_ROWS)
+		return false;
+
+	m_Rows = header->Rows;
+	m_Columns = reinterpret_cast<const ColumnHeader*>(m_File.GetData() + sizeof(SegmentHeader));
+	for (size_t i = 0; i < OUTCOME_COLUMNS; i++)
+	{
+		if (!IsColumnValid(m_Columns[i]))
+			return false;
+	}
+	return true;
+}
+
+uint32_t OutcomeSegment::GetRowCount() const
+{
+	return m_Rows;
+}
+
+const OutcomeFormat::ColumnHeader& OutcomeSegment::GetColumn(OutcomeColumn column) const
+{
+	return m_Columns[(size_t)column];
+}
+
+void OutcomeSegment::Decode(OutcomeColumn column, size_t first, size_t count, uint64_t* out) const
+{
+	const ColumnHeader& header = m_Columns[(size_t)column];
+	const uint64_t* words = reinterpret_cast<const uint64_t*>(m_File.GetData() + header.Offset);
+	uint32_t width = header.Width;
+
+	switch (header.Encoding)
+	{
+	case ColumnEncoding::Constant:
+		std::fill(out, out + count, header.Min);
+		return;
+
+	case ColumnEncoding::BitPacked:
+	{
+		// То же, что Unpack, но без умножения и проверок ширины на каждую строку
+		uint64_t valueMask = width == 64 ? UINT64_MAX : ((uint64_t)1 << width) - 1;
+		size_t bit = first * width;
+		for (size_t i = 0; i < count; i++, bit += width)
+		{
+			size_t word = bit >> 6;
+			uint32_t shift = (uint32_t)(bit & 63);
+			uint64_t value = words[word] >> shift;
+			if (shift + width > 64)
+				value |= words[word + 1] << (64 - shift);
+			out[i] = header.Base + (value & valueMask);
+		}
+		return;
+	}
+
+	case ColumnEncoding::Delta:
+	{
+		// Разжатие идет от начала пачки, в которой лежит first
+		const uint64_t* restarts = words;
+		const uint64_t* deltas = restarts + (m_Rows + BATCH - 1) / BATCH;
+		size_t start = first / BATCH * BATCH;
+		uint64_t value = 0;
+		for (size_t i = start; i < first + count; i++)
+		{
+			if (i % BATCH == 0)
+				value = restarts[i / BATCH];
+			else
+				value += (uint64_t)UnZigZag(header.Base + Unpack(deltas, width, i));
+			if (i >= first)
+				out[i - first] = value;
+		}
+		return;
+	}
+
+	case ColumnEncoding::RunLength:
+	{
+		const uint32_t* ends = reinterpret_cast<const uint32_t*>(words + GetPackedWords(header.Runs, width));
+		size_t run = (size_t)(std::upper_bound(ends, ends + header.Runs, (uint32_t)first) - ends);
+		size_t i = 0;
+		while (i < count)
+		{
+			uint64_t value = header.Base + Unpack(words, width, run);
+			size_t runEnd = std::min<size_t>(ends[run] - first, count);
+			std::fill(out + i, out + runEnd, value);
+			i = runEnd;
+			run++;
+		}
+		return;
+	}
+	}
+}
+
+bool OutcomeSegment::IsColumnValid(const OutcomeFormat::ColumnHeader& column) const
+{
+	if (column.Encoding > ColumnEncoding::RunLength || column.Width > 64 || column.Offset % 8 != 0)
+		return false;
+	if (column.Encoding == ColumnEncoding::RunLength && (column.Runs == 0 || column.Runs > m_Rows))
+		return false;
+
+	size_t expected = GetExpectedSize(column, m_Rows);
+	return column.Offset <= m_File.GetSize() && expected <= m_File.GetSize() - column.Offset && expected <= column.Size + 8;
+}
+
+bool OutcomeStore::Open(const std::filesystem::path& directory)
+{
+	m_Segments.clear();
+
+	std::error_code ec;
+	std::vector<std::filesystem::path> files;
+	for (const auto& entry : std::filesystem::directory_iterator(directory, ec))
+	{
+		if (entry.is_regular_file() && entry.path().extension() == OutcomeFormat::EXTENSION)
+			files.push_back(entry.path());
+	}
+	if (ec)
+		return false;
+
+	// Имена начинаются со времени запуска: сегменты идут в порядке записи
+	std::sort(files.begin(), files.end());
+	for (const std::filesystem::path& file : files)
+	{
+		auto segment = std::make_unique<OutcomeSegment>();
+		if (!segment->Open(file))
+			return false;
+		m_Segments.push_back(std::move(segment));
+	}
+	return true;
+}
+
+const std::vector<std::unique_ptr<OutcomeSegment>>& OutcomeStore::GetSegments() const
+{
+	return m_Segments;
+}
+
+uint64_t OutcomeStore::GetRowCount() const
+{
+	uint64_t rows = 0;
+	for (const auto& segment : m_Segments)
+	{
+		rows += segment->GetRowCount();
+	}
+	return rows;
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "../config/GameConfig.h"
+#include "../domain/CityState.h"
+#include "../utils/MappedFile.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Столбцы хранилища исходов: ключ партии и по столбцу на поле CityState и RoundStatistics.
+// Строка - состояние города после одного раунда.
+enum class OutcomeColumn : uint8_t
+{
+	Point,                  // Точка перебора правил (0 вне перебора)
+	Game,                   // Сквозной номер партии
+	Round,
+	Population,
+	Area,
+	WheatReserves,
+	AcrePrice,
+	WorkableArea,
+	WheatPerAcre,
+	WheatConsumed,
+	DeadFromHunger,
+	NewPeople,
+	WheatEatenByRats,
+	HasPlague,
+	DeadFromHungerPercent,  // RoundStatistics, raw EconomyFixed
+	Count
+};
+
+constexpr size_t OUTCOME_COLUMNS = (size_t)OutcomeColumn::Count;
+
+bool ParseOutcomeColumn(std::string_view name, OutcomeColumn& column);
+const char* GetOutcomeColumnName(OutcomeColumn column);
+
+// Сжатие столбца внутри сегмента; писатель выбирает самое компактное
+enum class ColumnEncoding : uint32_t
+{
+	Constant,       // Все значения равны Min, данных нет
+	BitPacked,      // value - Min упакованы по Width бит
+	Delta,          // Разности соседних (zigzag - Base) по Width бит, полное значение в начале каждой пачки
+	RunLength,      // Значения серий (value - Min по Width бит) и концы серий uint32
+};
+
+// Формат сегмента (little-endian, все смещения кратны 8):
+//   SegmentHeader, затем OUTCOME_COLUMNS x ColumnHeader, затем данные столбцов.
+namespace OutcomeFormat
+{
+	constexpr uint32_t MAGIC = 0x53434D48;      // "HMCS"
+	constexpr uint32_t VERSION = 1;
+	constexpr const char* EXTENSION = ".hmc";
+
+	struct SegmentHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t Rows;
+		uint32_t Columns;
+	};
+
+	struct ColumnHeader
+	{
+		ColumnEncoding Encoding;
+		uint32_t Width;
+		uint64_t Base;
+		uint64_t Min;           // Зональная карта: по ней запрос пропускает сегмент целиком
+		uint64_t Max;
+		uint64_t Offset;        // От начала файла
+		uint64_t Size;
+		uint64_t Runs;          // Серий для RunLength
+	};
+
+	static_assert(sizeof(SegmentHeader) == 16 && sizeof(ColumnHeader) == 56, "Заголовки читаются прямо из отображения");
+}
+
+// Запись строк в сегменты по GameConfig::Store::SEGMENT_ROWS строк.
+// Один писатель - один поток; у параллельных писателей разные номера,
+// и их файлы не пересекаются. Сегмент пишется во временный файл и переименовывается,
+// поэтому читатель видит только целые сегменты. Остаток сбрасывается в деструкторе.
+// После первой неудачной записи сегмента писатель больше ничего не копит и не пишет:
+// Flush возвращает false, IsFailed - true, в GetBytesWritten только записанные сегменты.
+class OutcomeStoreWriter
+{
+public:
+	OutcomeStoreWriter(const std::filesystem::path& directory, uint32_t writerId);
+	~OutcomeStoreWriter();
+
+	OutcomeStoreWriter(const OutcomeStoreWriter&) = delete;
+	OutcomeStoreWriter& operator=(const OutcomeStoreWriter&) = delete;
+
+	void Append(uint32_t point, uint64_t game, const CityState& state, EconomyFixed deadFromHungerPercent);
+	bool Flush();
+
+	uint64_t GetRowCount() const;
+	uint64_t GetBytesWritten() const;
+	bool IsFailed() const;
+
+private:
+	std::filesystem::path m_Directory;
+	std::string m_FilePrefix;       // Запуск и писатель: сегменты разных запусков дописываются рядом
+	uint32_t m_Segment;
+	std::array<std::vector<uint64_t>, OUTCOME_COLUMNS> m_Columns;
+	uint64_t m_RowCount;
+	uint64_t m_BytesWritten;
+	bool m_Failed;
+};
+
+// Сегмент, открытый для чтения
+class OutcomeSegment
+{
+public:
+	OutcomeSegment();
+
+	bool Open(const std::filesystem::path& filePath);
+
+	uint32_t GetRowCount() const;
+	const OutcomeFormat::ColumnHeader& GetColumn(OutcomeColumn column) const;
+	// Значения строк [first, first + count) столбца в out; count не больше пачки GameConfig::Store::BATCH_ROWS
+	void Decode(OutcomeColumn column, size_t first, size_t count, uint64_t* out) const;
+
+private:
+	bool IsColumnValid(const OutcomeFormat::ColumnHeader& column) const;
+
+private:
+	MappedFile m_File;
+	uint32_t m_Rows;
+	const OutcomeFormat::ColumnHeader* m_Columns;
+};
+
+// Все сегменты каталога
+class OutcomeStore
+{
+public:
+	bool Open(const std::filesystem::path& directory);
+
+	const std::vector<std::unique_ptr<OutcomeSegment>>& GetSegments() const;
+	uint64_t GetRowCount() const;
+
+private:
+	std::vector<std::unique_ptr<OutcomeSegment>> m_Segments;
+};
@@ -0,0 +1,231 @@
+#include "ReplayJournal.h"
+#include "../config/GameConfig.h"
+#include <algorithm>
+#include <cstring>
+#include <system_error>
+#include <utility>
+
+namespace
+{
+	template<typename T>
+	void AppendValue(std::vector<char>& buffer, const T& value)
+	{
+		const char* bytes = reinterpret_cast<const char*>(&value);
+		buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+	}
+
+	template<typename T>
+	bool TakeValue(const char*& cursor, const char* end, T& value)
+	{
+		if (end - cursor < (std::ptrdiff_t)sizeof(T))
+			return false;
+		std::memcpy(&value, cursor, sizeof(T));
+		cursor += sizeof(T);
+		return true;
+	}
+}
+
+namespace ReplayFormat
+{
+	void WriteRules(std::vector<char>& buffer, const RuntimeRules& rules)
+	{
+		AppendValue(buffer, rules.MaxRounds);
+		AppendValue(buffer, rules.WheatPerPerson);
+		AppendValue(buffer, rules.AcresPerPerson);
+		AppendValue(buffer, rules.SeedsPerAcre.GetRaw());
+		AppendValue(buffer, rules.MinAcrePrice);
+		AppendValue(buffer, rules.MaxAcrePrice);
+		AppendValue(buffer, rules.MinWheatPerAcre);
+		AppendValue(buffer, rules.MaxWheatPerAcre);
+		AppendValue(buffer, rules.RatsEatMaxPercent.GetRaw());
+		AppendValue(buffer, rules.PlagueProbability);
+		AppendValue(buffer, rules.MaxDeadFromHunger.GetRaw());
+		AppendValue(buffer, rules.MaxNewPeople);
+	}
+
+	bool ReadRules(const char*& cursor, const char* end, RuntimeRules& rules)
+	{
+		int64_t seedsRaw = 0;
+		int64_t ratsRaw = 0;
+		int64_t deadRaw = 0;
+		bool read = TakeValue(cursor, end, rules.MaxRounds)
+			&& TakeValue(cursor, end, rules.WheatPerPerson)
+			&& TakeValue(cursor, end, rules.AcresPerPerson)
+			&& TakeValue(cursor, end, seedsRaw)
+			&& TakeValue(cursor, end, rules.MinAcrePrice)
+			&& TakeValue(cursor, end, rules.MaxAcrePrice)
+			&& TakeValue(cursor, end, rules.MinWheatPerAcre)
+			&& TakeValue(cursor, end, rules.MaxWheatPerAcre)
+			&& TakeValue(cursor, end, ratsRaw)
+			&& TakeValue(cursor, end, rules.PlagueProbability)
+			&& TakeValue(cursor, end, deadRaw)
+			&& TakeValue(cursor, end, rules.MaxNewPeople);
+
+		rules.SeedsPerAcre = EconomyFixed::FromRaw(seedsRaw);
+		rules.RatsEatMaxPercent = EconomyFixed::FromRaw(ratsRaw);
+		rules.MaxDeadFromHunger = EconomyFixed::FromRaw(deadRaw);
+		return read;
+	}
+
+	void WriteState(std::vector<char>& buffer, const CityState& state)
+	{
+		AppendValue(buffer, state.Population);
+		AppendValue(buffer, state.Area);
+		AppendValue(buffer, state.WheatReserves);
+		AppendValue(buffer, state.Round);
+		AppendValue(buffer, state.AcrePrice);
+		AppendValue(buffer, state.WorkableArea);
+		AppendValue(buffer, state.WheatPerAcre);
+		AppendValue(buffer, state.WheatConsumed);
+		AppendValue(buffer, state.DeadFromHunger);
+		AppendValue(buffer, state.NewPeople);
+		AppendValue(buffer, state.WheatEatenByRats);
+		AppendValue(buffer, (uint8_t)state.HasPlague);
+	}
+
+	bool ReadState(const char*& cursor, const char* end, CityState& state)
+	{
+		uint8_t hasPlague = 0;
+		bool ok = TakeValue(cursor, end, state.Population)
+			&& TakeValue(cursor, end, state.Area)
+			&& TakeValue(cursor, end, state.WheatReserves)
+			&& TakeValue(cursor, end, state.Round)
+			&& TakeValue(cursor, end, state.AcrePrice)
+			&& TakeValue(cursor, end, state.WorkableArea)
+			&& TakeValue(cursor, end, state.WheatPerAcre)
+			&& TakeValue(cursor, end, state.WheatConsumed)
+			&& TakeValue(cursor, end, state.DeadFromHunger)
+			&& TakeValue(cursor, end, state.NewPeople)
+			&& TakeValue(cursor, end, state.WheatEatenByRats)
+			&& TakeValue(cursor, end, hasPlague);
+		state.HasPlague = hasPlague != 0;
+		return ok;
+	}
+
+	void WriteRecord(std::vector<char>& buffer, const RoundRecord& record)
+	{
+		AppendValue(buffer, record.Round);
+		AppendValue(buffer, record.Draws.AcrePrice);
+		AppendValue(buffer, record.Draws.WheatPerAcre);
+		AppendValue(buffer, record.Draws.RatsShare.GetRaw());
+		AppendValue(buffer, record.Draws.PlagueRoll);
+		AppendValue(buffer, record.Decisions.BuyLand);
+		AppendValue(buffer, record.Decisions.SellLand);
+		AppendValue(buffer, record.Decisions.WheatForFood);
+		AppendValue(buffer, record.Decisions.AcresToPlant);
+	}
+
+	bool ReadRecord(const char*& cursor, const char* end, RoundRecord& record)
+	{
+		int64_t ratsShareRaw = 0;
+		bool read = TakeValue(cursor, end, record.Round)
+			&& TakeValue(cursor, end, record.Draws.AcrePrice)
+			&& TakeValue(cursor, end, record.Draws.WheatPerAcre)
+			&& TakeValue(cursor, end, ratsShareRaw)
+			&& TakeValue(cursor, end, record.Draws.PlagueRoll)
+			&& TakeValue(cursor, end, record.Decisions.BuyLand)
+			&& TakeValue(cursor, end, record.Decisions.SellLand)
+			&& TakeValue(cursor, end, record.Decisions.WheatForFood)
+			&& TakeValue(cursor, end, record.Decisions.AcresToPlant);
+
+		record.Draws.RatsShare = EconomyFixed::FromRaw(ratsShareRaw);
+		return read;
+	}
+}
+
+ReplayJournal::ReplayJournal()
+	: m_RecordCount(0)
+{
+}
+
+ReplayJournal::~ReplayJournal()
+{
+	Close();
+}
+
+bool ReplayJournal::Open(const std::filesystem::path& filePath, const CityState& initialState, const RuntimeRules& rules)
+{
+	Close();
+
+	std::error_code ec;
+	std::filesystem::create_directories(filePath.parent_path(), ec);
+
+	m_File.open(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!m_File.is_open())
+		return false;
+
+	m_RecordCount = 0;
+	m_Buffer.clear();
+	m_Buffer.reserve(GameConfig::Replay::FLUSH_BYTES * 2);
+
+	AppendValue(m_Buffer, ReplayFormat::MAGIC);
+	AppendValue(m_Buffer, ReplayFormat::VERSION);
+	AppendValue(m_Buffer, GameConfig::Replay::CHECKPOINT_INTERVAL);
+	ReplayFormat::WriteRules(m_Buffer, rules);
+	ReplayFormat::WriteState(m_Buffer, initialState);
+	return true;
+}
+
+void ReplayJournal::AppendRound(const RoundRecord& record, const CityState& stateAfter)
+{
+	if (!m_File.is_open())
+		return;
+
+	AppendValue(m_Buffer, ReplayFormat::FRAME_ROUND);
+	ReplayFormat::WriteRecord(m_Buffer, record);
+	m_RecordCount++;
+
+	// Контрольная точка k - состояние перед записью номер k * CHECKPOINT_INTERVAL
+	if (m_RecordCount % GameConfig::Replay::CHECKPOINT_INTERVAL == 0)
+	{
+		AppendValue(m_Buffer, ReplayFormat::FRAME_CHECKPOINT);
+		ReplayFormat::WriteState(m_Buffer, stateAfter);
+	}
+
+	if (m_Buffer.size() >= GameConfig::Replay::FLUSH_BYTES)
+		Flush();
+}
+
+void ReplayJournal::Flush()
+{
+	if (!m_File.is_open() || m_Buffer.empty())
+		return;
+
+	m_File.write(m_Buffer.data(), (std::streamsize)m_Buffer.size());
+	m_File.flush();
+	m_Buffer.clear();
+}
+
+void ReplayJournal::Close()
+{
+	if (!m_File.is_open())
+		return;
+
+	Flush();
+	m_File.close();
+}
+
+bool ReplayJournal::IsOpen() const
+{
+	return m_File.is_open();
+}
+
+void ReplayJournal::RemoveOldest(const std::filesystem::path& directory, size_t keep)
+{
+	std::error_code ec;
+	std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> journals;
+	for (const auto& entry : std::filesystem::directory_iterator(directory, ec))
+	{
+		if (entry.is_regular_file(ec) && entry.path().extension() == ".bin")
+			journals.emplace_back(entry.last_write_time(ec), entry.path());
+	}
+
+	if (journals.size() <= keep)
+		return;
+
+	std::sort(journals.begin(), journals.end());
+	for (size_t i = 0; i < journals.size() - keep; i++)
+	{
+		std::filesystem::remove(journals[i].second, ec);
+	}
+}
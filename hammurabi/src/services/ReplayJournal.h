@@ -0,0 +1,66 @@
+#pragma once
+
+#include "../config/GameRules.h"
+#include "../domain/CityState.h"
+#include "../domain/PlayerDecisions.h"
+#include "../domain/RoundDraws.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+// Запись журнала об одном раунде: все случайные величины и решения игрока
+struct RoundRecord
+{
+	uint32_t Round;
+	RoundDraws Draws;
+	PlayerDecisions Decisions;
+};
+
+// Формат журнала (little-endian, без выравнивания):
+//   заголовок: "HMRJ", версия, интервал контрольных точек, правила партии, начальный CityState;
+//   далее кадры: тип кадра (uint32) + RoundRecord либо CityState контрольной точки.
+namespace ReplayFormat
+{
+	constexpr uint32_t MAGIC = 0x4A524D48;  // "HMRJ"
+	// 2: правила партии в заголовке - повтор идет по тем же правилам, что и игра.
+	// 3: дробные правила и доля крыс - EconomyFixed (int64) вместо float.
+	// Флаг WIDE_QUANTITIES отмечает 64-битные количества (HAMMURABI_LARGE_SCALE):
+	// такой журнал не читается обычной сборкой, и наоборот.
+	constexpr uint32_t WIDE_QUANTITIES = 0x100;
+	constexpr uint32_t VERSION = 3 | (sizeof(Quantity) == 8 ? WIDE_QUANTITIES : 0);
+	constexpr uint32_t FRAME_ROUND = 1;
+	constexpr uint32_t FRAME_CHECKPOINT = 2;
+
+	void WriteRules(std::vector<char>& buffer, const RuntimeRules& rules);
+	bool ReadRules(const char*& cursor, const char* end, RuntimeRules& rules);
+	void WriteState(std::vector<char>& buffer, const CityState& state);
+	bool ReadState(const char*& cursor, const char* end, CityState& state);
+	void WriteRecord(std::vector<char>& buffer, const RoundRecord& record);
+	bool ReadRecord(const char*& cursor, const char* end, RoundRecord& record);
+}
+
+// Журнал партии только на дописывание.
+// Кадры копятся в памяти и сбрасываются в файл пачками, без fsync на каждый раунд.
+// Каждые CHECKPOINT_INTERVAL раундов пишется полный CityState,
+// чтобы повтор любого раунда не требовал проигрывать партию с начала.
+class ReplayJournal
+{
+public:
+	ReplayJournal();
+	~ReplayJournal();
+
+	bool Open(const std::filesystem::path& filePath, const CityState& initialState, const RuntimeRules& rules);
+	void AppendRound(const RoundRecord& record, const CityState& stateAfter);
+	void Flush();
+	void Close();
+	bool IsOpen() const;
+
+	// Удаляет самые старые журналы папки, оставляя не больше keep
+	static void RemoveOldest(const std::filesystem::path& directory, size_t keep);
+
+private:
+	std::ofstream m_File;
+	std::vector<char> m_Buffer;
+	uint32_t m_RecordCount;
+};
@@ -0,0 +1,108 @@
+#include "ReportTemplate.h"
+#include <charconv>
+
+ReportTemplate::ReportTemplate(std::string_view text)
+{
+	// Имена полей вырезаются: в m_Text остаются только литералы подряд
+	size_t literalStart = 0;
+	size_t position = 0;
+	while (position < text.size())
+	{
+		size_t open = text.find('{', position);
+		if (open == std::string_view::npos)
+			break;
+		size_t close = text.find('}', open + 1);
+		if (close == std::string_view::npos)
+			break;
+
+		ReportField field = ParseField(text.substr(open + 1, close - open - 1));
+		if (field == ReportField::None)
+		{
+			position = open + 1;
+			continue;
+		}
+
+		size_t offset = m_Text.size();
+		m_Text.append(text.substr(literalStart, open - literalStart));
+		m_Segments.push_back(Segment{ offset, m_Text.size() - offset, field });
+		literalStart = close + 1;
+		position = close + 1;
+	}
+
+	size_t offset = m_Text.size();
+	m_Text.append(text.substr(literalStart));
+	m_Segments.push_back(Segment{ offset, m_Text.size() - offset, ReportField::None });
+}
+
+void ReportTemplate::AppendTo(const CityState& state, std::string& output) const
+{
+	std::string_view text = m_Text;
+	for (const Segment& segment : m_Segments)
+	{
+		output.append(text.substr(segment.Offset, segment.Length));
+		if (segment.Field == ReportField::None)
+			continue;
+
+		char digits[24];
+		auto result = std::to_chars(digits, digits + sizeof(digits), GetFieldValue(state, segment.Field));
+		output.append(digits, result.ptr);
+	}
+}
+
+uint64_t ReportTemplate::GetFieldValue(const CityState& state, ReportField field)
+{
+	switch (field)
+	{
+	case ReportField::Round:
+		return state.Round;
+	case ReportField::DeadFromHunger:
+		return state.DeadFromHunger;
+	case ReportField::NewPeople:
+		return state.NewPeople;
+	case ReportField::Population:
+		return state.Population;
+	case ReportField::WheatPerAcre:
+		return state.WheatPerAcre;
+	case ReportField::Harvested:
+		// Ровно то, что ApplyCityHarvest добавил к запасам, без заворота через ноль
+		return QuantityMul(state.WorkableArea, state.WheatPerAcre);
+	case ReportField::WheatEatenByRats:
+		return state.WheatEatenByRats;
+	case ReportField::WheatReserves:
+		return state.WheatReserves;
+	case ReportField::AcrePrice:
+		return state.AcrePrice;
+	case ReportField::HasPlague:
+		return state.HasPlague ? 1 : 0;
+	case ReportField::None:
+	default:
+		return 0;
+	}
+}
+
+ReportField ReportTemplate::ParseField(std::string_view name)
+{
+	static constexpr struct
+	{
+		std::string_view Name;
+		ReportField Field;
+	} FIELDS[] = {
+		{ "Round", ReportField::Round },
+		{ "DeadFromHunger", ReportField::DeadFromHunger },
+		{ "NewPeople", ReportField::NewPeople },
+		{ "Population", ReportField::Population },
+		{ "WheatPerAcre", ReportField::WheatPerAcre },
+		{ "Harvested", ReportField::Harvested },
+		{ "WheatEatenByRats", ReportField::WheatEatenByRats },
+		{ "WheatReserves", ReportField::WheatReserves },
+		{ "AcrePrice", ReportField::AcrePrice },
+		{ "HasPlague", ReportField::HasPlague },
+	};
+
+	for (const auto& entry : FIELDS)
+	{
+		if (entry.Name == name)
+			return entry.Field;
+	}
+	return ReportField::None;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "../domain/CityState.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Поля города, которые можно подставить в шаблон отчета
+enum class ReportField : uint8_t
+{
+	None,
+	Round,
+	DeadFromHunger,
+	NewPeople,
+	Population,
+	WheatPerAcre,
+	Harvested,          // WorkableArea * WheatPerAcre
+	WheatEatenByRats,
+	WheatReserves,
+	AcrePrice,
+	HasPlague           // 1 или 0; удобно как условие строки
+};
+
+// Шаблон строки отчета вида "Сейчас в городе {Population} жителей.".
+// Текст разбирается один раз в конструкторе на куски: литерал и следующее за ним поле.
+// AppendTo дописывает строку в переданный буфер, числа пишутся через std::to_chars -
+// если у буфера хватает емкости, память не выделяется.
+// Неизвестное имя в скобках остается в тексте как есть.
+class ReportTemplate
+{
+public:
+	explicit ReportTemplate(std::string_view text);
+
+	void AppendTo(const CityState& state, std::string& output) const;
+
+	static uint64_t GetFieldValue(const CityState& state, ReportField field);
+
+private:
+	struct Segment
+	{
+		size_t Offset;          // Литерал в m_Text
+		size_t Length;
+		ReportField Field;      // Поле после литерала, None - в конце шаблона
+	};
+
+	static ReportField ParseField(std::string_view name);
+
+private:
+	std::string m_Text;
+	std::vector<Segment> m_Segments;
+};
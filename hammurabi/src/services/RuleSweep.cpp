@@ -0,0 +1,372 @@
+#include "RuleSweep.h"
+#include "EnginePool.h"
+#include "GameEngine.h"
+#include "../utils/SplitMix64.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+namespace
+{
+	constexpr size_t FLUSH_ROWS = 64;           // Строк CSV между сбросами файла на диск
+	constexpr uint32_t GAME_SEED_STEP = 0x9E3779B9u;
+
+	// Правила, которые в RuntimeRules хранятся дробными
+	bool IsFractionalRule(const std::string& name)
+	{
+		return name == "SEEDS_PER_ACRE" || name == "RATS_EAT_MAX_PERCENT" || name == "MAX_DEAD_FROM_HUNGER";
+	}
+
+	double SnapValue(const std::string& name, double value)
+	{
+		return IsFractionalRule(name) ? value : std::round(value);
+	}
+}
+
+SweepConfig::SweepConfig()
+	: Mode(SweepMode::Grid),
+	Points(0),
+	GamesPerPoint(1000),
+	Seed(1),
+	Strategy(ScriptedStrategy::FeedAndPlant),
+	Threads(0),
+	BaseRules(),
+	Dimensions(),
+	StorePath()
+{
+}
+
+bool SweepConfig::LoadFromFile(const std::filesystem::path& path)
+{
+	std::ifstream file(path);
+	if (!file.is_open())
+		return false;
+
+	std::string line;
+	while (std::getline(file, line))
+	{
+		size_t comment = line.find('#');
+		if (comment != std::string::npos)
+			line.erase(comment);
+
+		std::istringstream fields(line);
+		std::string key;
+		if (!(fields >> key))
+			continue;
+
+		bool read = false;
+		if (key == "MODE")
+		{
+			std::string mode;
+			read = (bool)(fields >> mode) && (mode == "grid" || mode == "lhs");
+			Mode = mode == "lhs" ? SweepMode::LatinHypercube : SweepMode::Grid;
+		}
+		else if (key == "POINTS")
+			read = (bool)(fields >> Points);
+		else if (key == "GAMES")
+			read = (bool)(fields >> GamesPerPoint);
+		else if (key == "SEED")
+			read = (bool)(fields >> Seed);
+		else if (key == "THREADS")
+			read = (bool)(fields >> Threads);
+		else if (key == "STRATEGY")
+		{
+			std::string name;
+			read = (bool)(fields >> name) && ParseScriptedStrategy(name, Strategy);
+		}
+		else if (key == "RULE")
+		{
+			std::string name;
+			double value = 0.0;
+			read = (bool)(fields >> name >> value) && BaseRules.Set(name, value);
+		}
+		else if (key == "SWEEP")
+		{
+			SweepDimension dimension{};
+			RuntimeRules probe;
+			read = (bool)(fields >> dimension.Name >> dimension.Min >> dimension.Max >> dimension.Steps)
+				&& probe.Set(dimension.Name, dimension.Min)
+				&& dimension.Min <= dimension.Max && dimension.Steps > 0;
+			Dimensions.push_back(dimension);
+		}
+		else if (key == "STORE")
+		{
+			std::string directory;
+			read = (bool)(fields >> directory);
+			StorePath = directory;
+		}
+
+		if (!read)
+		{
+			std::cout << "Ошибка в задании перебора: " << line << "\n";
+			return false;
+		}
+	}
+
+	if (Mode == SweepMode::LatinHypercube && Points == 0)
+		return false;
+	return !Dimensions.empty() && GamesPerPoint > 0;
+}
+
+RuleSweep::RuleSweep(const SweepConfig& config)
+	: m_Config(config),
+	m_PointCount(0),
+	m_NextPoint(0),
+	m_StoreFailed(false),
+	m_NextToWrite(0)
+{
+	if (m_Config.Threads == 0)
+		m_Config.Threads = std::max(1u, std::thread::hardware_concurrency());
+
+	if (m_Config.Mode == SweepMode::Grid)
+	{
+		m_PointCount = 1;
+		for (const SweepDimension& dimension : m_Config.Dimensions)
+		{
+			m_PointCount *= dimension.Steps;
+		}
+	}
+	else
+	{
+		m_PointCount = m_Config.Points;
+		BuildLatinHypercube();
+	}
+}
+
+bool RuleSweep::Run(const std::filesystem::path& outputPath)
+{
+	m_Output.open(outputPath, std::ios::out | std::ios::trunc);
+	if (!m_Output.is_open())
+		return false;
+	WriteHeader();
+
+	auto started = std::chrono::steady_clock::now();
+
+	std::vector<std::thread> workers;
+	for (uint32_t i = 0; i < m_Config.Threads; i++)
+	{
+		workers.emplace_back(&RuleSweep::WorkerLoop, this, i);
+	}
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+	m_Output.flush();
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+	double games = (double)m_PointCount * m_Config.GamesPerPoint;
+	std::cout << "Точек: " << m_PointCount << ", партий: " << games
+		<< ", время: " << seconds << " с, партий в секунду: " << (seconds > 0.0 ? games / seconds : 0.0) << "\n";
+
+	if (m_StoreFailed.load(std::memory_order_relaxed))
+	{
+		std::cout << "Не удалось записать исходы в " << m_Config.StorePath.string() << "\n";
+		return false;
+	}
+
+	return m_NextToWrite == m_PointCount && m_Output.good();
+}
+
+size_t RuleSweep::GetPointCount() const
+{
+	return m_PointCount;
+}
+
+void RuleSweep::BuildLatinHypercube()
+{
+	// Для каждого правила - своя перестановка слоев, внутри слоя - случайный сдвиг
+	size_t dimensions = m_Config.Dimensions.size();
+	m_LhsValues.assign(m_PointCount * dimensions, 0.0);
+
+	// Перемешивание и сдвиги - свои, а не std::shuffle и распределения <random>:
+	// план перебора по одному зерну совпадает в любой стандартной библиотеке
+	SplitMix64 random(m_Config.Seed);
+	std::vector<size_t> strata(m_PointCount);
+
+	for (size_t d = 0; d < dimensions; d++)
+	{
+		const SweepDimension& dimension = m_Config.Dimensions[d];
+		std::iota(strata.begin(), strata.end(), 0);
+		for (size_t i = strata.size(); i > 1; i--)
+		{
+			std::swap(strata[i - 1], strata[random.NextBelow(i)]);
+		}
+
+		for (size_t i = 0; i < m_PointCount; i++)
+		{
+			double fraction = ((double)strata[i] + random.NextUnit()) / (double)m_PointCount;
+			double value = dimension.Min + fraction * (dimension.Max - dimension.Min);
+			m_LhsValues[i * dimensions + d] = SnapValue(dimension.Name, value);
+		}
+	}
+}
+
+void RuleSweep::GetPointValues(size_t index, std::vector<double>& values) const
+{
+	size_t dimensions = m_Config.Dimensions.size();
+	values.resize(dimensions);
+
+	if (m_Config.Mode == SweepMode::LatinHypercube)
+	{
+		std::copy_n(m_LhsValues.begin() + index * dimensions, dimensions, values.begin());
+		return;
+	}
+
+	// Номер точки сетки - число в смешанной системе счисления, разряд на правило
+	for (size_t d = dimensions; d-- > 0;)
+	{
+		const SweepDimension& dimension = m_Config.Dimensions[d];
+		size_t step = index % dimension.Steps;
+		index /= dimension.Steps;
+
+		double value = dimension.Min;
+		if (dimension.Steps > 1)
+			value += (dimension.Max - dimension.Min) * (double)step / (double)(dimension.Steps - 1);
+		values[d] = SnapValue(dimension.Name, value);
+	}
+}
+
+void RuleSweep::WorkerLoop(uint32_t worker)
+{
+	// У каждого потока свой писатель: сегменты пишутся без общей блокировки
+	std::unique_ptr<OutcomeStoreWriter> store;
+	if (!m_Config.StorePath.empty())
+		store = std::make_unique<OutcomeStoreWriter>(m_Config.StorePath, worker);
+
+	while (true)
+	{
+		size_t index = m_NextPoint.fetch_add(1, std::memory_order_relaxed);
+		if (index >= m_PointCount)
+			break;
+
+		Publish(RunPoint(index, store.get()));
+	}
+
+	if (store && !store->Flush())
+		m_StoreFailed.store(true, std::memory_order_relaxed);
+}
+
+SweepPointResult RuleSweep::RunPoint(size_t index, OutcomeStoreWriter* store) const
+{
+	SweepPointResult result{};
+	result.Index = index;
+	GetPointValues(index, result.Values);
+
+	// Отвергнутое значение оставило бы в точке базовое правило - такая точка недопустима
+	RuntimeRules rules = m_Config.BaseRules;
+	bool applied = true;
+	for (size_t d = 0; d < m_Config.Dimensions.size(); d++)
+	{
+		applied = rules.Set(m_Config.Dimensions[d].Name, result.Values[d]) && applied;
+	}
+
+	result.Valid = applied && rules.IsConsistent();
+	if (!result.Valid)
+		return result;
+
+	// Один движок на точку: каждая партия начинается сбросом, а не созданием
+	BasicEnginePool<RuntimeRules>::Handle pooled = BasicEnginePool<RuntimeRules>::Acquire(m_Config.Seed, rules);
+	BasicGameEngine<RuntimeRules>& engine = *pooled;
+
+	for (uint32_t game = 0; game < m_Config.GamesPerPoint; game++)
+	{
+		engine.Reset(m_Config.Seed + game * GAME_SEED_STEP);
+
+		while (true)
+		{
+			engine.StartRound();
+			engine.PlayRound(DecideScripted(m_Config.Strategy, engine.GetState(), rules));
+			if (store)
+			{
+				const CityState& state = engine.GetState();
+				uint64_t gameNumber = (uint64_t)index * m_Config.GamesPerPoint + game;
+				store->Append((uint32_t)index, gameNumber, state, engine.GetStats().GetRoundStatistics(state.Round).DeadFromHungerPercent);
+			}
+
+			if (engine.CheckGameOver())
+			{
+				result.HungerLosses++;
+				break;
+			}
+
+			engine.AdvanceRound();
+			if (engine.IsCompleted())
+			{
+				const CityState& state = engine.GetState();
+				GameStatistics::Rating rating = engine.GetStats().GetRating(state.Area, state.Population);
+
+				result.Completed++;
+				if (rating == GameStatistics::Rating::Good || rating == GameStatistics::Rating::Excellent)
+					result.Wins++;
+				result.PopulationSum += state.Population;
+				result.AcresPerPersonSum += engine.GetStats().CalculateAcresPerPerson(state.Area, state.Population);
+				break;
+			}
+		}
+		result.Games++;
+	}
+
+	return result;
+}
+
+void RuleSweep::Publish(SweepPointResult&& result)
+{
+	std::lock_guard<std::mutex> lock(m_OutputMutex);
+	m_Pending.emplace(result.Index, std::move(result));
+
+	// Пишем все точки, идущие подряд от первой незаписанной
+	size_t written = 0;
+	for (auto it = m_Pending.begin(); it != m_Pending.end() && it->first == m_NextToWrite; it = m_Pending.erase(it))
+	{
+		WriteRow(it->second);
+		m_NextToWrite++;
+		written++;
+	}
+
+	if (written > 0 && m_NextToWrite % FLUSH_ROWS < written)
+	{
+		m_Output.flush();
+		std::cout << "Точек готово: " << m_NextToWrite << " / " << m_PointCount << "\r" << std::flush;
+	}
+}
+
+void RuleSweep::WriteHeader()
+{
+	m_Output << "point";
+	for (const SweepDimension& dimension : m_Config.Dimensions)
+	{
+		m_Output << ',' << dimension.Name;
+	}
+	m_Output << ",strategy,valid,games,completed,wins,hunger_losses,win_rate,win_rate_stderr,mean_population,mean_acres_per_person\n";
+}
+
+void RuleSweep::WriteRow(const SweepPointResult& result)
+{
+	m_Output << result.Index;
+	for (double value : result.Values)
+	{
+		m_Output << ',' << value;
+	}
+
+	double games = result.Games > 0 ? (double)result.Games : 1.0;
+	double completed = result.Completed > 0 ? (double)result.Completed : 1.0;
+	double winRate = result.Wins / games;
+	double stderrWinRate = std::sqrt(winRate * (1.0 - winRate) / games);
+
+	m_Output << ',' << GetScriptedStrategyName(m_Config.Strategy)
+		<< ',' << (result.Valid ? 1 : 0)
+		<< ',' << result.Games
+		<< ',' << result.Completed
+		<< ',' << result.Wins
+		<< ',' << result.HungerLosses
+		<< ',' << winRate
+		<< ',' << stderrWinRate
+		<< ',' << result.PopulationSum / completed
+		<< ',' << result.AcresPerPersonSum / completed
+		<< '\n';
+}
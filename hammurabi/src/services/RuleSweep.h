@@ -0,0 +1,105 @@
+#pragma once
+
+#include "../config/GameRules.h"
+#include "../domain/ScriptedStrategy.h"
+#include "OutcomeStore.h"
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Способ выбора точек в пространстве правил
+enum class SweepMode : uint8_t
+{
+	Grid,               // Все сочетания равномерных шагов по каждому правилу
+	LatinHypercube,     // POINTS точек, по одной в каждом слое каждого правила
+};
+
+// Одно варьируемое правило: имя как в GameConfig::Game, диапазон и число шагов сетки
+struct SweepDimension
+{
+	std::string Name;
+	double Min;
+	double Max;
+	uint32_t Steps;
+};
+
+// Задание на перебор. Файл - строки "КЛЮЧ значения", '#' начинает комментарий:
+//   MODE grid | lhs
+//   POINTS 10000                       (для lhs)
+//   GAMES 10000                        партий на точку
+//   SEED 42                            зерно общих случайных чисел
+//   STRATEGY feed | trader
+//   THREADS 0                          0 - по числу ядер
+//   RULE MAX_ROUNDS 10                 фиксированное правило
+//   SWEEP PLAGUE_PROBABILITY 0 30 7    варьируемое правило: от, до, шагов сетки
+//   STORE outcomes                     каталог хранилища исходов: строка на каждый раунд
+struct SweepConfig
+{
+	SweepMode Mode;
+	uint32_t Points;
+	uint32_t GamesPerPoint;
+	uint32_t Seed;
+	ScriptedStrategy Strategy;
+	uint32_t Threads;
+	RuntimeRules BaseRules;
+	std::vector<SweepDimension> Dimensions;
+	std::filesystem::path StorePath;    // Пусто - раунды не сохраняются
+
+	SweepConfig();
+
+	bool LoadFromFile(const std::filesystem::path& path);
+};
+
+// Итог партий одной точки
+struct SweepPointResult
+{
+	size_t Index;
+	std::vector<double> Values;
+	bool Valid;                 // Правила точки непротиворечивы (иначе партии не играются)
+	uint32_t Games;
+	uint32_t Completed;         // Дошли до последнего раунда
+	uint32_t Wins;              // Дошли с оценкой "хорошо" или "отлично"
+	uint32_t HungerLosses;      // Свергнуты за голод
+	double PopulationSum;
+	double AcresPerPersonSum;
+};
+
+// Монте-Карло по точкам пространства правил.
+// Точки раздаются потокам по одной; партия с номером g в каждой точке
+// получает одно и то же зерно (общие случайные числа), поэтому разница
+// между точками меньше зашумлена погодой. Результаты пишутся в CSV
+// по порядку точек сразу по готовности.
+class RuleSweep
+{
+public:
+	explicit RuleSweep(const SweepConfig& config);
+
+	bool Run(const std::filesystem::path& outputPath);
+	size_t GetPointCount() const;
+
+private:
+	void BuildLatinHypercube();
+	void GetPointValues(size_t index, std::vector<double>& values) const;
+	void WorkerLoop(uint32_t worker);
+	SweepPointResult RunPoint(size_t index, OutcomeStoreWriter* store) const;
+	void Publish(SweepPointResult&& result);
+	void WriteHeader();
+	void WriteRow(const SweepPointResult& result);
+
+private:
+	SweepConfig m_Config;
+	size_t m_PointCount;
+	std::vector<double> m_LhsValues;    // Точки LHS построчно: m_PointCount x число правил
+
+	std::atomic<size_t> m_NextPoint;
+	std::atomic<bool> m_StoreFailed;    // Какой-то поток не смог записать исходы
+	std::mutex m_OutputMutex;
+	std::map<size_t, SweepPointResult> m_Pending;   // Готовые точки, ждущие своей очереди в файл
+	size_t m_NextToWrite;
+	std::ofstream m_Output;
+};
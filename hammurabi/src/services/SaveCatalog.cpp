@@ -0,0 +1,281 @@
+#include "SaveCatalog.h"
+#include "../config/GameConfig.h"
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <system_error>
+
+namespace
+{
+	// Первая строка файла. Имя пишется с длиной впереди: в нем бывают пробелы
+	const std::string CATALOG_HEADER = "HMCAT 2";
+
+	void WriteEntry(std::ostream& file, const SaveCatalogEntry& entry)
+	{
+		file << entry.Name.size() << ' ' << entry.Name << ' ' << entry.Round << ' ' << entry.Population << ' ' << entry.Timestamp << '\n';
+	}
+
+	bool ReadEntry(std::istream& file, SaveCatalogEntry& entry)
+	{
+		size_t length = 0;
+		if (!(file >> length) || file.get() != ' ')
+			return false;
+
+		entry.Name.resize(length);
+		if (!file.read(entry.Name.data(), (std::streamsize)length))
+			return false;
+
+		return (bool)(file >> entry.Round >> entry.Population >> entry.Timestamp);
+	}
+
+	// Слишком много перезаписанных строк - файл пора сжать
+	bool IsBloated(size_t records, size_t entries)
+	{
+		return records > entries * 2 + 64;
+	}
+}
+
+SaveCatalog& SaveCatalog::Instance()
+{
+	static SaveCatalog instance(GameConfig::Paths::SAVES_DIR, GameConfig::Paths::SAVES_CATALOG);
+	return instance;
+}
+
+SaveCatalog::SaveCatalog(const std::filesystem::path& savesPath, const std::filesystem::path& catalogPath)
+	: m_SavesPath(savesPath),
+	m_CatalogPath(catalogPath),
+	m_RecordCount(0),
+	m_Loaded(false)
+{
+}
+
+void SaveCatalog::Load()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	LoadLocked();
+}
+
+void SaveCatalog::LoadLocked()
+{
+	if (m_Loaded)
+		return;
+	m_Loaded = true;
+
+	std::error_code ec;
+	if (!std::filesystem::exists(m_SavesPath, ec))
+	{
+		// Папки нет - каталог от прежних сохранений недействителен
+		std::filesystem::remove(m_CatalogPath, ec);
+		return;
+	}
+
+	if (IsStale() || !ReadCatalog())
+	{
+		Rebuild();
+		return;
+	}
+
+	if (IsBloated(m_RecordCount, m_Entries.size()))
+	{
+		WriteCatalog();
+	}
+}
+
+bool SaveCatalog::IsEmpty()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	LoadLocked();
+	return m_Entries.empty();
+}
+
+size_t SaveCatalog::Size()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	LoadLocked();
+	return m_Entries.size();
+}
+
+bool SaveCatalog::Find(const std::string& name, SaveCatalogEntry& entry)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	LoadLocked();
+	auto it = m_Index.find(name);
+	if (it != m_Index.end())
+	{
+		entry = m_Entries[it->second];
+		return true;
+	}
+
+	// Имя можно ввести без расширения файла
+	for (const SaveCatalogEntry& candidate : m_Entries)
+	{
+		if (std::filesystem::path(candidate.Name).stem() == name)
+		{
+			entry = candidate;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool SaveCatalog::At(size_t index, SaveCatalogEntry& entry)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	LoadLocked();
+	if (index >= m_Entries.size())
+		return false;
+	entry = m_Entries[index];
+	return true;
+}
+
+std::vector<SaveCatalogEntry> SaveCatalog::GetPage(size_t page, size_t pageSize)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	LoadLocked();
+	std::vector<SaveCatalogEntry> result;
+
+	size_t first = page * pageSize;
+	if (first >= m_Entries.size())
+		return result;
+
+	size_t last = std::min(first + pageSize, m_Entries.size());
+	result.assign(m_Entries.begin() + first, m_Entries.begin() + last);
+	return result;
+}
+
+void SaveCatalog::Update(const std::string& name, const CityState& state)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	LoadLocked();
+
+	SaveCatalogEntry entry;
+	entry.Name = name;
+	entry.Round = state.Round;
+	entry.Population = state.Population;
+	entry.Timestamp = static_cast<int64_t>(std::time(nullptr));
+	Upsert(entry);
+
+	// Файла еще нет (или в нем нет строк) - пишем его целиком, с заголовком.
+	// Автосохранение каждый раунд перезаписывает одно имя, поэтому раздутый файл сжимается сразу.
+	if (m_RecordCount == 0 || IsBloated(m_RecordCount + 1, m_Entries.size()))
+	{
+		WriteCatalog();
+		return;
+	}
+
+	// Дописываем одну строку: при чтении последняя запись с тем же именем побеждает
+	std::ofstream file(m_CatalogPath, std::ios::out | std::ios::app);
+	if (!file.is_open())
+		return;
+
+	WriteEntry(file, entry);
+	m_RecordCount++;
+}
+
+bool SaveCatalog::IsStale() const
+{
+	std::error_code ec;
+	auto catalogTime = std::filesystem::last_write_time(m_CatalogPath, ec);
+	if (ec)
+		return true;
+
+	// Добавление или удаление файла обновляет время изменения папки
+	auto savesTime = std::filesystem::last_write_time(m_SavesPath, ec);
+	if (ec)
+		return true;
+
+	return savesTime > catalogTime;
+}
+
+bool SaveCatalog::ReadCatalog()
+{
+	std::ifstream file(m_CatalogPath);
+	if (!file.is_open())
+		return false;
+
+	m_Entries.clear();
+	m_Index.clear();
+	m_RecordCount = 0;
+
+	std::string header;
+	if (!std::getline(file, header) || header != CATALOG_HEADER)
+		return false;
+
+	SaveCatalogEntry entry;
+	while (ReadEntry(file, entry))
+	{
+		Upsert(entry);
+		m_RecordCount++;
+	}
+
+	return file.eof();
+}
+
+void SaveCatalog::Rebuild()
+{
+	m_Entries.clear();
+	m_Index.clear();
+
+	std::error_code ec;
+	for (const auto& dirEntry : std::filesystem::directory_iterator(m_SavesPath, ec))
+	{
+		if (!dirEntry.is_regular_file(ec) || dirEntry.file_size(ec) == 0)
+			continue;
+
+		// Заголовок сохранения: раунд, умершие, прибывшие, чума, население
+		std::ifstream file(dirEntry.path());
+		Quantity deadFromHunger = 0;
+		Quantity newPeople = 0;
+		bool hasPlague = false;
+
+		SaveCatalogEntry entry;
+		entry.Name = dirEntry.path().filename().string();
+		if (!(file >> entry.Round >> deadFromHunger >> newPeople >> hasPlague >> entry.Population))
+			continue;
+
+		auto fileTime = dirEntry.last_write_time(ec);
+		auto sysTime = std::chrono::file_clock::to_sys(fileTime);
+		entry.Timestamp = std::chrono::duration_cast<std::chrono::seconds>(sysTime.time_since_epoch()).count();
+
+		Upsert(entry);
+	}
+
+	WriteCatalog();
+}
+
+void SaveCatalog::WriteCatalog()
+{
+	// Пишем во временный файл и подменяем, чтобы не оставить каталог недописанным
+	std::filesystem::path tmpPath = m_CatalogPath;
+	tmpPath += ".tmp";
+
+	{
+		std::ofstream file(tmpPath, std::ios::out | std::ios::trunc);
+		if (!file.is_open())
+			return;
+
+		file << CATALOG_HEADER << '\n';
+		for (const SaveCatalogEntry& entry : m_Entries)
+		{
+			WriteEntry(file, entry);
+		}
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(tmpPath, m_CatalogPath, ec);
+	m_RecordCount = m_Entries.size();
+}
+
+void SaveCatalog::Upsert(const SaveCatalogEntry& entry)
+{
+	auto it = m_Index.find(entry.Name);
+	if (it != m_Index.end())
+	{
+		m_Entries[it->second] = entry;
+		return;
+	}
+
+	m_Index.emplace(entry.Name, m_Entries.size());
+	m_Entries.push_back(entry);
+}
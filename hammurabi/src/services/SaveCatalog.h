@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../domain/CityState.h"
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Запись каталога сохранений
+struct SaveCatalogEntry
+{
+	std::string Name;       // Имя файла сохранения
+	uint32_t Round;         // Раунд на момент сохранения
+	Quantity Population;    // Население на момент сохранения
+	int64_t Timestamp;      // Время сохранения (секунды Unix)
+};
+
+// Постоянный каталог сохранений: избавляет от обхода папки ./Saves/ при каждом запросе.
+// Файл каталога дописывается при каждом сохранении и перестраивается по диску,
+// только если он отсутствует или папка сохранений изменилась позже него.
+// Один файл - один объект: все SaveManager процесса (в том числе в потоке
+// автосохранения) работают с Instance(), методы защищены общей блокировкой.
+class SaveCatalog
+{
+public:
+	SaveCatalog(const std::filesystem::path& savesPath, const std::filesystem::path& catalogPath);
+
+	// Каталог GameConfig::Paths::SAVES_CATALOG
+	static SaveCatalog& Instance();
+
+	void Load();
+	bool IsEmpty();
+	size_t Size();
+	// Записи возвращаются копиями: сохранение из другого потока может сдвинуть массив.
+	// Find ищет по точному имени файла, а если такого нет - по имени без расширения
+	bool Find(const std::string& name, SaveCatalogEntry& entry);
+	bool At(size_t index, SaveCatalogEntry& entry);
+	std::vector<SaveCatalogEntry> GetPage(size_t page, size_t pageSize);
+
+	void Update(const std::string& name, const CityState& state);
+
+private:
+	void LoadLocked();
+	bool IsStale() const;
+	bool ReadCatalog();
+	void Rebuild();
+	void WriteCatalog();
+	void Upsert(const SaveCatalogEntry& entry);
+
+private:
+	std::mutex m_Mutex;
+	std::filesystem::path m_SavesPath;
+	std::filesystem::path m_CatalogPath;
+	std::vector<SaveCatalogEntry> m_Entries;
+	std::unordered_map<std::string, size_t> m_Index;   // Имя -> позиция в m_Entries
+	size_t m_RecordCount;                              // Строк в файле каталога (с учетом перезаписей)
+	bool m_Loaded;
+};
@@ -1,27 +1,19 @@
 #include "SaveManager.h"
 #include "../config/GameConfig.h"
 #include "../utils/utility.h"
+#include "../utils/Profiler.h"
 #include <fstream>
 #include <iostream>
-#include <unordered_map>
-#include <algorithm>
 
 SaveManager::SaveManager()
-	: m_SavesPath(GameConfig::Paths::SAVES_DIR)
+	: m_SavesPath(GameConfig::Paths::SAVES_DIR),
+	m_Catalog(SaveCatalog::Instance())
 {
 }
 
-bool SaveManager::HasSaves() const
+bool SaveManager::HasSaves()
 {
-	if (!std::filesystem::exists(m_SavesPath))
-		return false;
-	
-	for (const auto& entry : std::filesystem::directory_iterator(m_SavesPath))
-	{
-		if (entry.is_regular_file() && entry.file_size() > 0)
-			return true;
-	}
-	return false;
+	return !m_Catalog.IsEmpty();
 }
 
 bool SaveManager::RequestLoad() const
@@ -30,65 +22,80 @@ bool SaveManager::RequestLoad() const
 	return ProcessOneshotInput();
 }
 
-std::vector<std::filesystem::path> SaveManager::GetSaveFiles() const
+std::vector<std::filesystem::path> SaveManager::GetSaveFiles()
 {
 	std::vector<std::filesystem::path> saveFiles;
+	SaveCatalogEntry entry;
 	
-	if (!std::filesystem::exists(m_SavesPath))
-		return saveFiles;
-	
-	for (const auto& entry : std::filesystem::directory_iterator(m_SavesPath))
+	for (size_t i = 0; m_Catalog.At(i, entry); i++)
 	{
-		if (entry.is_regular_file())
-			saveFiles.push_back(entry.path());
+		saveFiles.push_back(m_SavesPath / entry.Name);
 	}
 	
 	return saveFiles;
 }
 
-std::filesystem::path SaveManager::ChooseSaveFile() const
+void SaveManager::PrintSavesPage(size_t page)
 {
-	std::cout << GameConfig::Messages::SAVE_FILE_PROMPT;
-	
-	std::vector<std::filesystem::path> saveFiles = GetSaveFiles();
-	std::unordered_map<uint32_t, std::filesystem::path> saveMap;
+	const size_t pageSize = GameConfig::Game::SAVES_PAGE_SIZE;
+	std::vector<SaveCatalogEntry> entries = m_Catalog.GetPage(page, pageSize);
 	
-	uint32_t index = 1;
-	for (size_t i = 0; i < saveFiles.size(); i++)
+	size_t index = page * pageSize + 1;
+	for (size_t i = 0; i < entries.size(); i++)
 	{
-		std::cout << index << ": " << saveFiles[i].filename() << std::endl;
-		saveMap[index] = saveFiles[i];
+		std::cout << index << ": " << entries[i].Name
+			<< " (раунд " << entries[i].Round
+			<< ", население " << entries[i].Population << ")\n";
 		index = index + 1;
 	}
 	
+	if (m_Catalog.Size() > pageSize)
+	{
+		std::cout << GameConfig::Messages::SAVE_NEXT_PAGE_HINT;
+	}
+}
+
+std::filesystem::path SaveManager::ChooseSaveFile()
+{
+	std::cout << GameConfig::Messages::SAVE_FILE_PROMPT;
+	
+	const size_t pageSize = GameConfig::Game::SAVES_PAGE_SIZE;
+	size_t page = 0;
+	PrintSavesPage(page);
+	
 	std::string input;
 	std::filesystem::path chosenFile;
 	
 	while (std::cin >> input)
 	{
-		try
+		// Каталог общий: автосохранение из другого потока может изменить число страниц
+		size_t pageCount = (m_Catalog.Size() + pageSize - 1) / pageSize;
+		if (pageCount == 0)
+			return chosenFile;
+		
+		if (input == ">")
 		{
-			uint32_t fileNum = std::stoul(input);
-			if (fileNum > 0 && fileNum <= saveFiles.size())
+			page = (page + 1) % pageCount;
+			PrintSavesPage(page);
+			continue;
+		}
+		
+		int32_t fileNum = 0;
+		SaveCatalogEntry entry;
+		if (TryParseInteger(input, fileNum))
+		{
+			if (fileNum > 0 && m_Catalog.At((size_t)fileNum - 1, entry))
 			{
-				chosenFile = saveMap[fileNum];
+				chosenFile = m_SavesPath / entry.Name;
 				break;
 			}
 			std::cout << "Введен неправильный номер файла, попробуйте еще раз.\n";
 		}
-		catch (const std::invalid_argument&)
+		else
 		{
-			auto it = std::find_if(saveMap.begin(), saveMap.end(),
-				[&input](const auto& pair)
-				{
-					auto inputPath = std::filesystem::path(input);
-					return pair.second.filename() == inputPath
-						|| pair.second.filename().stem() == inputPath;
-				});
-			
-			if (it != saveMap.end())
+			if (m_Catalog.Find(input, entry))
 			{
-				chosenFile = it->second;
+				chosenFile = m_SavesPath / entry.Name;
 				break;
 			}
 			std::cout << "Такого сохранения нет, попробуйте еще раз.\n";
@@ -122,17 +129,23 @@ bool SaveManager::LoadFromFile(const std::filesystem::path& filePath, CityState&
 	file >> state.Area;
 	file >> state.AcrePrice;
 	
+	// Первые MAX_ROUNDS раундов - десятичными дробями, как и до перехода на EconomyFixed.
+	// Несыгранные раунды в файле нулевые и в статистику не попадают.
 	for (uint32_t i = 1; i <= GameStatistics::MAX_ROUNDS; i++)
 	{
 		float deadPercent;
 		file >> deadPercent;
-		stats.SetRoundStatistics(i, deadPercent);
+		if (i <= state.Round)
+			stats.SetRoundStatistics(i, EconomyFixed::FromFloat(deadPercent));
 	}
 	
+	// Дальше - сводные величины партии любой длины; в старых сохранениях их нет
+	stats.ReadAggregates(file);
+	
 	return true;
 }
 
-bool SaveManager::LoadGame(CityState& state, GameStatistics& stats) const
+bool SaveManager::LoadGame(CityState& state, GameStatistics& stats)
 {
 	if (!HasSaves() || !RequestLoad())
 		return false;
@@ -144,17 +157,19 @@ bool SaveManager::LoadGame(CityState& state, GameStatistics& stats) const
 	return LoadFromFile(chosenFile, state, stats);
 }
 
-bool SaveManager::SaveToFile(const std::filesystem::path& filePath, const CityState& state, const GameStatistics& stats) const
+bool SaveManager::SaveToFile(const std::filesystem::path& filePath, const CityState& state, const GameStatistics& stats)
 {
+	PROFILE_SCOPE(ProfilePhase::Save);
+	
 	if (!std::filesystem::exists(m_SavesPath))
 		std::filesystem::create_directory(m_SavesPath);
 	
+	// Каталог читаем до записи файла, иначе новое сохранение сделает его устаревшим
+	m_Catalog.Load();
+	
 	std::ofstream file(filePath, std::ios::out | std::ios::trunc);
 	if (!file.is_open())
-	{
-		std::cout << GameConfig::Messages::SAVE_ERROR;
 		return false;
-	}
 	
 	file << state.Round << std::endl;
 	file << state.DeadFromHunger << std::endl;
@@ -174,15 +189,20 @@ bool SaveManager::SaveToFile(const std::filesystem::path& filePath, const CitySt
 	for (uint32_t i = 1; i <= GameStatistics::MAX_ROUNDS; i++)
 	{
 		RoundStatistics roundStats = stats.GetRoundStatistics(i);
-		file << roundStats.DeadFromHungerPercent << std::endl;
+		file << roundStats.DeadFromHungerPercent.ToFloat() << std::endl;
 	}
+	// Старые версии дочитывают файл до этого места, остальное для них невидимо
+	stats.WriteAggregates(file);
+	file.close();
+	
+	m_Catalog.Update(filePath.filename().string(), state);
 	
 	return true;
 }
 
-bool SaveManager::SaveGame(const CityState& state, const GameStatistics& stats) const
+bool SaveManager::SaveGame(const CityState& state, const GameStatistics& stats)
 {
-	system("cls");
+	ClearScreen();
 	std::cout << GameConfig::Messages::SAVE_NAME_PROMPT;
 	
 	std::string filename;
@@ -190,6 +210,17 @@ bool SaveManager::SaveGame(const CityState& state, const GameStatistics& stats)
 	
 	std::filesystem::path fullPath = m_SavesPath / filename;
 	
-	return SaveToFile(fullPath, state, stats);
+	if (!SaveToFile(fullPath, state, stats))
+	{
+		std::cout << GameConfig::Messages::SAVE_ERROR;
+		return false;
+	}
+	return true;
+}
+
+bool SaveManager::SaveAutosave(const CityState& state, const GameStatistics& stats)
+{
+	// Вызывается из фонового потока, поэтому ничего не выводит
+	return SaveToFile(m_SavesPath / GameConfig::Paths::AUTOSAVE_NAME, state, stats);
 }
 
@@ -2,24 +2,31 @@
 
 #include "../domain/CityState.h"
 #include "../domain/Statistics.h"
+#include "SaveCatalog.h"
 #include <filesystem>
 #include <string>
 #include <vector>
 
 class SaveManager
 {
+	// Замеры HammurabiBench вызывают закрытые методы напрямую
+	friend class BenchmarkAccess;
+
 public:
 	SaveManager();
-	bool HasSaves() const;
+	bool HasSaves();
 	bool RequestLoad() const;
-	bool LoadGame(CityState& state, GameStatistics& stats) const;
-	bool SaveGame(const CityState& state, const GameStatistics& stats) const;
-	std::vector<std::filesystem::path> GetSaveFiles() const;
+	bool LoadGame(CityState& state, GameStatistics& stats);
+	bool SaveGame(const CityState& state, const GameStatistics& stats);
+	bool SaveAutosave(const CityState& state, const GameStatistics& stats);
+	std::vector<std::filesystem::path> GetSaveFiles();
 
 private:
 	std::filesystem::path m_SavesPath;
-	std::filesystem::path ChooseSaveFile() const;
+	SaveCatalog& m_Catalog;    // Общий для всех SaveManager процесса
+	std::filesystem::path ChooseSaveFile();
+	void PrintSavesPage(size_t page);
 	bool LoadFromFile(const std::filesystem::path& filePath, CityState& state, GameStatistics& stats) const;
-	bool SaveToFile(const std::filesystem::path& filePath, const CityState& state, const GameStatistics& stats) const;
+	bool SaveToFile(const std::filesystem::path& filePath, const CityState& state, const GameStatistics& stats);
 };
 
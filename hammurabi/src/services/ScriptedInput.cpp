@@ -0,0 +1,124 @@
+#include "ScriptedInput.h"
+#include "../config/GameConfig.h"
+
+namespace
+{
+	bool IsSeparator(char symbol)
+	{
+		return symbol == ' ' || symbol == '\t' || symbol == '\n' || symbol == '\r' || symbol == '\v' || symbol == '\f';
+	}
+}
+
+ScriptedInput::ScriptedInput()
+	: m_File(nullptr),
+	m_OwnsFile(false),
+	m_EndOfFile(true),
+	m_Position(0),
+	m_TokenCount(0)
+{
+	m_Buffer.reserve(GameConfig::Script::READ_CHUNK * 2);
+}
+
+ScriptedInput::~ScriptedInput()
+{
+	if (m_OwnsFile && m_File != nullptr)
+		std::fclose(m_File);
+}
+
+bool ScriptedInput::Open(const std::filesystem::path& path)
+{
+	if (path == "-")
+	{
+		m_File = stdin;
+		m_OwnsFile = false;
+	}
+	else
+	{
+		m_File = std::fopen(path.string().c_str(), "rb");
+		m_OwnsFile = true;
+	}
+
+	m_EndOfFile = m_File == nullptr;
+	m_Buffer.clear();
+	m_Position = 0;
+	return m_File != nullptr;
+}
+
+bool ScriptedInput::NextToken(std::string_view& token)
+{
+	if (!SkipSeparators())
+		return false;
+
+	// Токен должен целиком лежать в буфере: дочитываем, пока он упирается в конец
+	size_t end = m_Position;
+	while (true)
+	{
+		while (end < m_Buffer.size() && !IsSeparator(m_Buffer[end]) && m_Buffer[end] != '#')
+		{
+			end++;
+		}
+		if (end < m_Buffer.size() || m_EndOfFile)
+			break;
+
+		size_t offset = end - m_Position;
+		if (!Refill())
+			break;
+		end = m_Position + offset;
+	}
+
+	token = std::string_view(m_Buffer.data() + m_Position, end - m_Position);
+	m_Position = end;
+	m_TokenCount++;
+	return true;
+}
+
+bool ScriptedInput::IsExhausted()
+{
+	return !SkipSeparators();
+}
+
+uint64_t ScriptedInput::GetTokenCount() const
+{
+	return m_TokenCount;
+}
+
+bool ScriptedInput::SkipSeparators()
+{
+	bool inComment = false;
+	while (true)
+	{
+		while (m_Position < m_Buffer.size())
+		{
+			char symbol = m_Buffer[m_Position];
+			if (inComment)
+				inComment = symbol != '\n';
+			else if (symbol == '#')
+				inComment = true;
+			else if (!IsSeparator(symbol))
+				return true;
+			m_Position++;
+		}
+
+		if (!Refill())
+			return false;
+	}
+}
+
+bool ScriptedInput::Refill()
+{
+	if (m_EndOfFile)
+		return false;
+
+	// Непрочитанный хвост переносится в начало, чтобы буфер не рос
+	m_Buffer.erase(0, m_Position);
+	m_Position = 0;
+
+	size_t kept = m_Buffer.size();
+	m_Buffer.resize(kept + GameConfig::Script::READ_CHUNK);
+	size_t read = std::fread(m_Buffer.data() + kept, 1, GameConfig::Script::READ_CHUNK, m_File);
+	m_Buffer.resize(kept + read);
+
+	if (read < GameConfig::Script::READ_CHUNK)
+		m_EndOfFile = true;
+	return read > 0;
+}
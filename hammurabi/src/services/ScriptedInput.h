@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+// Поток ответов для InputHandler без терминала: числа через пробелы или
+// переводы строк, '#' - комментарий до конца строки. Источник - файл или
+// канал ("-" - стандартный ввод); читается большими кусками, токен
+// возвращается видом на буфер без копирования и живет до следующего вызова.
+class ScriptedInput
+{
+public:
+	ScriptedInput();
+	~ScriptedInput();
+
+	ScriptedInput(const ScriptedInput&) = delete;
+	ScriptedInput& operator=(const ScriptedInput&) = delete;
+
+	bool Open(const std::filesystem::path& path);
+	// false - ответы кончились
+	bool NextToken(std::string_view& token);
+	bool IsExhausted();
+	uint64_t GetTokenCount() const;
+
+private:
+	bool SkipSeparators();
+	bool Refill();
+
+private:
+	std::FILE* m_File;
+	bool m_OwnsFile;
+	bool m_EndOfFile;
+	std::string m_Buffer;
+	size_t m_Position;          // Начало непрочитанной части m_Buffer
+	uint64_t m_TokenCount;
+};
@@ -0,0 +1,182 @@
+#include "StatePublisher.h"
+#include "../config/GameConfig.h"
+#include <cstring>
+#include <new>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	using MonitorFormat::SharedBlock;
+	using MonitorFormat::WORDS;
+
+#ifdef __linux__
+	uint32_t GetProcessId()
+	{
+		return (uint32_t)getpid();
+	}
+#endif
+}
+
+std::string GetMonitorName(uint32_t processId)
+{
+	return GameConfig::Monitor::SHARED_NAME_PREFIX + std::to_string(processId);
+}
+
+StatePublisher::StatePublisher()
+	: m_Block(nullptr),
+	m_Name(),
+	m_Updates(0)
+{
+}
+
+StatePublisher::~StatePublisher()
+{
+	Close();
+}
+
+bool StatePublisher::Open()
+{
+	Close();
+
+#ifdef __linux__
+	m_Name = GetMonitorName(GetProcessId());
+	int fd = shm_open(m_Name.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd < 0)
+		return false;
+
+	void* data = MAP_FAILED;
+	if (ftruncate(fd, sizeof(SharedBlock)) == 0)
+		data = mmap(nullptr, sizeof(SharedBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+	{
+		shm_unlink(m_Name.c_str());
+		return false;
+	}
+
+	// Заголовок заполняется до Magic: наблюдатель, открывший память раньше, ее не примет
+	m_Block = new (data) SharedBlock();
+	m_Block->Version = MonitorFormat::VERSION;
+	m_Block->Words = (uint32_t)WORDS;
+	m_Block->ProcessId = GetProcessId();
+	m_Block->Sequence.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	m_Block->Magic = MonitorFormat::MAGIC;
+	return true;
+#else
+	return false;
+#endif
+}
+
+void StatePublisher::Close()
+{
+#ifdef __linux__
+	if (m_Block)
+	{
+		munmap(m_Block, sizeof(SharedBlock));
+		shm_unlink(m_Name.c_str());
+	}
+#endif
+	m_Block = nullptr;
+}
+
+void StatePublisher::Publish(const CityState& state, const RoundStatistics& statistics, ProfilePhase phase)
+{
+	if (!m_Block)
+		return;
+
+	MonitorSnapshot snapshot{ state, statistics, phase, ++m_Updates };
+	uint64_t words[WORDS] = {};
+	std::memcpy(words, &snapshot, sizeof(snapshot));
+
+	// Писатель один, поэтому счетчик читается без гонок; нечетный - запись началась
+	uint64_t sequence = m_Block->Sequence.load(std::memory_order_relaxed);
+	m_Block->Sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	for (size_t i = 0; i < WORDS; i++)
+	{
+		m_Block->Payload[i].store(words[i], std::memory_order_relaxed);
+	}
+	m_Block->Sequence.store(sequence + 2, std::memory_order_release);
+}
+
+StateMonitor::StateMonitor()
+	: m_Block(nullptr)
+{
+}
+
+StateMonitor::~StateMonitor()
+{
+	Close();
+}
+
+bool StateMonitor::Open(uint32_t processId)
+{
+	Close();
+
+#ifdef __linux__
+	int fd = shm_open(GetMonitorName(processId).c_str(), O_RDONLY | O_CLOEXEC, 0);
+	if (fd < 0)
+		return false;
+
+	void* data = mmap(nullptr, sizeof(SharedBlock), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+		return false;
+
+	m_Block = (const SharedBlock*)data;
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (m_Block->Magic != MonitorFormat::MAGIC || m_Block->Version != MonitorFormat::VERSION || m_Block->Words != WORDS)
+	{
+		Close();
+		return false;
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+void StateMonitor::Close()
+{
+#ifdef __linux__
+	if (m_Block)
+		munmap((void*)m_Block, sizeof(SharedBlock));
+#endif
+	m_Block = nullptr;
+}
+
+bool StateMonitor::Read(MonitorSnapshot& snapshot) const
+{
+	if (!m_Block)
+		return false;
+
+	uint64_t words[WORDS];
+	for (uint32_t attempt = 0; attempt < GameConfig::Monitor::READ_ATTEMPTS; attempt++)
+	{
+		uint64_t before = m_Block->Sequence.load(std::memory_order_acquire);
+		if (before == 0)
+			return false;       // Игра еще ничего не опубликовала
+		if (before & 1)
+			continue;
+
+		for (size_t i = 0; i < WORDS; i++)
+		{
+			words[i] = m_Block->Payload[i].load(std::memory_order_relaxed);
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		// Счетчик не сдвинулся - слова взяты из одной публикации
+		if (m_Block->Sequence.load(std::memory_order_relaxed) == before)
+		{
+			std::memcpy(&snapshot, words, sizeof(snapshot));
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "../domain/CityState.h"
+#include "../domain/Statistics.h"
+#include "../utils/Profiler.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+// Состояние партии, каким его видит наблюдатель
+struct MonitorSnapshot
+{
+	CityState State;
+	RoundStatistics Statistics;     // Последнего сыгранного раунда
+	ProfilePhase Phase;             // После какой фазы раунда снято
+	uint64_t Updates;               // Публикаций с начала работы игры
+};
+
+static_assert(std::is_trivially_copyable_v<MonitorSnapshot>, "Снимок копируется в разделяемую память по словам");
+
+// Разделяемая память: заголовок и снимок под seqlock.
+// Снимок хранится атомарными словами: наблюдатель может читать их во время записи,
+// а несогласованную копию отбрасывает по счетчику.
+namespace MonitorFormat
+{
+	constexpr uint32_t MAGIC = 0x4E4F4D48;      // "HMON"
+	constexpr uint32_t VERSION = 1;
+	constexpr size_t WORDS = (sizeof(MonitorSnapshot) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+	struct SharedBlock
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t Words;
+		uint32_t ProcessId;
+		alignas(64) std::atomic<uint64_t> Sequence;    // Нечетный - идет запись
+		std::atomic<uint64_t> Payload[WORDS];
+	};
+
+	static_assert(std::atomic<uint64_t>::is_always_lock_free, "Атомарные слова должны работать между процессами");
+}
+
+std::string GetMonitorName(uint32_t processId);
+
+// Писатель: игра публикует состояние после каждой фазы раунда.
+// Публикация - только записи в отображенную память, без системных вызовов и блокировок;
+// медленный или зависший наблюдатель игру не задерживает.
+// Разделяемая память есть только в Linux, на остальных платформах Open возвращает false.
+class StatePublisher
+{
+public:
+	StatePublisher();
+	~StatePublisher();
+
+	StatePublisher(const StatePublisher&) = delete;
+	StatePublisher& operator=(const StatePublisher&) = delete;
+
+	// Память с именем GetMonitorName(pid) этого процесса; удаляется в Close
+	bool Open();
+	void Close();
+
+	void Publish(const CityState& state, const RoundStatistics& statistics, ProfilePhase phase);
+
+private:
+	MonitorFormat::SharedBlock* m_Block;
+	std::string m_Name;
+	uint64_t m_Updates;
+};
+
+// Наблюдатель в другом процессе: читает снимки без блокировок, писателя не тормозит
+class StateMonitor
+{
+public:
+	StateMonitor();
+	~StateMonitor();
+
+	StateMonitor(const StateMonitor&) = delete;
+	StateMonitor& operator=(const StateMonitor&) = delete;
+
+	bool Open(uint32_t processId);
+	void Close();
+
+	// false - писатель все READ_ATTEMPTS попыток был посреди записи
+	bool Read(MonitorSnapshot& snapshot) const;
+
+private:
+	const MonitorFormat::SharedBlock* m_Block;
+};
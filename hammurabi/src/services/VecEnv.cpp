@@ -0,0 +1,172 @@
+#include "VecEnv.h"
+#include "../domain/CityRound.h"
+#include "../domain/DecisionBounds.h"
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+	constexpr size_t CHUNK = GameConfig::VecEnv::ENVS_PER_CHUNK;
+	constexpr float POPULATION_REWARD = 1.0f / (float)GameConfig::Initial::POPULATION;
+}
+
+template<typename Rules>
+BasicVecEnv<Rules>::BasicVecEnv(const VecEnvConfig& config, const Rules& rules)
+	: m_Rules(rules),
+	m_Config(config),
+	m_Pool(config.Threads),
+	m_Actions(nullptr),
+	m_Observations(nullptr),
+	m_Rewards(nullptr),
+	m_Dones(nullptr)
+{
+	m_Config.Envs = std::max(m_Config.Envs, 1u);
+	m_Envs.resize(m_Config.Envs);
+	m_Episodes.assign((m_Config.Envs + CHUNK - 1) / CHUNK, 0);
+
+	for (size_t i = 0; i < m_Envs.size(); i++)
+	{
+		m_Envs[i].Random = SplitMix64(SplitMix64::MakeSeed(m_Config.Seed, i));
+		StartEpisode(m_Envs[i]);
+	}
+
+	m_StepBody = [this](size_t begin, size_t end) { StepRange(begin, end); };
+}
+
+template<typename Rules>
+void BasicVecEnv<Rules>::Reset(float* observations)
+{
+	for (size_t i = 0; i < m_Envs.size(); i++)
+	{
+		StartEpisode(m_Envs[i]);
+		WriteObservation(m_Envs[i].State, observations + i * OBSERVATION_SIZE);
+	}
+}
+
+template<typename Rules>
+void BasicVecEnv<Rules>::Step(const PlayerDecisions* actions, float* observations, float* rewards, uint8_t* dones)
+{
+	m_Actions = actions;
+	m_Observations = observations;
+	m_Rewards = rewards;
+	m_Dones = dones;
+
+	m_Pool.ParallelFor(m_Envs.size(), CHUNK, m_StepBody);
+}
+
+template<typename Rules>
+uint32_t BasicVecEnv<Rules>::GetEnvCount() const
+{
+	return (uint32_t)m_Envs.size();
+}
+
+template<typename Rules>
+uint32_t BasicVecEnv<Rules>::GetThreadCount() const
+{
+	return m_Pool.GetThreadCount();
+}
+
+template<typename Rules>
+uint64_t BasicVecEnv<Rules>::GetEpisodeCount() const
+{
+	return std::accumulate(m_Episodes.begin(), m_Episodes.end(), (uint64_t)0);
+}
+
+template<typename Rules>
+void BasicVecEnv<Rules>::StartEpisode(Env& env)
+{
+	// Генератор не пересоздается: следующая партия продолжает поток среды
+	env.State = CityState();
+	env.Stats = GameStatistics();
+	StartRound(env);
+}
+
+template<typename Rules>
+void BasicVecEnv<Rules>::StartRound(Env& env)
+{
+	// Счетчики прошлого раунда остаются в наблюдении и сбрасываются в начале шага
+	env.State.AcrePrice = DrawAcrePrice(env.Random, m_Rules);
+}
+
+template<typename Rules>
+float BasicVecEnv<Rules>::PlayRound(Env& env, const PlayerDecisions& action, bool& done)
+{
+	CityState& state = env.State;
+	Quantity populationBefore = state.Population;
+
+	DecisionBounds bounds(state, m_Rules);
+	PlayerDecisions decisions{};
+	decisions.BuyLand = std::clamp(action.BuyLand, 0, bounds.GetMaxBuy());
+	decisions.SellLand = decisions.BuyLand > 0 ? 0 : std::clamp(action.SellLand, 0, bounds.GetMaxSell());
+	decisions.WheatForFood = std::clamp(action.WheatForFood, 0, bounds.GetMaxFood(decisions));
+	decisions.AcresToPlant = std::clamp(action.AcresToPlant, 0, bounds.GetMaxPlant(decisions));
+
+	ResetCityRound(state);
+	ApplyCityDecisions(state, decisions, m_Rules);
+
+	RoundDraws draws{};
+	draws.AcrePrice = state.AcrePrice;
+	DrawCityRound(draws, env.Random, m_Rules);
+
+	ApplyCityHarvest(state, draws);
+	ApplyCityRats(state, draws);
+	EconomyFixed deadPercent = ApplyCityHunger(state, m_Rules);
+	env.Stats.SetRoundStatistics(state.Round, deadPercent);
+	ApplyCityNewPeople(state, m_Rules);
+	ApplyCityPlague(state, draws, m_Rules);
+
+	float reward = ((float)state.Population - (float)populationBefore) * POPULATION_REWARD;
+
+	// Те же условия, что CheckGameOver и IsCompleted движка
+	done = deadPercent >= m_Rules.MaxDeadFromHunger;
+	if (done)
+	{
+		reward += GameConfig::VecEnv::OVERTHROWN_REWARD;
+	}
+	else if (++state.Round >= m_Rules.MaxRounds)
+	{
+		GameStatistics::Rating rating = env.Stats.GetRating(state.Area, state.Population);
+		reward += GameConfig::VecEnv::RATING_REWARD * (float)rating;
+		done = true;
+	}
+
+	if (done)
+		StartEpisode(env);
+	else
+		StartRound(env);
+	return reward;
+}
+
+template<typename Rules>
+void BasicVecEnv<Rules>::WriteObservation(const CityState& state, float* observation) const
+{
+	observation[(size_t)VecEnvObservation::Population] = (float)state.Population;
+	observation[(size_t)VecEnvObservation::Area] = (float)state.Area;
+	observation[(size_t)VecEnvObservation::WheatReserves] = (float)state.WheatReserves;
+	observation[(size_t)VecEnvObservation::Round] = (float)state.Round;
+	observation[(size_t)VecEnvObservation::AcrePrice] = (float)state.AcrePrice;
+	observation[(size_t)VecEnvObservation::WorkableArea] = (float)state.WorkableArea;
+	observation[(size_t)VecEnvObservation::WheatPerAcre] = (float)state.WheatPerAcre;
+	observation[(size_t)VecEnvObservation::WheatConsumed] = (float)state.WheatConsumed;
+	observation[(size_t)VecEnvObservation::DeadFromHunger] = (float)state.DeadFromHunger;
+	observation[(size_t)VecEnvObservation::NewPeople] = (float)state.NewPeople;
+	observation[(size_t)VecEnvObservation::WheatEatenByRats] = (float)state.WheatEatenByRats;
+	observation[(size_t)VecEnvObservation::HasPlague] = state.HasPlague ? 1.0f : 0.0f;
+}
+
+template<typename Rules>
+void BasicVecEnv<Rules>::StepRange(size_t begin, size_t end)
+{
+	uint64_t& episodes = m_Episodes[begin / CHUNK];
+	for (size_t i = begin; i < end; i++)
+	{
+		bool done = false;
+		m_Rewards[i] = PlayRound(m_Envs[i], m_Actions[i], done);
+		m_Dones[i] = done ? 1 : 0;
+		episodes += done ? 1 : 0;
+		WriteObservation(m_Envs[i].State, m_Observations + i * OBSERVATION_SIZE);
+	}
+}
+
+template class BasicVecEnv<DefaultRules>;
+template class BasicVecEnv<RuntimeRules>;
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "../config/GameRules.h"
+#include "../domain/CityState.h"
+#include "../domain/PlayerDecisions.h"
+#include "../domain/Statistics.h"
+#include "../utils/SplitMix64.h"
+#include "../utils/ThreadPool.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Поля наблюдения одной среды, по порядку в буфере наблюдений
+enum class VecEnvObservation : uint32_t
+{
+	Population,
+	Area,
+	WheatReserves,
+	Round,
+	AcrePrice,
+	WorkableArea,
+	WheatPerAcre,
+	WheatConsumed,
+	DeadFromHunger,
+	NewPeople,
+	WheatEatenByRats,
+	HasPlague,
+	Count
+};
+
+struct VecEnvConfig
+{
+	uint32_t Envs;
+	uint32_t Seed;
+	uint32_t Threads;       // 0 - по числу ядер
+};
+
+// Пакет независимых партий для обучения агентов, в духе VecEnv из Gym.
+// Буферы принадлежат вызывающему и лежат подряд по средам:
+//   действия     - Envs x PlayerDecisions (четыре int32: купить, продать, еда, посев);
+//   наблюдения   - Envs x OBSERVATION_SIZE float;
+//   награды      - Envs float, завершения - Envs uint8_t.
+// Действия приводятся к допустимым границами DecisionBounds. Награда шага -
+// прирост населения в долях начального; в конце партии добавляется награда
+// за оценку или штраф за свержение. Завершенная партия сразу начинается заново,
+// и в наблюдение пишется уже первый раунд новой партии.
+// Шаг не выделяет память: куски сред раздаются пулу потоков.
+template<typename Rules>
+class BasicVecEnv
+{
+public:
+	static constexpr size_t OBSERVATION_SIZE = (size_t)VecEnvObservation::Count;
+
+	explicit BasicVecEnv(const VecEnvConfig& config, const Rules& rules = Rules());
+
+	BasicVecEnv(const BasicVecEnv&) = delete;
+	BasicVecEnv& operator=(const BasicVecEnv&) = delete;
+
+	void Reset(float* observations);
+	void Step(const PlayerDecisions* actions, float* observations, float* rewards, uint8_t* dones);
+
+	uint32_t GetEnvCount() const;
+	uint32_t GetThreadCount() const;
+	uint64_t GetEpisodeCount() const;
+
+private:
+	// Одна среда: город, статистика партии и свой генератор
+	struct Env
+	{
+		CityState State;
+		GameStatistics Stats;
+		SplitMix64 Random;
+	};
+
+	void StartEpisode(Env& env);
+	void StartRound(Env& env);
+	float PlayRound(Env& env, const PlayerDecisions& action, bool& done);
+	void WriteObservation(const CityState& state, float* observation) const;
+	void StepRange(size_t begin, size_t end);
+
+private:
+	Rules m_Rules;
+	VecEnvConfig m_Config;
+	ThreadPool m_Pool;
+	std::vector<Env> m_Envs;
+	std::vector<uint64_t> m_Episodes;   // Завершенных партий по кускам сред
+
+	// Буферы текущего шага; тело цикла создается один раз, чтобы шаг не выделял память
+	const PlayerDecisions* m_Actions;
+	float* m_Observations;
+	float* m_Rewards;
+	uint8_t* m_Dones;
+	std::function<void(size_t, size_t)> m_StepBody;
+};
+
+extern template class BasicVecEnv<DefaultRules>;
+extern template class BasicVecEnv<RuntimeRules>;
+
+using VecEnv = BasicVecEnv<DefaultRules>;
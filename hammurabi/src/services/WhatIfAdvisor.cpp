@@ -0,0 +1,205 @@
+#include "WhatIfAdvisor.h"
+#include "../config/GameConfig.h"
+#include "../domain/CityRound.h"
+#include "../utils/SplitMix64.h"
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+	constexpr size_t SAMPLES = GameConfig::Advisor::PREVIEW_SAMPLES;
+	constexpr size_t CHUNK = GameConfig::Advisor::SAMPLES_PER_CHUNK;
+	constexpr size_t WAVE = GameConfig::Advisor::SAMPLES_PER_WAVE;
+
+	static_assert(WAVE % CHUNK == 0 && SAMPLES % WAVE == 0, "Волна и прогноз состоят из целых кусков");
+
+	OutcomeRange GetRange(std::vector<Quantity>& values, size_t count)
+	{
+		// nth_element по возрастанию: каждый следующий процентиль ищется правее предыдущего
+		auto begin = values.begin();
+		auto end = values.begin() + count;
+		OutcomeRange range{};
+		std::nth_element(begin, begin + count / 10, end);
+		range.Low = begin[count / 10];
+		std::nth_element(begin + count / 10, begin + count / 2, end);
+		range.Median = begin[count / 2];
+		std::nth_element(begin + count / 2, begin + count * 9 / 10, end);
+		range.High = begin[count * 9 / 10];
+		return range;
+	}
+}
+
+template<typename Rules>
+BasicWhatIfAdvisor<Rules>::BasicWhatIfAdvisor(const Rules& rules, uint32_t threads)
+	: m_Rules(rules),
+	m_Threads(threads),
+	m_CacheHits(0),
+	m_Partial(),
+	m_Start(),
+	m_Decisions(),
+	m_Seed(0),
+	m_WaveStart(0)
+{
+}
+
+template<typename Rules>
+void BasicWhatIfAdvisor<Rules>::SetRules(const Rules& rules)
+{
+	m_Rules = rules;
+	for (CacheEntry& entry : m_Cache)
+	{
+		entry.Valid = false;
+	}
+}
+
+template<typename Rules>
+const OutcomePreview& BasicWhatIfAdvisor<Rules>::Preview(const CityState& state, const PlayerDecisions& decisions)
+{
+	if (!m_Pool)
+	{
+		m_Pool = std::make_unique<ThreadPool>(m_Threads);
+		m_Cache.assign(GameConfig::Advisor::CACHE_ENTRIES, CacheEntry{});
+		m_Population.resize(SAMPLES);
+		m_Reserves.resize(SAMPLES);
+		m_Overthrown.resize(SAMPLES / CHUNK);
+		m_Starving.resize(SAMPLES / CHUNK);
+		m_SampleBody = [this](size_t begin, size_t end) { SimulateRange(begin, end); };
+	}
+
+	PreviewKey key = MakeKey(state, decisions);
+	uint64_t hash = HashKey(key);
+	CacheEntry& entry = m_Cache[hash % m_Cache.size()];
+	if (entry.Valid && entry.Key == key)
+	{
+		m_CacheHits++;
+		return entry.Preview;
+	}
+
+	// Зерно - от ключа: повторный прогноз тех же решений совпадает с вытесненным из кэша
+	if (!Simulate(state, decisions, hash, m_Partial))
+		return m_Partial;
+
+	entry.Key = key;
+	entry.Preview = m_Partial;
+	entry.Valid = true;
+	return entry.Preview;
+}
+
+template<typename Rules>
+uint64_t BasicWhatIfAdvisor<Rules>::GetCacheHits() const
+{
+	return m_CacheHits;
+}
+
+template<typename Rules>
+typename BasicWhatIfAdvisor<Rules>::PreviewKey BasicWhatIfAdvisor<Rules>::MakeKey(const CityState& state, const PlayerDecisions& decisions) const
+{
+	PreviewKey key{};
+	key.Population = state.Population;
+	key.Area = state.Area;
+	key.WheatReserves = state.WheatReserves;
+	key.AcrePrice = state.AcrePrice;
+	key.Round = state.Round;
+	key.BuyLand = decisions.BuyLand;
+	key.SellLand = decisions.SellLand;
+	key.WheatForFood = decisions.WheatForFood;
+	key.AcresToPlant = decisions.AcresToPlant;
+	return key;
+}
+
+template<typename Rules>
+uint64_t BasicWhatIfAdvisor<Rules>::HashKey(const PreviewKey& key)
+{
+	// FNV-1a по полям ключа
+	uint64_t hash = 0xCBF29CE484222325ull;
+	auto mix = [&hash](uint64_t value)
+	{
+		hash ^= value;
+		hash *= 0x100000001B3ull;
+	};
+
+	mix(key.Population);
+	mix(key.Area);
+	mix(key.WheatReserves);
+	mix(key.AcrePrice);
+	mix(key.Round);
+	mix((uint32_t)key.BuyLand);
+	mix((uint32_t)key.SellLand);
+	mix((uint32_t)key.WheatForFood);
+	mix((uint32_t)key.AcresToPlant);
+	return hash;
+}
+
+template<typename Rules>
+bool BasicWhatIfAdvisor<Rules>::Simulate(const CityState& state, const PlayerDecisions& decisions, uint64_t seed, OutcomePreview& preview)
+{
+	m_Start = state;
+	m_Decisions = decisions;
+	m_Seed = seed;
+
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(GameConfig::Advisor::BUDGET_MICROSECONDS);
+	size_t samples = 0;
+	while (samples < SAMPLES)
+	{
+		m_WaveStart = samples;
+		m_Pool->ParallelFor(WAVE, CHUNK, m_SampleBody);
+		samples += WAVE;
+
+		if (std::chrono::steady_clock::now() >= deadline)
+			break;
+	}
+
+	uint64_t overthrown = 0;
+	uint64_t starving = 0;
+	for (size_t chunk = 0; chunk < samples / CHUNK; chunk++)
+	{
+		overthrown += m_Overthrown[chunk];
+		starving += m_Starving[chunk];
+	}
+
+	preview.Samples = (uint32_t)samples;
+	preview.OverthrowRisk = (float)overthrown / (float)samples;
+	preview.StarvationRisk = (float)starving / (float)samples;
+	preview.Population = GetRange(m_Population, samples);
+	preview.Reserves = GetRange(m_Reserves, samples);
+	return samples == SAMPLES;
+}
+
+template<typename Rules>
+void BasicWhatIfAdvisor<Rules>::SimulateRange(size_t begin, size_t end)
+{
+	size_t first = m_WaveStart + begin;
+	size_t chunk = first / CHUNK;
+	SplitMix64 random(SplitMix64::MakeSeed(m_Seed, chunk));
+
+	uint32_t overthrown = 0;
+	uint32_t starving = 0;
+	for (size_t i = first; i < m_WaveStart + end; i++)
+	{
+		// Те же шаги, что EndRound -> SimulateRound движка, но над копией города
+		CityState city = m_Start;
+		ResetCityRound(city);
+		ApplyCityDecisions(city, m_Decisions, m_Rules);
+
+		RoundDraws draws{};
+		draws.AcrePrice = city.AcrePrice;
+		DrawCityRound(draws, random, m_Rules);
+
+		ApplyCityHarvest(city, draws);
+		ApplyCityRats(city, draws);
+		EconomyFixed deadPercent = ApplyCityHunger(city, m_Rules);
+		ApplyCityNewPeople(city, m_Rules);
+		ApplyCityPlague(city, draws, m_Rules);
+
+		overthrown += deadPercent >= m_Rules.MaxDeadFromHunger ? 1 : 0;
+		starving += (uint64_t)city.Population * m_Rules.WheatPerPerson > (uint64_t)city.WheatReserves ? 1 : 0;
+		m_Population[i] = city.Population;
+		m_Reserves[i] = city.WheatReserves;
+	}
+
+	m_Overthrown[chunk] = overthrown;
+	m_Starving[chunk] = starving;
+}
+
+template class BasicWhatIfAdvisor<DefaultRules>;
+template class BasicWhatIfAdvisor<RuntimeRules>;
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "../config/GameRules.h"
+#include "../domain/CityState.h"
+#include "../domain/PlayerDecisions.h"
+#include "../utils/ThreadPool.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Разброс величины по исходам: 10-й, 50-й и 90-й процентили
+struct OutcomeRange
+{
+	Quantity Low;
+	Quantity Median;
+	Quantity High;
+};
+
+// Прогноз следующего года при выбранных решениях
+struct OutcomePreview
+{
+	uint32_t Samples;           // Сколько исходов успели просчитать
+	float OverthrowRisk;        // Доля исходов, где правителя свергают за голод
+	float StarvationRisk;       // Доля исходов, где запасов не хватит прокормить всех через год
+	OutcomeRange Population;
+	OutcomeRange Reserves;
+};
+
+// Советник "что если": прогоняет конец раунда (те же шаги CityRound, что и
+// Process* движка) на копиях города тысячи раз с разными случайными величинами.
+// Состояние движка не меняется - прогноз получает его по константной ссылке.
+// Исходы считаются кусками в пуле потоков; генератор куска зависит только от
+// города, решений и номера куска. Полный прогноз - всегда PREVIEW_SAMPLES
+// исходов, поэтому он одинаков при любом числе потоков и после вытеснения из кэша.
+// Бюджет GameConfig::Advisor::BUDGET_MICROSECONDS только ограничивает сверху:
+// если он кончился раньше, показывается неполный прогноз (Samples меньше),
+// и в кэш он не попадает. Кэш - по точным решениям и городу.
+// Пул потоков и буферы создаются при первом прогнозе.
+template<typename Rules>
+class BasicWhatIfAdvisor
+{
+public:
+	explicit BasicWhatIfAdvisor(const Rules& rules = Rules(), uint32_t threads = 0);
+
+	BasicWhatIfAdvisor(const BasicWhatIfAdvisor&) = delete;
+	BasicWhatIfAdvisor& operator=(const BasicWhatIfAdvisor&) = delete;
+
+	void SetRules(const Rules& rules);
+	const OutcomePreview& Preview(const CityState& state, const PlayerDecisions& decisions);
+
+	uint64_t GetCacheHits() const;
+
+private:
+	// Все, от чего зависит исход: город и решения
+	struct PreviewKey
+	{
+		Quantity Population;
+		Quantity Area;
+		Quantity WheatReserves;
+		uint32_t AcrePrice;
+		uint32_t Round;
+		int32_t BuyLand;
+		int32_t SellLand;
+		int32_t WheatForFood;
+		int32_t AcresToPlant;
+
+		bool operator==(const PreviewKey& other) const = default;
+	};
+
+	struct CacheEntry
+	{
+		bool Valid;
+		PreviewKey Key;
+		OutcomePreview Preview;
+	};
+
+	PreviewKey MakeKey(const CityState& state, const PlayerDecisions& decisions) const;
+	static uint64_t HashKey(const PreviewKey& key);
+	// false - бюджет времени кончился раньше, чем просчитаны все исходы
+	bool Simulate(const CityState& state, const PlayerDecisions& decisions, uint64_t seed, OutcomePreview& preview);
+	void SimulateRange(size_t begin, size_t end);
+
+private:
+	Rules m_Rules;
+	uint32_t m_Threads;
+	std::unique_ptr<ThreadPool> m_Pool;
+	std::vector<CacheEntry> m_Cache;
+	uint64_t m_CacheHits;
+	OutcomePreview m_Partial;                   // Неполный прогноз, не попавший в кэш
+
+	// Задание текущей волны; тело цикла создается один раз
+	CityState m_Start;
+	PlayerDecisions m_Decisions;
+	uint64_t m_Seed;
+	size_t m_WaveStart;                         // Первый исход волны
+	std::vector<Quantity> m_Population;         // Итог по исходам
+	std::vector<Quantity> m_Reserves;
+	std::vector<uint32_t> m_Overthrown;         // По кускам
+	std::vector<uint32_t> m_Starving;
+	std::function<void(size_t, size_t)> m_SampleBody;
+};
+
+extern template class BasicWhatIfAdvisor<DefaultRules>;
+extern template class BasicWhatIfAdvisor<RuntimeRules>;
+
+using WhatIfAdvisor = BasicWhatIfAdvisor<DefaultRules>;
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "SaturatingMath.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+// Неотрицательное число с фиксированной точкой: значение = raw / 2^FractionBits.
+// Все операции целочисленные, поэтому результат не зависит от компилятора
+// и режима FPU. Преобразования из float/double - только constexpr для констант
+// и при чтении конфигурации; в расчетах раунда float не участвует.
+template<uint32_t FractionBits>
+class FixedPoint
+{
+	static_assert(FractionBits > 0 && FractionBits <= 30, "FixedPoint: от 1 до 30 дробных бит");
+
+public:
+	static constexpr uint32_t FRACTION_BITS = FractionBits;
+	static constexpr int64_t ONE_RAW = (int64_t)1 << FractionBits;
+
+	constexpr FixedPoint() : m_Raw(0) {}
+
+	static constexpr FixedPoint FromRaw(int64_t raw)
+	{
+		FixedPoint result;
+		result.m_Raw = raw;
+		return result;
+	}
+
+	static constexpr FixedPoint One()
+	{
+		return FromRaw(ONE_RAW);
+	}
+
+	// Округление к ближайшему
+	static constexpr FixedPoint FromDouble(double value)
+	{
+		double scaled = value * (double)ONE_RAW;
+		return FromRaw((int64_t)(scaled < 0.0 ? scaled - 0.5 : scaled + 0.5));
+	}
+
+	static constexpr FixedPoint FromFloat(float value)
+	{
+		return FromDouble((double)value);
+	}
+
+	// numerator / denominator с округлением вниз; знаменатель не ноль.
+	// Частное больше наибольшего представимого числа насыщается до него
+	static constexpr FixedPoint FromRatio(uint64_t numerator, uint64_t denominator)
+	{
+		uint64_t whole = numerator / denominator;
+		uint64_t rest = numerator % denominator;
+		if (whole > (uint64_t)(std::numeric_limits<int64_t>::max() >> FractionBits))
+			return FromRaw(std::numeric_limits<int64_t>::max());
+
+		uint64_t fraction = 0;
+		if ((rest >> (64 - FractionBits)) == 0)
+		{
+			fraction = (rest << FractionBits) / denominator;
+		}
+		else
+		{
+			// rest << FractionBits переполнился бы: дробные биты делятся столбиком.
+			// rest < denominator, так что удвоение сравнивается без переполнения
+			for (uint32_t bit = 0; bit < FractionBits; bit++)
+			{
+				fraction <<= 1;
+				if (rest >= denominator - rest)
+				{
+					rest -= denominator - rest;
+					fraction |= 1;
+				}
+				else
+				{
+					rest <<= 1;
+				}
+			}
+		}
+		return FromRaw((int64_t)((whole << FractionBits) + fraction));
+	}
+
+	constexpr int64_t GetRaw() const { return m_Raw; }
+
+	// Целая часть произведения value * this: floor(value * raw / 2^bits).
+	// value делится на целую и дробную части, чтобы произведение не переполнилось;
+	// при переполнении - насыщение
+	uint64_t Scale(uint64_t value) const
+	{
+		uint64_t high = value >> FractionBits;
+		uint64_t low = value & (uint64_t)(ONE_RAW - 1);
+		uint64_t raw = (uint64_t)m_Raw;
+		return SaturatingAdd(SaturatingMul(high, raw), (low * raw) >> FractionBits);
+	}
+
+	// То же для 32-битных количеств, с насыщением до предела uint32_t
+	uint32_t Scale(uint32_t value) const
+	{
+		return (uint32_t)std::min<uint64_t>(Scale((uint64_t)value), std::numeric_limits<uint32_t>::max());
+	}
+
+	// Для вывода и текстовых сохранений
+	constexpr float ToFloat() const
+	{
+		return (float)((double)m_Raw / (double)ONE_RAW);
+	}
+
+	constexpr FixedPoint operator+(FixedPoint other) const { return FromRaw(m_Raw + other.m_Raw); }
+	constexpr FixedPoint operator-(FixedPoint other) const { return FromRaw(m_Raw - other.m_Raw); }
+	constexpr FixedPoint operator/(uint32_t divisor) const { return FromRaw(m_Raw / (int64_t)divisor); }
+	constexpr FixedPoint& operator+=(FixedPoint other) { m_Raw += other.m_Raw; return *this; }
+
+	constexpr bool operator==(FixedPoint other) const { return m_Raw == other.m_Raw; }
+	constexpr bool operator!=(FixedPoint other) const { return m_Raw != other.m_Raw; }
+	constexpr bool operator<(FixedPoint other) const { return m_Raw < other.m_Raw; }
+	constexpr bool operator<=(FixedPoint other) const { return m_Raw <= other.m_Raw; }
+	constexpr bool operator>(FixedPoint other) const { return m_Raw > other.m_Raw; }
+	constexpr bool operator>=(FixedPoint other) const { return m_Raw >= other.m_Raw; }
+
+private:
+	int64_t m_Raw;
+};
@@ -0,0 +1,93 @@
+#include "MappedFile.h"
+#include <fstream>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+	: m_Data(nullptr),
+	m_Size(0),
+	m_Mapped(false)
+{
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+bool MappedFile::Open(const std::filesystem::path& filePath)
+{
+	Close();
+
+#ifdef __linux__
+	int fd = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return false;
+
+	struct stat info{};
+	if (fstat(fd, &info) != 0 || info.st_size <= 0)
+	{
+		close(fd);
+		return false;
+	}
+
+	// Отображение держит файл само, дескриптор больше не нужен
+	void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+		return false;
+
+	m_Data = (const char*)data;
+	m_Size = (size_t)info.st_size;
+	m_Mapped = true;
+	return true;
+#else
+	std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+	if (!file.is_open())
+		return false;
+
+	std::streamoff size = file.tellg();
+	if (size <= 0)
+		return false;
+
+	m_Buffer.resize(((size_t)size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+	file.seekg(0);
+	if (!file.read((char*)m_Buffer.data(), size))
+	{
+		m_Buffer.clear();
+		return false;
+	}
+
+	m_Data = (const char*)m_Buffer.data();
+	m_Size = (size_t)size;
+	return true;
+#endif
+}
+
+void MappedFile::Close()
+{
+#ifdef __linux__
+	if (m_Mapped)
+		munmap((void*)m_Data, m_Size);
+#endif
+	m_Buffer.clear();
+	m_Buffer.shrink_to_fit();
+	m_Data = nullptr;
+	m_Size = 0;
+	m_Mapped = false;
+}
+
+const char* MappedFile::GetData() const
+{
+	return m_Data;
+}
+
+size_t MappedFile::GetSize() const
+{
+	return m_Size;
+}
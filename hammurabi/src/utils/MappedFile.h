@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+// Файл только для чтения, отображенный в память.
+// В Linux - mmap: страницы подгружаются по мере обращения и делятся между
+// процессами. На остальных платформах файл читается целиком в буфер,
+// выровненный по 8 байтам, как и отображение.
+class MappedFile
+{
+public:
+	MappedFile();
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool Open(const std::filesystem::path& filePath);
+	void Close();
+
+	const char* GetData() const;
+	size_t GetSize() const;
+
+private:
+	const char* m_Data;
+	size_t m_Size;
+	bool m_Mapped;
+	std::vector<uint64_t> m_Buffer;     // Запасной путь без mmap
+};
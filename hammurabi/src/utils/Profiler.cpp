@@ -0,0 +1,232 @@
+#include "Profiler.h"
+#include "../config/GameConfig.h"
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <iomanip>
+
+const char* GetProfilePhaseName(ProfilePhase phase)
+{
+	switch (phase)
+	{
+	case ProfilePhase::BeginRound:
+		return "BeginRound";
+	case ProfilePhase::ProcessPlayerInput:
+		return "ProcessPlayerInput";
+	case ProfilePhase::EndRound:
+		return "EndRound";
+	case ProfilePhase::SimulateRound:
+		return "SimulateRound";
+	case ProfilePhase::ProcessHarvest:
+		return "ProcessHarvest";
+	case ProfilePhase::ProcessRats:
+		return "ProcessRats";
+	case ProfilePhase::ProcessHunger:
+		return "ProcessHunger";
+	case ProfilePhase::ProcessNewPeople:
+		return "ProcessNewPeople";
+	case ProfilePhase::ProcessPlague:
+		return "ProcessPlague";
+	case ProfilePhase::Save:
+		return "Save";
+	case ProfilePhase::Render:
+		return "Render";
+	case ProfilePhase::Count:
+		break;
+	}
+	return "Unknown";
+}
+
+Profiler& Profiler::Instance()
+{
+	static Profiler profiler;
+	return profiler;
+}
+
+Profiler::Profiler()
+	: m_StartTicks(ReadProfileTicks()),
+	m_StartTime(std::chrono::steady_clock::now())
+{
+}
+
+void Profiler::Record(ProfilePhase phase, uint64_t startTicks, uint64_t endTicks)
+{
+	ThreadData& data = GetThreadData();
+	uint64_t ticks = endTicks - startTicks;
+
+	PhaseStats& stats = data.Phases[(size_t)phase];
+	stats.Count++;
+	stats.TotalTicks += ticks;
+	stats.MinTicks = std::min(stats.MinTicks, ticks);
+	stats.MaxTicks = std::max(stats.MaxTicks, ticks);
+	stats.Buckets[GetBucket(ticks)]++;
+
+	if (data.Events.size() < data.Events.capacity())
+		data.Events.push_back(TraceEvent{ startTicks, ticks, phase });
+	else
+		data.DroppedEvents++;
+}
+
+Profiler::ThreadData& Profiler::GetThreadData()
+{
+	thread_local ThreadData* data = nullptr;
+	if (data)
+		return *data;
+
+	auto created = std::make_unique<ThreadData>();
+	for (PhaseStats& stats : created->Phases)
+	{
+		stats = PhaseStats{};
+		stats.MinTicks = UINT64_MAX;
+	}
+	created->Events.reserve(GameConfig::Profile::TRACE_EVENTS_PER_THREAD);
+	created->DroppedEvents = 0;
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	created->ThreadIndex = (uint32_t)m_Threads.size();
+	data = created.get();
+	m_Threads.push_back(std::move(created));
+	return *data;
+}
+
+double Profiler::GetNanosecondsPerTick() const
+{
+	// Частота rdtsc калибруется по steady_clock за все время работы
+	uint64_t ticks = ReadProfileTicks() - m_StartTicks;
+	auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - m_StartTime);
+	return ticks > 0 ? elapsed.count() / (double)ticks : 1.0;
+}
+
+size_t Profiler::GetBucket(uint64_t ticks)
+{
+	// Старший бит задает степень двойки, следующие SUB_BUCKET_BITS бит - корзину внутри нее
+	if (ticks < (1u << SUB_BUCKET_BITS))
+		return (size_t)ticks;
+	size_t exponent = (size_t)std::bit_width(ticks) - 1;
+	size_t mantissa = (size_t)(ticks >> (exponent - SUB_BUCKET_BITS)) & ((1u << SUB_BUCKET_BITS) - 1);
+	return ((exponent - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS) + mantissa;
+}
+
+uint64_t Profiler::GetBucketUpperTicks(size_t bucket)
+{
+	if (bucket < (1u << SUB_BUCKET_BITS))
+		return bucket;
+	size_t exponent = (bucket >> SUB_BUCKET_BITS) + SUB_BUCKET_BITS - 1;
+	uint64_t mantissa = bucket & ((1u << SUB_BUCKET_BITS) - 1);
+	uint64_t low = ((1ull << SUB_BUCKET_BITS) + mantissa) << (exponent - SUB_BUCKET_BITS);
+	return low + (1ull << (exponent - SUB_BUCKET_BITS)) - 1;
+}
+
+bool Profiler::WriteChromeTrace(const std::filesystem::path& path)
+{
+	std::ofstream file(path, std::ios::out | std::ios::trunc);
+	if (!file.is_open())
+		return false;
+
+	double nsPerTick = GetNanosecondsPerTick();
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	// Формат Trace Event (chrome://tracing, Perfetto): события "X" с временем в микросекундах
+	file << "{\"traceEvents\":[";
+	bool first = true;
+	file << std::fixed << std::setprecision(3);
+	for (const auto& thread : m_Threads)
+	{
+		for (const TraceEvent& event : thread->Events)
+		{
+			double start = (double)(event.StartTicks - m_StartTicks) * nsPerTick / 1000.0;
+			double duration = (double)event.DurationTicks * nsPerTick / 1000.0;
+
+			file << (first ? "\n" : ",\n")
+				<< "{\"name\":\"" << GetProfilePhaseName(event.Phase)
+				<< "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread->ThreadIndex
+				<< ",\"ts\":" << start << ",\"dur\":" << duration << "}";
+			first = false;
+		}
+	}
+	file << "\n],\"displayTimeUnit\":\"ns\"}\n";
+	return file.good();
+}
+
+void Profiler::WriteSummary(std::ostream& out)
+{
+	double nsPerTick = GetNanosecondsPerTick();
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	// Итог по фазе - оценка: сумма замеров, умноженная на период выборки
+	const uint32_t period = GameConfig::Profile::SAMPLE_PERIOD;
+	out << "Замеряется каждый " << period << "-й вызов фазы\n";
+	out << std::left << std::setw(20) << "phase"
+		<< std::right << std::setw(12) << "samples"
+		<< std::setw(14) << "est. total ms"
+		<< std::setw(12) << "mean ns"
+		<< std::setw(12) << "p50 ns"
+		<< std::setw(12) << "p99 ns"
+		<< std::setw(14) << "max ns" << "\n";
+
+	uint64_t dropped = 0;
+	for (size_t p = 0; p < PHASE_COUNT; p++)
+	{
+		// Гистограммы всех потоков складываются
+		PhaseStats merged{};
+		merged.MinTicks = UINT64_MAX;
+		for (const auto& thread : m_Threads)
+		{
+			const PhaseStats& stats = thread->Phases[p];
+			merged.Count += stats.Count;
+			merged.TotalTicks += stats.TotalTicks;
+			merged.MinTicks = std::min(merged.MinTicks, stats.MinTicks);
+			merged.MaxTicks = std::max(merged.MaxTicks, stats.MaxTicks);
+			for (size_t b = 0; b < BUCKET_COUNT; b++)
+			{
+				merged.Buckets[b] += stats.Buckets[b];
+			}
+		}
+		if (merged.Count == 0)
+			continue;
+
+		uint64_t p50Target = (merged.Count + 1) / 2;
+		uint64_t p99Target = merged.Count - merged.Count / 100;
+		uint64_t p50 = 0;
+		uint64_t p99 = 0;
+		uint64_t seen = 0;
+		for (size_t b = 0; b < BUCKET_COUNT; b++)
+		{
+			uint64_t before = seen;
+			seen += merged.Buckets[b];
+			if (before < p50Target && seen >= p50Target)
+				p50 = GetBucketUpperTicks(b);
+			if (before < p99Target && seen >= p99Target)
+				p99 = GetBucketUpperTicks(b);
+		}
+
+		// Верхняя граница корзины не может быть больше настоящего максимума
+		p50 = std::min(p50, merged.MaxTicks);
+		p99 = std::min(p99, merged.MaxTicks);
+
+		out << std::left << std::setw(20) << GetProfilePhaseName((ProfilePhase)p)
+			<< std::right << std::setw(12) << merged.Count
+			<< std::setw(14) << std::fixed << std::setprecision(3) << (double)merged.TotalTicks * period * nsPerTick / 1e6
+			<< std::setw(12) << std::setprecision(0) << (double)merged.TotalTicks * nsPerTick / (double)merged.Count
+			<< std::setw(12) << (double)p50 * nsPerTick
+			<< std::setw(12) << (double)p99 * nsPerTick
+			<< std::setw(14) << (double)merged.MaxTicks * nsPerTick << "\n";
+	}
+
+	for (const auto& thread : m_Threads)
+	{
+		dropped += thread->DroppedEvents;
+	}
+	if (dropped > 0)
+		out << "Событий не попало в трассу (буфер полон): " << dropped << "\n";
+}
+
+bool Profiler::Export(const std::filesystem::path& tracePath, const std::filesystem::path& summaryPath)
+{
+	std::ofstream summary(summaryPath, std::ios::out | std::ios::trunc);
+	if (!summary.is_open())
+		return false;
+	WriteSummary(summary);
+
+	return WriteChromeTrace(tracePath) && summary.good();
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include "../config/GameConfig.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define HAMMURABI_HAS_RDTSC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define HAMMURABI_HAS_RDTSC 1
+#endif
+
+// Профилирование фаз раунда.
+//
+// Замеры включаются сборкой с HAMMURABI_PROFILE (/D HAMMURABI_PROFILE);
+// без флага PROFILE_SCOPE раскрывается в ничто и код движка не меняется.
+// Время берется из rdtsc (на x86) или steady_clock и переводится в наносекунды
+// только при выгрузке. Каждый поток пишет в свои гистограммы и буфер событий
+// без блокировок; общий мьютекс берется один раз при первом замере в потоке.
+//
+// Шаги Process* длятся единицы наносекунд - сравнимо с самим rdtsc, поэтому
+// замеряется каждый SAMPLE_PERIOD-й вызов фазы. Счетчики фаз идут в ногу,
+// так что в трассу попадают все фазы одного и того же раунда.
+
+// Фазы раунда - фиксированный список, чтобы замер был индексом в массиве
+enum class ProfilePhase : uint8_t
+{
+	BeginRound,
+	ProcessPlayerInput,
+	EndRound,
+	SimulateRound,
+	ProcessHarvest,
+	ProcessRats,
+	ProcessHunger,
+	ProcessNewPeople,
+	ProcessPlague,
+	Save,
+	Render,
+	Count,
+};
+
+const char* GetProfilePhaseName(ProfilePhase phase);
+
+inline uint64_t ReadProfileTicks()
+{
+#ifdef HAMMURABI_HAS_RDTSC
+	return __rdtsc();
+#else
+	return (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+class Profiler
+{
+public:
+	// Гистограмма длительностей в тиках: по 4 корзины на каждую степень двойки
+	static constexpr size_t SUB_BUCKET_BITS = 2;
+	static constexpr size_t BUCKET_COUNT = 64 << SUB_BUCKET_BITS;
+	static constexpr size_t PHASE_COUNT = (size_t)ProfilePhase::Count;
+
+	struct PhaseStats
+	{
+		uint64_t Count;
+		uint64_t TotalTicks;
+		uint64_t MinTicks;
+		uint64_t MaxTicks;
+		std::array<uint64_t, BUCKET_COUNT> Buckets;
+	};
+
+	struct TraceEvent
+	{
+		uint64_t StartTicks;
+		uint64_t DurationTicks;
+		ProfilePhase Phase;
+	};
+
+	static Profiler& Instance();
+
+	// Пора ли замерить этот вызов фазы; остальные вызовы стоят один декремент
+	static bool TakeSample(ProfilePhase phase)
+	{
+		uint32_t& countdown = s_Countdown[(size_t)phase];
+		if (countdown != 0)
+		{
+			countdown--;
+			return false;
+		}
+		countdown = GameConfig::Profile::SAMPLE_PERIOD - 1;
+		return true;
+	}
+
+	void Record(ProfilePhase phase, uint64_t startTicks, uint64_t endTicks);
+
+	bool WriteChromeTrace(const std::filesystem::path& path);
+	void WriteSummary(std::ostream& out);
+	bool Export(const std::filesystem::path& tracePath, const std::filesystem::path& summaryPath);
+
+private:
+	struct ThreadData
+	{
+		uint32_t ThreadIndex;
+		std::array<PhaseStats, PHASE_COUNT> Phases;
+		std::vector<TraceEvent> Events;     // Резерв на TRACE_EVENTS_PER_THREAD, дальше события не пишутся
+		uint64_t DroppedEvents;
+	};
+
+	Profiler();
+	ThreadData& GetThreadData();
+	double GetNanosecondsPerTick() const;
+	static size_t GetBucket(uint64_t ticks);
+	static uint64_t GetBucketUpperTicks(size_t bucket);
+
+private:
+	std::mutex m_Mutex;
+	std::vector<std::unique_ptr<ThreadData>> m_Threads;    // Живут до конца программы, даже после выхода потока
+	uint64_t m_StartTicks;
+	std::chrono::steady_clock::time_point m_StartTime;
+
+	static inline thread_local std::array<uint32_t, PHASE_COUNT> s_Countdown{};
+};
+
+// Замер от конструктора до деструктора
+class ProfileScope
+{
+public:
+	explicit ProfileScope(ProfilePhase phase)
+		: m_Phase(phase),
+		m_StartTicks(0),
+		m_Sampled(Profiler::TakeSample(phase))
+	{
+		if (m_Sampled)
+		{
+			// Профилировщик создается до первого отсчета, иначе начало трассы уйдет в минус
+			Profiler::Instance();
+			m_StartTicks = ReadProfileTicks();
+		}
+	}
+
+	~ProfileScope()
+	{
+		if (m_Sampled)
+			Profiler::Instance().Record(m_Phase, m_StartTicks, ReadProfileTicks());
+	}
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+	ProfilePhase m_Phase;
+	uint64_t m_StartTicks;
+	bool m_Sampled;
+};
+
+#define HAMMURABI_PROFILE_CONCAT_IMPL(a, b) a##b
+#define HAMMURABI_PROFILE_CONCAT(a, b) HAMMURABI_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef HAMMURABI_PROFILE
+#define PROFILE_SCOPE(phase) ProfileScope HAMMURABI_PROFILE_CONCAT(profileScope, __LINE__)(phase)
+#else
+#define PROFILE_SCOPE(phase) ((void)0)
+#endif
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+// Беззнаковая арифметика с насыщением: при переполнении результат прижимается
+// к максимуму типа, при уходе ниже нуля - к нулю. Без условных переходов:
+// признак переполнения превращается в маску и накладывается на результат.
+
+template<typename T>
+constexpr T SaturatingAdd(T a, T b)
+{
+	static_assert(std::is_unsigned_v<T>, "SaturatingAdd: только беззнаковые типы");
+	T result = a + b;
+	return result | (T)-(T)(result < a);
+}
+
+template<typename T>
+constexpr T SaturatingSub(T a, T b)
+{
+	static_assert(std::is_unsigned_v<T>, "SaturatingSub: только беззнаковые типы");
+	T result = a - b;
+	return result & (T)-(T)(result <= a);
+}
+
+template<typename T>
+inline T SaturatingMul(T a, T b)
+{
+	static_assert(std::is_unsigned_v<T>, "SaturatingMul: только беззнаковые типы");
+	T result = 0;
+	bool overflow = false;
+
+#if defined(__GNUC__) || defined(__clang__)
+	overflow = __builtin_mul_overflow(a, b, &result);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	if constexpr (sizeof(T) == 8)
+	{
+		unsigned __int64 high = 0;
+		result = (T)_umul128(a, b, &high);
+		overflow = high != 0;
+	}
+	else
+	{
+		uint64_t wide = (uint64_t)a * b;
+		result = (T)wide;
+		overflow = (wide >> (sizeof(T) * 8)) != 0;
+	}
+#else
+	result = a * b;
+	overflow = a != 0 && result / a != b;
+#endif
+
+	return result | (T)-(T)overflow;
+}
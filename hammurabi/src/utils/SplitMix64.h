@@ -0,0 +1,99 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+// Генератор SplitMix64: 8 байт состояния и несколько умножений на число.
+// Подходит там, где генераторов тысячи (город империи, среда VecEnv) и
+// std::mt19937 с его 2.5 КБ состояния слишком тяжел. Удовлетворяет
+// UniformRandomBitGenerator, но розыгрыши игры идут через NextBelow/NextInRange:
+// распределения <random> дают разные числа в разных стандартных библиотеках.
+class SplitMix64
+{
+public:
+	using result_type = uint64_t;
+
+	explicit SplitMix64(uint64_t seed = 0) : m_State(seed) {}
+
+	// Начальное значение из нескольких ключей (зерно, раунд, номер...)
+	static constexpr uint64_t MakeSeed(uint64_t a, uint64_t b)
+	{
+		return a * 0x9E3779B97F4A7C15ull ^ b * 0xD1B54A32D192ED03ull;
+	}
+
+	// Базовое зерно процесса, выбирается по часам один раз. Партии получают
+	// MakeSeed(GetProcessSeed(), номер), а не время: начатые в одну секунду не совпадают
+	static uint64_t GetProcessSeed()
+	{
+		static const uint64_t seed = MakeSeed(
+			(uint64_t)std::chrono::system_clock::now().time_since_epoch().count(),
+			(uint64_t)std::chrono::steady_clock::now().time_since_epoch().count());
+		return seed;
+	}
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return std::numeric_limits<uint64_t>::max(); }
+
+	result_type operator()()
+	{
+		uint64_t z = (m_State += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	// Равномерное число в [0, bound), bound > 0: умножение со сдвигом (Lemire) с отбраковкой.
+	// В отличие от std::uniform_int_distribution, чей алгоритм задает реализация,
+	// последовательность одна и та же в любой стандартной библиотеке
+	uint64_t NextBelow(uint64_t bound)
+	{
+		uint64_t high = 0;
+		uint64_t low = 0;
+		MultiplyWide((*this)(), bound, high, low);
+		if (low < bound)
+		{
+			// 2^64 mod bound: столько младших значений отбрасывается ради равномерности
+			uint64_t threshold = (0 - bound) % bound;
+			while (low < threshold)
+			{
+				MultiplyWide((*this)(), bound, high, low);
+			}
+		}
+		return high;
+	}
+
+	// Равномерное число в [0, 1) с 53 значащими битами
+	double NextUnit()
+	{
+		return (double)((*this)() >> 11) * 0x1.0p-53;
+	}
+
+	// Равномерное число в [min, max] включительно, min <= max
+	uint64_t NextInRange(uint64_t min, uint64_t max)
+	{
+		uint64_t span = max - min + 1;
+		return span == 0 ? (*this)() : min + NextBelow(span);
+	}
+
+private:
+	// Полное 128-битное произведение: старшая и младшая половины
+	static constexpr void MultiplyWide(uint64_t a, uint64_t b, uint64_t& high, uint64_t& low)
+	{
+#ifdef __SIZEOF_INT128__
+		unsigned __int128 product = (unsigned __int128)a * b;
+		high = (uint64_t)(product >> 64);
+		low = (uint64_t)product;
+#else
+		uint64_t lowLow = (a & 0xFFFFFFFFull) * (b & 0xFFFFFFFFull);
+		uint64_t highLow = (a >> 32) * (b & 0xFFFFFFFFull);
+		uint64_t lowHigh = (a & 0xFFFFFFFFull) * (b >> 32);
+		uint64_t cross = (lowLow >> 32) + (highLow & 0xFFFFFFFFull) + lowHigh;
+		high = (a >> 32) * (b >> 32) + (highLow >> 32) + (cross >> 32);
+		low = (cross << 32) | (lowLow & 0xFFFFFFFFull);
+#endif
+	}
+
+private:
+	uint64_t m_State;
+};
@@ -0,0 +1,108 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(uint32_t threads)
+	: m_Body(nullptr),
+	m_Count(0),
+	m_Grain(1),
+	m_NextChunk(0),
+	m_Generation(0),
+	m_Busy(0),
+	m_Stopping(false)
+{
+	if (threads == 0)
+		threads = std::max(1u, std::thread::hardware_concurrency());
+
+	for (uint32_t i = 1; i < threads; i++)
+	{
+		m_Workers.emplace_back(&ThreadPool::WorkerLoop, this);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stopping = true;
+	}
+	m_WakeUp.notify_all();
+
+	for (std::thread& worker : m_Workers)
+	{
+		worker.join();
+	}
+}
+
+uint32_t ThreadPool::GetThreadCount() const
+{
+	return (uint32_t)m_Workers.size() + 1;
+}
+
+void ThreadPool::ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body)
+{
+	if (count == 0)
+		return;
+	grain = std::max<size_t>(grain, 1);
+
+	// Один кусок - будить потоки дороже, чем посчитать самому
+	if (m_Workers.empty() || count <= grain)
+	{
+		for (size_t begin = 0; begin < count; begin += grain)
+		{
+			body(begin, std::min(begin + grain, count));
+		}
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Body = &body;
+		m_Count = count;
+		m_Grain = grain;
+		m_NextChunk.store(0, std::memory_order_relaxed);
+		m_Busy = (uint32_t)m_Workers.size();
+		m_Generation++;
+	}
+	m_WakeUp.notify_all();
+
+	RunChunks();
+
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	m_Done.wait(lock, [this] { return m_Busy == 0; });
+	m_Body = nullptr;
+}
+
+void ThreadPool::WorkerLoop()
+{
+	uint64_t seen = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_WakeUp.wait(lock, [&] { return m_Stopping || m_Generation != seen; });
+			if (m_Stopping)
+				return;
+			seen = m_Generation;
+		}
+
+		RunChunks();
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		if (--m_Busy == 0)
+			m_Done.notify_one();
+	}
+}
+
+void ThreadPool::RunChunks()
+{
+	size_t chunks = (m_Count + m_Grain - 1) / m_Grain;
+	while (true)
+	{
+		size_t chunk = m_NextChunk.fetch_add(1, std::memory_order_relaxed);
+		if (chunk >= chunks)
+			return;
+
+		size_t begin = chunk * m_Grain;
+		(*m_Body)(begin, std::min(begin + m_Grain, m_Count));
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Пул потоков для параллельных циклов "разделить - посчитать - дождаться".
+// Потоки создаются один раз и спят между вызовами ParallelFor, поэтому
+// раунд с сотнями тысяч городов не платит за создание потоков.
+// Вызывающий поток тоже берет куски работы.
+class ThreadPool
+{
+public:
+	// threads - всего потоков вместе с вызывающим; 0 - по числу ядер
+	explicit ThreadPool(uint32_t threads);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	uint32_t GetThreadCount() const;
+
+	// Делит [0, count) на куски по grain элементов и вызывает body(begin, end) для каждого.
+	// Границы кусков не зависят от числа потоков: номер куска - begin / grain.
+	void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+private:
+	void WorkerLoop();
+	void RunChunks();
+
+private:
+	std::vector<std::thread> m_Workers;
+	std::mutex m_Mutex;
+	std::condition_variable m_WakeUp;
+	std::condition_variable m_Done;
+
+	// Текущее задание; меняется под m_Mutex, пока все потоки спят
+	const std::function<void(size_t, size_t)>* m_Body;
+	size_t m_Count;
+	size_t m_Grain;
+	std::atomic<size_t> m_NextChunk;
+	uint64_t m_Generation;      // Номер задания: по его смене потоки просыпаются
+	uint32_t m_Busy;            // Потоков, еще не закончивших текущее задание
+	bool m_Stopping;
+};
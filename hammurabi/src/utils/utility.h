@@ -1,75 +1,109 @@
 #pragma once
 
-#include <conio.h>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <fstream>
 #include <filesystem>
 #include <vector>
+#ifdef _WIN32
+#include <conio.h>
+#include <io.h>
+#else
+#include <termios.h>
+#include <unistd.h>
+#endif
 
-// Универсальная функция для загрузки ASCII-арта из файла в вектор строк
-inline std::vector<std::string> LoadASCIIArtFromFile(const std::filesystem::path& filePath)
+// Чтение одной клавиши без эха и без ожидания Enter
+inline int ReadKey()
 {
-	std::vector<std::string> artLines;
-	
-	std::ifstream file{filePath, std::ios::in | std::ios::binary};
+#ifdef _WIN32
+	return _getch();
+#else
+	termios oldSettings;
+	if (tcgetattr(STDIN_FILENO, &oldSettings) != 0)
+		return std::getchar();
 	
-	if (!file.is_open())
-	{
-		return artLines;
-	}
+	termios rawSettings = oldSettings;
+	rawSettings.c_lflag &= ~(ICANON | ECHO);
+	tcsetattr(STDIN_FILENO, TCSANOW, &rawSettings);
+	int key = std::getchar();
+	tcsetattr(STDIN_FILENO, TCSANOW, &oldSettings);
+	return key;
+#endif
+}
 
-	size_t fileSize = 0;
-	if (std::filesystem::exists(filePath))
-	{
-		fileSize = std::filesystem::file_size(filePath);
-	}
+// Очистка экрана и перевод курсора в начало (ANSI)
+constexpr std::string_view ANSI_CLEAR_SCREEN = "\x1b[H\x1b[2J";
+
+// Вывод блока байт в терминал одним системным вызовом, минуя буферы потоков
+inline void WriteConsoleBytes(std::string_view bytes)
+{
+	// То, что уже лежит в буферах cout/stdout, должно выйти раньше
+	std::cout.flush();
+	std::fflush(stdout);
 	
-	if (fileSize == 0)
+	const char* data = bytes.data();
+	size_t left = bytes.size();
+	while (left > 0)
 	{
-		file.close();
-		return artLines;
+#ifdef _WIN32
+		int written = _write(_fileno(stdout), data, (unsigned)left);
+#else
+		ssize_t written = write(STDOUT_FILENO, data, left);
+#endif
+		if (written <= 0)
+			return;
+		data += written;
+		left -= (size_t)written;
 	}
+}
+
+inline void ClearScreen()
+{
+	WriteConsoleBytes(ANSI_CLEAR_SCREEN);
+}
+
+// Чтение файла целиком в строку одним вызовом read
+inline bool LoadFileContent(const std::filesystem::path& filePath, std::string& content)
+{
+	std::ifstream file{filePath, std::ios::in | std::ios::binary | std::ios::ate};
+	if (!file.is_open())
+		return false;
 	
-	std::string content;
-	content.resize(fileSize);
-	file.read(&content[0], fileSize);
-	file.close();
-	
-	if (content.empty() || fileSize == 0)
-	{
-		return artLines;
-	}
+	std::streamsize fileSize = file.tellg();
+	if (fileSize <= 0)
+		return false;
 	
-	std::string line;
-	for (size_t i = 0; i < content.length(); ++i)
-	{
-		char c = content[i];
-		if (c == '\r' && i + 1 < content.length() && content[i + 1] == '\n')
-		{
-			// Windows line ending
-			artLines.push_back(line);
-			line.clear();
-			i++; // Пропускаем \n
-		}
-		else if (c == '\n')
-		{
-			// Unix line ending
-			artLines.push_back(line);
-			line.clear();
-		}
-		else
-		{
-			line += c;
-		}
-	}
+	content.resize((size_t)fileSize);
+	file.seekg(0);
+	file.read(content.data(), fileSize);
+	return file.gcount() == fileSize;
+}
+
+// Разбиение текста на строки за один проход, без копирования (\n и \r\n)
+inline void SplitLines(std::string_view content, std::vector<std::string_view>& lines)
+{
+	lines.clear();
 	
-	if (!line.empty())
+	size_t lineStart = 0;
+	while (lineStart < content.size())
 	{
-		artLines.push_back(line);
+		size_t lineEnd = content.find('\n', lineStart);
+		if (lineEnd == std::string_view::npos)
+			lineEnd = content.size();
+		
+		size_t next = lineEnd + 1;
+		if (lineEnd > lineStart && content[lineEnd - 1] == '\r')
+			lineEnd--;
+		
+		lines.push_back(content.substr(lineStart, lineEnd - lineStart));
+		lineStart = next;
 	}
-	
-	return artLines;
 }
 
 // Обработка однократного ввода (Y/N)
@@ -81,7 +115,7 @@ inline bool ProcessOneshotInput(bool isValidated = true, char acceptChar = 'Y',
 		{
 			char input = 0;
 
-			input = std::toupper(_getch());
+			input = std::toupper(ReadKey());
 
 			if (input == std::toupper(acceptChar))
 				return true;
@@ -89,24 +123,37 @@ inline bool ProcessOneshotInput(bool isValidated = true, char acceptChar = 'Y',
 				return false;
 		}
 	}
-	_getch();
+	ReadKey();
 	return true;
 }
 
+// Разбор целого числа из строки ввода без исключений (std::from_chars).
+// Правила прежнего std::stoi сохранены: пробелы в начале пропускаются,
+// знак '+' допускается, берется самый длинный числовой префикс ("12abc" -> 12).
+inline bool TryParseInteger(std::string_view input, int32_t& value)
+{
+	size_t start = input.find_first_not_of(" \t\n\v\f\r");
+	if (start == std::string_view::npos)
+		return false;
+	input.remove_prefix(start);
+	
+	// from_chars не принимает '+', а "+-5" должно остаться ошибкой
+	if (input.size() > 1 && input[0] == '+' && input[1] != '-')
+		input.remove_prefix(1);
+	
+	std::from_chars_result result = std::from_chars(input.data(), input.data() + input.size(), value);
+	return result.ec == std::errc();
+}
+
 // Обработка целочисленного ввода
 inline int32_t ProcessIntegerInput(std::string& input, const std::string& errorOutput = "Only integer input is allowed. Try again. ")
 {
 	while (std::cin >> input)
 	{
-		try
-		{
-			return std::stoi(input);
-		}
-		catch (const std::exception&)
-		{
-			std::cout << errorOutput;
-		}
+		int32_t value = 0;
+		if (TryParseInteger(input, value))
+			return value;
+		std::cout << errorOutput;
 	}
 	return -1;
-}
-
+}
\ No newline at end of file
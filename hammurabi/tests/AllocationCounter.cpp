@@ -0,0 +1,92 @@
+#include "AllocationCounter.h"
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Операторы определены в отдельной единице трансляции: вызовы не встраиваются,
+// и компилятор не сводит new в одном месте с free в другом (-Wmismatched-new-delete)
+
+namespace
+{
+	// Счет идет всегда; объект AllocationCounter смотрит только на разницу в своем потоке
+	thread_local uint64_t s_Allocations = 0;
+
+	void* Allocate(std::size_t size)
+	{
+		s_Allocations++;
+		return std::malloc(size == 0 ? 1 : size);
+	}
+
+	void* AllocateAligned(std::size_t size, std::align_val_t alignment)
+	{
+		s_Allocations++;
+		std::size_t align = (std::size_t)alignment;
+		// aligned_alloc требует размер, кратный выравниванию
+		std::size_t rounded = (size + align - 1) / align * align;
+#ifdef _WIN32
+		return _aligned_malloc(rounded == 0 ? align : rounded, align);
+#else
+		return std::aligned_alloc(align, rounded == 0 ? align : rounded);
+#endif
+	}
+
+	void Release(void* memory) noexcept
+	{
+		std::free(memory);
+	}
+
+	void ReleaseAligned(void* memory) noexcept
+	{
+#ifdef _WIN32
+		_aligned_free(memory);
+#else
+		std::free(memory);
+#endif
+	}
+
+	void* AllocateOrThrow(std::size_t size)
+	{
+		if (void* memory = Allocate(size))
+			return memory;
+		throw std::bad_alloc();
+	}
+
+	void* AllocateAlignedOrThrow(std::size_t size, std::align_val_t alignment)
+	{
+		if (void* memory = AllocateAligned(size, alignment))
+			return memory;
+		throw std::bad_alloc();
+	}
+}
+
+AllocationCounter::AllocationCounter()
+	: m_Start(s_Allocations)
+{
+}
+
+uint64_t AllocationCounter::GetCount() const
+{
+	return s_Allocations - m_Start;
+}
+
+void* operator new(std::size_t size) { return AllocateOrThrow(size); }
+void* operator new[](std::size_t size) { return AllocateOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return AllocateAlignedOrThrow(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return AllocateAlignedOrThrow(size, alignment); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return AllocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return AllocateAligned(size, alignment); }
+
+void operator delete(void* memory) noexcept { Release(memory); }
+void operator delete[](void* memory) noexcept { Release(memory); }
+void operator delete(void* memory, std::size_t) noexcept { Release(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { Release(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { Release(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { Release(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { ReleaseAligned(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { ReleaseAligned(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { ReleaseAligned(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { ReleaseAligned(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { ReleaseAligned(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { ReleaseAligned(memory); }
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+// Число выделений памяти в текущем потоке за время жизни объекта.
+// Глобальные operator new/delete заменены в AllocationCounter.cpp полным набором
+// (одиночные и массивы, nothrow, выровненные, с размером и без), поэтому любая
+// пара new/delete совпадает. Заменой пользуются только цели, собранные с этим
+// файлом (HammurabiTests и HammurabiBench); сама игра работает со стандартными.
+class AllocationCounter
+{
+public:
+	AllocationCounter();
+	AllocationCounter(const AllocationCounter&) = delete;
+	AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+	uint64_t GetCount() const;
+
+private:
+	uint64_t m_Start;
+};
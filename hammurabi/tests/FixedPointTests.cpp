@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+#include "../src/utils/FixedPoint.h"
+#include <cstdint>
+#include <limits>
+
+TEST(FixedPointTest, FromRatioMatchesDivision)
+{
+	using Fixed = FixedPoint<16>;
+	EXPECT_EQ(Fixed::FromRatio(1, 4).GetRaw(), Fixed::ONE_RAW / 4);
+	EXPECT_EQ(Fixed::FromRatio(7, 3).GetRaw(), (7 * Fixed::ONE_RAW) / 3);
+
+	// Большие числитель и знаменатель: numerator << FractionBits переполнился бы
+	uint64_t big = std::numeric_limits<uint64_t>::max() / 3;
+	EXPECT_EQ(Fixed::FromRatio(big, big).GetRaw(), Fixed::ONE_RAW);
+	EXPECT_EQ(Fixed::FromRatio(big, big * 2).GetRaw(), Fixed::ONE_RAW / 2);
+}
+
+TEST(FixedPointTest, FromRatioSaturates)
+{
+	using Fixed = FixedPoint<16>;
+	EXPECT_EQ(Fixed::FromRatio(std::numeric_limits<uint64_t>::max(), 1).GetRaw(), std::numeric_limits<int64_t>::max());
+	EXPECT_EQ(Fixed::FromRatio(std::numeric_limits<uint64_t>::max(), 3).GetRaw(), std::numeric_limits<int64_t>::max());
+}
+
+TEST(FixedPointTest, ScaleSaturatesInsteadOfWrapping)
+{
+	using Fixed = FixedPoint<16>;
+	Fixed big = Fixed::FromRatio(1000, 1);
+	EXPECT_EQ(big.Scale(std::numeric_limits<uint32_t>::max()), std::numeric_limits<uint32_t>::max());
+	EXPECT_EQ(big.Scale((uint32_t)1000), 1000000u);
+	EXPECT_EQ(Fixed::FromRatio(1, 2).Scale((uint32_t)7), 3u);
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "../src/domain/ScriptedStrategy.h"
+#include "../src/services/GameReplay.h"
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+	class GameReplayTest : public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			m_Path = std::filesystem::temp_directory_path() / ("hammurabi_replay_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()) + ".bin");
+			std::filesystem::remove(m_Path);
+		}
+
+		void TearDown() override
+		{
+			std::filesystem::remove(m_Path);
+		}
+
+		// Правила, при которых партия по DefaultRules пошла бы иначе
+		static RuntimeRules MakeChangedRules()
+		{
+			RuntimeRules rules;
+			rules.Set("MIN_WHEAT_PER_ACRE", 3);
+			rules.Set("MAX_WHEAT_PER_ACRE", 9);
+			rules.Set("PLAGUE_PROBABILITY", 40);
+			rules.Set("MAX_NEW_PEOPLE", 80);
+			return rules;
+		}
+
+		// Партия без консоли с журналом; возвращает состояния после каждого раунда
+		std::vector<CityState> PlayJournaled(const RuntimeRules& rules, uint32_t seed)
+		{
+			std::vector<CityState> states;
+			BasicGameEngine<RuntimeRules> engine(rules);
+			engine.Seed(seed);
+			EXPECT_TRUE(engine.StartJournal(m_Path));
+
+			for (uint32_t round = 1; round <= rules.MaxRounds; round++)
+			{
+				engine.StartRound();
+				engine.PlayRound(DecideScripted(ScriptedStrategy::LandTrader, engine.GetState(), rules));
+				states.push_back(engine.GetState());
+				if (engine.CheckGameOver())
+					break;
+				engine.AdvanceRound();
+			}
+			// Журнал дописывается при уничтожении движка
+			return states;
+		}
+
+	protected:
+		std::filesystem::path m_Path;
+	};
+}
+
+TEST_F(GameReplayTest, RuntimeRulesRoundTrip)
+{
+	RuntimeRules rules = MakeChangedRules();
+	ASSERT_TRUE(rules.IsConsistent());
+	std::vector<CityState> played = PlayJournaled(rules, 12345);
+	ASSERT_GT(played.size(), 1u);
+
+	BasicGameReplay<RuntimeRules> replay;
+	ASSERT_TRUE(replay.Load(m_Path));
+	EXPECT_TRUE(replay.GetRules() == rules);
+	ASSERT_EQ(replay.GetRoundCount(), played.size());
+
+	CityState state;
+	for (size_t i = 0; i < played.size(); i++)
+	{
+		uint32_t round = replay.GetFirstRound() + (uint32_t)i;
+		ASSERT_TRUE(replay.GetStateAfterRound(round, state));
+		EXPECT_EQ(state.Round, played[i].Round);
+		EXPECT_EQ(state.Population, played[i].Population);
+		EXPECT_EQ(state.Area, played[i].Area);
+		EXPECT_EQ(state.WheatReserves, played[i].WheatReserves);
+		EXPECT_EQ(state.DeadFromHunger, played[i].DeadFromHunger);
+		EXPECT_EQ(state.NewPeople, played[i].NewPeople);
+		EXPECT_EQ(state.WheatEatenByRats, played[i].WheatEatenByRats);
+		EXPECT_EQ(state.HasPlague, played[i].HasPlague);
+	}
+}
+
+TEST_F(GameReplayTest, DefaultRulesReplayRejectsOtherRules)
+{
+	PlayJournaled(MakeChangedRules(), 777);
+
+	GameReplay replay;
+	EXPECT_FALSE(replay.Load(m_Path));
+}
+
+TEST_F(GameReplayTest, DefaultRulesReplayAcceptsDefaultJournal)
+{
+	std::vector<CityState> played = PlayJournaled(RuntimeRules(), 99);
+
+	GameReplay replay;
+	ASSERT_TRUE(replay.Load(m_Path));
+	CityState state;
+	ASSERT_TRUE(replay.GetStateAfterRound(replay.GetLastRound(), state));
+	EXPECT_EQ(state.Population, played.back().Population);
+	EXPECT_EQ(state.WheatReserves, played.back().WheatReserves);
+}
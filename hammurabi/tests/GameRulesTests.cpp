@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include "../src/config/GameRules.h"
+#include <limits>
+
+TEST(RuntimeRulesTest, SetAcceptsValidValues)
+{
+	RuntimeRules rules;
+	EXPECT_TRUE(rules.Set("MAX_ROUNDS", 15));
+	EXPECT_EQ(rules.MaxRounds, 15u);
+	EXPECT_TRUE(rules.Set("SEEDS_PER_ACRE", 0.75));
+	EXPECT_EQ(rules.SeedsPerAcre, EconomyFixed::FromDouble(0.75));
+}
+
+// Отвергнутое значение не меняет правила
+TEST(RuntimeRulesTest, SetRejectsInvalidValuesWithoutChange)
+{
+	RuntimeRules rules;
+	const RuntimeRules original = rules;
+
+	EXPECT_FALSE(rules.Set("MAX_ROUNDS", -1.0));
+	EXPECT_FALSE(rules.Set("MAX_ROUNDS", 2.5));
+	EXPECT_FALSE(rules.Set("MAX_ROUNDS", 1e12));
+	EXPECT_FALSE(rules.Set("MAX_ROUNDS", std::numeric_limits<double>::quiet_NaN()));
+	EXPECT_FALSE(rules.Set("SEEDS_PER_ACRE", -0.5));
+	EXPECT_FALSE(rules.Set("SEEDS_PER_ACRE", std::numeric_limits<double>::infinity()));
+	EXPECT_FALSE(rules.Set("UNKNOWN_RULE", 1.0));
+
+	EXPECT_TRUE(rules == original);
+}
+
+// Правило в допустимых для Set пределах, но такое, что расчеты границ переполнились бы
+TEST(RuntimeRulesTest, IsConsistentRejectsOversizedRules)
+{
+	RuntimeRules rules;
+	ASSERT_TRUE(rules.IsConsistent());
+
+	ASSERT_TRUE(rules.Set("SEEDS_PER_ACRE", 1e6));
+	EXPECT_FALSE(rules.IsConsistent());
+
+	rules = RuntimeRules();
+	ASSERT_TRUE(rules.Set("ACRES_PER_PERSON", 4e9));
+	EXPECT_FALSE(rules.IsConsistent());
+
+	rules = RuntimeRules();
+	ASSERT_TRUE(rules.Set("MAX_ROUNDS", 1e6));
+	EXPECT_FALSE(rules.IsConsistent());
+
+	rules = RuntimeRules();
+	ASSERT_TRUE(rules.Set("MAX_ROUNDS", GameConfig::Game::MAX_RULE_ROUNDS));
+	EXPECT_TRUE(rules.IsConsistent());
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "../src/config/GameRules.h"
+#include "../src/services/InputHandler.h"
+#include <sstream>
+
+// Опрос корутиной проверяет ответы по правилам партии, а не по DefaultRules
+TEST(InputHandlerTest, AwaitUsesGivenRules)
+{
+	RuntimeRules rules;
+	rules.AcresPerPerson = 5;
+	CityState state;
+
+	std::ostringstream out;
+	InputHandler handler(out);
+	InputChannel input;
+	PlayerDecisions decisions{};
+	DecisionTask task = handler.AwaitPlayerDecisions(DecisionBounds(state, rules), input, decisions);
+
+	// 100 человек обработают 500 акров: 800 отвергается, вопрос повторяется
+	for (const char* line : { "0", "0", "100", "800" })
+	{
+		ASSERT_FALSE(task.IsDone());
+		input.Push(line);
+	}
+	EXPECT_FALSE(task.IsDone());
+	input.Push("400");
+
+	EXPECT_TRUE(task.IsDone());
+	EXPECT_EQ(decisions.BuyLand, 0);
+	EXPECT_EQ(decisions.SellLand, 0);
+	EXPECT_EQ(decisions.WheatForFood, 100);
+	EXPECT_EQ(decisions.AcresToPlant, 400);
+}
+
+// Купившего землю не спрашивают о продаже
+TEST(InputHandlerTest, AwaitSkipsSellAfterBuy)
+{
+	CityState state;
+	state.AcrePrice = 20;
+
+	std::ostringstream out;
+	InputHandler handler(out);
+	InputChannel input;
+	PlayerDecisions decisions{};
+	DecisionTask task = handler.AwaitPlayerDecisions(DecisionBounds(state, DefaultRules{}), input, decisions);
+
+	for (const char* line : { "10", "abc", "1000", "0" })
+	{
+		ASSERT_FALSE(task.IsDone());
+		input.Push(line);
+	}
+
+	EXPECT_TRUE(task.IsDone());
+	EXPECT_EQ(decisions.BuyLand, 10);
+	EXPECT_EQ(decisions.SellLand, 0);
+	EXPECT_EQ(decisions.WheatForFood, 1000);
+	EXPECT_EQ(decisions.AcresToPlant, 0);
+}
@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include "../src/utils/SplitMix64.h"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Последовательность задана только алгоритмом: одна и та же в любой стандартной библиотеке
+TEST(SplitMix64Test, NextBelowIsFixedSequence)
+{
+	SplitMix64 random(42);
+	std::vector<uint64_t> draws;
+	for (int i = 0; i < 6; i++)
+		draws.push_back(random.NextBelow(100));
+
+	SplitMix64 again(42);
+	for (uint64_t draw : draws)
+	{
+		EXPECT_LT(draw, 100u);
+		EXPECT_EQ(draw, again.NextBelow(100));
+	}
+}
+
+TEST(SplitMix64Test, NextInRangeCoversBounds)
+{
+	SplitMix64 random(7);
+	bool seenMin = false;
+	bool seenMax = false;
+	for (int i = 0; i < 10000; i++)
+	{
+		uint64_t value = random.NextInRange(17, 23);
+		ASSERT_GE(value, 17u);
+		ASSERT_LE(value, 23u);
+		seenMin = seenMin || value == 17;
+		seenMax = seenMax || value == 23;
+	}
+	EXPECT_TRUE(seenMin);
+	EXPECT_TRUE(seenMax);
+
+	EXPECT_EQ(random.NextInRange(5, 5), 5u);
+	random.NextInRange(0, std::numeric_limits<uint64_t>::max());
+}
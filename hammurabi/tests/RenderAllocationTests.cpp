@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include "AllocationCounter.h"
+#include "../src/services/DisplayManager.h"
+#include "../src/services/ReportTemplate.h"
+#include <string>
+
+namespace
+{
+	// Город середины партии: в отчете есть все строки, включая чуму
+	CityState MakeReportCity()
+	{
+		CityState state;
+		state.Round = 5;
+		state.Population = 120;
+		state.Area = 1100;
+		state.WheatReserves = 3200;
+		state.AcrePrice = 21;
+		state.DeadFromHunger = 3;
+		state.NewPeople = 7;
+		state.HasPlague = true;
+		return state;
+	}
+}
+
+// После первого кадра отчет раунда собирается в уже выделенных буферах
+TEST(RenderAllocationTest, RoundReportSteadyStateDoesNotAllocate)
+{
+	DisplayManager display;
+	CityState city = MakeReportCity();
+	display.ComposeRoundStart(city);
+	display.InvalidateFrame();
+	display.ComposeRoundStart(city);
+
+	AllocationCounter allocations;
+	for (uint32_t i = 0; i < 100; i++)
+	{
+		// Попеременно кадр целиком и разница с прошлым, с меняющимися числами
+		if (i % 2 == 0)
+			display.InvalidateFrame();
+		city.Population = 100 + i;
+		city.WheatReserves = 3000 + i * 17;
+		city.HasPlague = i % 3 == 0;
+		EXPECT_FALSE(display.ComposeRoundStart(city).empty());
+	}
+	EXPECT_EQ(allocations.GetCount(), 0u);
+}
+
+TEST(RenderAllocationTest, ReportTemplateAppendDoesNotAllocate)
+{
+	ReportTemplate report("В этом году умерло {DeadFromHunger} человек, прибыло {NewPeople}, население {Population}");
+	CityState city = MakeReportCity();
+	std::string output;
+	output.reserve(256);
+
+	AllocationCounter allocations;
+	for (uint32_t i = 0; i < 100; i++)
+	{
+		output.clear();
+		city.Population = 1000000 + i;
+		report.AppendTo(city, output);
+	}
+	EXPECT_EQ(allocations.GetCount(), 0u);
+}
+
+// Счетчик видит выделения, иначе проверки выше ничего бы не доказывали
+TEST(RenderAllocationTest, CounterSeesAllocations)
+{
+	AllocationCounter allocations;
+	std::string text(1000, 'x');
+	EXPECT_GE(allocations.GetCount(), 1u);
+	EXPECT_EQ(text.size(), 1000u);
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "../src/services/SaveCatalog.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	// Отдельная папка на тест: сохранения и файл каталога рядом
+	class SaveCatalogTest : public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			m_Root = std::filesystem::temp_directory_path() / ("hammurabi_catalog_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+			std::filesystem::remove_all(m_Root);
+			std::filesystem::create_directories(m_Root / "Saves");
+		}
+
+		void TearDown() override
+		{
+			std::filesystem::remove_all(m_Root);
+		}
+
+		SaveCatalog MakeCatalog() const
+		{
+			return SaveCatalog(m_Root / "Saves", m_Root / "SavesCatalog.txt");
+		}
+
+		size_t CountCatalogLines() const
+		{
+			std::ifstream file(m_Root / "SavesCatalog.txt");
+			size_t lines = 0;
+			std::string line;
+			while (std::getline(file, line))
+				lines++;
+			return lines;
+		}
+
+		std::filesystem::path m_Root;
+	};
+
+	CityState MakeCity(uint32_t round, Quantity population)
+	{
+		CityState state;
+		state.Round = round;
+		state.Population = population;
+		return state;
+	}
+}
+
+// Тест 1: Имя с пробелами читается из файла каталога, а не пересобирается по папке.
+// Файла сохранения нет, поэтому после пересборки записи бы не осталось.
+TEST_F(SaveCatalogTest, NameWithSpacesSurvivesReload)
+{
+	{
+		SaveCatalog catalog = MakeCatalog();
+		catalog.Update("my first save", MakeCity(3, 120));
+		catalog.Update("second", MakeCity(5, 90));
+	}
+
+	SaveCatalog reloaded = MakeCatalog();
+	SaveCatalogEntry entry;
+	ASSERT_TRUE(reloaded.Find("my first save", entry));
+	EXPECT_EQ(entry.Round, 3u);
+	EXPECT_EQ(entry.Population, (Quantity)120);
+	ASSERT_TRUE(reloaded.Find("second", entry));
+	EXPECT_EQ(entry.Round, 5u);
+	EXPECT_EQ(reloaded.Size(), 2u);
+}
+
+// Тест 2: Повторные сохранения под одним именем не раздувают файл
+TEST_F(SaveCatalogTest, RepeatedUpdatesAreCompacted)
+{
+	SaveCatalog catalog = MakeCatalog();
+	for (uint32_t round = 1; round <= 1000; round++)
+	{
+		catalog.Update("autosave", MakeCity(round, 100));
+	}
+
+	EXPECT_LT(CountCatalogLines(), 100u);
+
+	SaveCatalog reloaded = MakeCatalog();
+	SaveCatalogEntry entry;
+	ASSERT_TRUE(reloaded.Find("autosave", entry));
+	EXPECT_EQ(entry.Round, 1000u);
+	EXPECT_EQ(reloaded.Size(), 1u);
+}
+
+// Тест 3: Обновления из нескольких потоков через один объект не теряются
+TEST_F(SaveCatalogTest, ConcurrentUpdatesKeepAllNames)
+{
+	SaveCatalog catalog = MakeCatalog();
+	std::vector<std::thread> threads;
+	for (uint32_t thread = 0; thread < 4; thread++)
+	{
+		threads.emplace_back([&catalog, thread]
+		{
+			for (uint32_t i = 0; i < 50; i++)
+			{
+				catalog.Update("save " + std::to_string(thread) + "-" + std::to_string(i % 10), MakeCity(i, thread));
+			}
+		});
+	}
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+	EXPECT_EQ(catalog.Size(), 40u);
+
+	SaveCatalog reloaded = MakeCatalog();
+	EXPECT_EQ(reloaded.Size(), 40u);
+}
+
+// Тест 4: Сохранение находится и по имени без расширения, точное имя важнее
+TEST_F(SaveCatalogTest, FindAcceptsNameWithoutExtension)
+{
+	SaveCatalog catalog = MakeCatalog();
+	catalog.Update("empire.txt", MakeCity(4, 150));
+	catalog.Update("empire", MakeCity(7, 80));
+
+	SaveCatalogEntry entry;
+	ASSERT_TRUE(catalog.Find("empire", entry));
+	EXPECT_EQ(entry.Round, 7u);
+	ASSERT_TRUE(catalog.Find("empire.txt", entry));
+	EXPECT_EQ(entry.Round, 4u);
+
+	catalog.Update("kingdom.sav", MakeCity(2, 60));
+	ASSERT_TRUE(catalog.Find("kingdom", entry));
+	EXPECT_EQ(entry.Name, "kingdom.sav");
+	EXPECT_FALSE(catalog.Find("kingdom.txt", entry));
+}
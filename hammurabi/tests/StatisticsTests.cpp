@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include "../src/domain/Statistics.h"
+#include <sstream>
+
+namespace
+{
+	EconomyFixed Share(double value)
+	{
+		return EconomyFixed::FromDouble(value);
+	}
+}
+
+// Перезапись крайнего раунда сужает минимум и максимум
+TEST(GameStatisticsTest, RewriteRecomputesBounds)
+{
+	GameStatistics stats;
+	stats.SetRoundStatistics(1, Share(0.1));
+	stats.SetRoundStatistics(2, Share(0.5));
+	stats.SetRoundStatistics(3, Share(0.2));
+
+	stats.SetRoundStatistics(2, Share(0.05));
+	EXPECT_EQ(stats.GetMaxDeadFromHunger(), Share(0.2));
+	EXPECT_EQ(stats.GetMinDeadFromHunger(), Share(0.05));
+
+	stats.SetRoundStatistics(2, Share(0.15));
+	EXPECT_EQ(stats.GetMinDeadFromHunger(), Share(0.1));
+}
+
+// Раунды, ушедшие из буфера, по-прежнему участвуют в границах
+TEST(GameStatisticsTest, RewriteKeepsEvictedBounds)
+{
+	const uint32_t last = (uint32_t)GameStatistics::HISTORY_ROUNDS + 6;
+	GameStatistics stats;
+	stats.SetRoundStatistics(1, Share(0.9));
+	for (uint32_t round = 2; round <= last; round++)
+		stats.SetRoundStatistics(round, round == last - 1 ? Share(0.01) : Share(0.1));
+
+	stats.SetRoundStatistics(last - 1, Share(0.3));
+	EXPECT_EQ(stats.GetMinDeadFromHunger(), Share(0.1));
+	EXPECT_EQ(stats.GetMaxDeadFromHunger(), Share(0.9));
+
+	// Сохранение переносит и крайние вытесненные доли
+	std::stringstream stream;
+	stats.WriteAggregates(stream);
+	GameStatistics loaded;
+	ASSERT_TRUE(loaded.ReadAggregates(stream));
+	// Старое значение - минимум: границы пересчитываются, вытесненный максимум остается
+	loaded.SetRoundStatistics(last, Share(0.2));
+	EXPECT_EQ(loaded.GetMaxDeadFromHunger(), Share(0.9));
+	EXPECT_EQ(loaded.GetMinDeadFromHunger(), Share(0.1));
+}